@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+
+#include "expconfig/ExpConfig.h"
+#include "expconfig/setups/SetupRegistry.h"
+
+#include "tree/TID.h"
+#include "base/std_ext/time.h"
+
+#include <string>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+
+namespace {
+
+// noon of the first day of the benchmark setup's beamtime
+TID make_tid(State& state) {
+    const auto timerange = expconfig::SetupRegistry::GetTimeRange(SetupName);
+    if(timerange.empty()) {
+        state.SkipWithError("Setup "+SetupName+" has no registered time range");
+        return TID();
+    }
+    return TID(static_cast<uint32_t>(std_ext::to_time_t(timerange.StartDate, true) + 12*3600));
+}
+
+// auto-detection as done by the unpacker on startup of Ant,
+// every iteration starts without any created setup
+void ExpConfig_SetByTID(State& state) {
+    const auto tid = make_tid(state);
+    if(!state.Error().empty())
+        return;
+    while(state.KeepRunning()) {
+        state.PauseTiming();
+        ExpConfig::Setup::Cleanup();
+        state.ResumeTiming();
+        ExpConfig::Setup::SetByTID(tid);
+    }
+    state.SetLabel(ExpConfig::Setup::Get().GetName());
+    ExpConfig::Setup::Cleanup();
+}
+
+// creating all registered setups, which auto-detection needed
+// before the setups were registered with their time range
+void ExpConfig_CreateAllSetups(State& state) {
+    const auto names = ExpConfig::Setup::GetNames();
+    while(state.KeepRunning()) {
+        state.PauseTiming();
+        ExpConfig::Setup::Cleanup();
+        state.ResumeTiming();
+        for(const auto& name : names)
+            DoNotOptimize(expconfig::SetupRegistry::GetSetup(name));
+    }
+    state.SetItemsProcessed(state.Iterations()*names.size());
+    state.SetLabel(to_string(names.size())+" setups");
+    ExpConfig::Setup::Cleanup();
+}
+
+} // anonymous namespace
+
+ANT_BENCHMARK(ExpConfig_SetByTID);
+ANT_BENCHMARK(ExpConfig_CreateAllSetups);
@@ -0,0 +1,70 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+
+#include "unpacker/RawFileReader.h"
+
+#include "base/tmpfile_t.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+
+namespace {
+
+// synthesized once for all benchmarks in this file
+struct rawfiles_t {
+    tmpfolder_t folder;
+    const string plain = folder.foldername+"/raw.dat";
+    const string xz = plain+".xz";
+    const string xz_blocks = plain+".blocks.xz";
+    const string gz = plain+".gz";
+    long long size = 0;
+
+    rawfiles_t() {
+        SynthesizeMk2(plain, MacroEvents, 100);
+        system(("xz -c "+plain+" > "+xz).c_str());
+        system(("xz -c --block-size=1MiB "+plain+" > "+xz_blocks).c_str());
+        system(("gzip -c "+plain+" > "+gz).c_str());
+        RawFileReader r;
+        r.open(plain);
+        size = r.GetUncompressedSize();
+    }
+};
+
+const rawfiles_t& rawfiles() {
+    static const rawfiles_t files;
+    return files;
+}
+
+void read(State& state, const string& filename) {
+    const auto size = rawfiles().size;
+    vector<uint32_t> buffer(0x8000);
+    while(state.KeepRunning()) {
+        RawFileReader r;
+        r.open(filename);
+        while(true) {
+            r.read(buffer.data(), buffer.size());
+            if(r.gcount() == 0)
+                break;
+        }
+        DoNotOptimize(buffer.front());
+    }
+    state.SetBytesProcessed(state.Iterations()*size);
+}
+
+void RawFileReader_Plain(State& state)     { read(state, rawfiles().plain); }
+void RawFileReader_XZ(State& state)        { read(state, rawfiles().xz); }
+void RawFileReader_XZ_Blocks(State& state) { read(state, rawfiles().xz_blocks); }
+void RawFileReader_GZ(State& state)        { read(state, rawfiles().gz); }
+
+} // anonymous namespace
+
+ANT_BENCHMARK(RawFileReader_Plain);
+ANT_BENCHMARK(RawFileReader_XZ);
+ANT_BENCHMARK(RawFileReader_XZ_Blocks);
+ANT_BENCHMARK(RawFileReader_GZ);
@@ -0,0 +1,173 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+#include "bench_config.h"
+
+#include "reconstruct/Reconstruct.h"
+#include "reconstruct/UpdateableManager.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <cstdlib>
+#include <cxxabi.h>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+
+namespace {
+
+template<typename T>
+string demangled_type(const T& object) {
+    unique_ptr<char, void(*)(void*)> name(
+                abi::__cxa_demangle(typeid(object).name(), nullptr, nullptr, nullptr), free);
+    return name ? name.get() : typeid(object).name();
+}
+
+// exposes the single steps of the reconstruction
+struct Reconstruct_bench : Reconstruct {
+
+    using Reconstruct::sorted_clusterhits_t;
+    using Reconstruct::sorted_clusters_t;
+
+    Reconstruct_bench() : Reconstruct() {}
+
+    size_t ReadHitsHooks() const {
+        return hooks_readhits.size();
+    }
+
+    string ReadHitsHookName(size_t i) const {
+        return demangled_type(**next(hooks_readhits.begin(), i));
+    }
+
+    string ClusteringName() const {
+        return demangled_type(*clustering);
+    }
+
+    void ApplyReadHitsHook(size_t i, TEventData& reconstructed) const {
+        updateablemanager->UpdateParameters(reconstructed.ID);
+        sorted_readhits.clear();
+        for(TDetectorReadHit& readhit : reconstructed.DetectorReadHits)
+            sorted_readhits.add_item(readhit.DetectorType, readhit);
+        (*next(hooks_readhits.begin(), i))->ApplyTo(sorted_readhits);
+    }
+
+    // everything before clustering
+    void PrepareClusterHits(TEventData& reconstructed, sorted_clusterhits_t& sorted_clusterhits) const {
+        updateablemanager->UpdateParameters(reconstructed.ID);
+        ApplyHooksToReadHits(reconstructed.DetectorReadHits);
+        BuildHits(sorted_clusterhits, reconstructed.TaggerHits);
+        for(const auto& hook : hooks_clusterhits)
+            hook->ApplyTo(sorted_clusterhits);
+    }
+
+    void Clustering(const sorted_clusterhits_t& sorted_clusterhits, sorted_clusters_t& sorted_clusters) const {
+        BuildClusters(sorted_clusterhits, sorted_clusters);
+    }
+
+    void BuildCandidates(sorted_clusters_t& sorted_clusters, TEventData& reconstructed) const {
+        candidatebuilder->Build(move(sorted_clusters), reconstructed.Candidates, reconstructed.Clusters);
+    }
+};
+
+const Reconstruct_bench& reconstructor() {
+    EnsureSetup();
+    static const Reconstruct_bench r;
+    return r;
+}
+
+// real data with some hundred events
+const StoredEvents& events() {
+    static const StoredEvents events(string(BENCH_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz", false);
+    return events;
+}
+
+// fresh copies of the unpacked events, the reconstruction modifies them
+vector<TEvent> restore(State& state) {
+    state.PauseTiming();
+    vector<TEvent> restored;
+    restored.reserve(events().Size());
+    for(size_t i=0;i<events().Size();i++)
+        restored.emplace_back(events().Get(i));
+    state.ResumeTiming();
+    return restored;
+}
+
+vector<Reconstruct_bench::sorted_clusterhits_t> clusterhits() {
+    vector<Reconstruct_bench::sorted_clusterhits_t> clusterhits(events().Size());
+    for(size_t i=0;i<events().Size();i++) {
+        auto event = events().Get(i);
+        reconstructor().PrepareClusterHits(event.Reconstructed(), clusterhits[i]);
+    }
+    return clusterhits;
+}
+
+void Reconstruct_Full(State& state) {
+    const auto& r = reconstructor();
+    while(state.KeepRunning()) {
+        for(auto& event : restore(state))
+            r.DoReconstruct(event.Reconstructed());
+    }
+    state.SetItemsProcessed(state.Iterations()*events().Size());
+}
+
+void Reconstruct_ReadHitsHook(State& state) {
+    const auto& r = reconstructor();
+    const auto i = size_t(state.Range());
+    state.SetLabel(r.ReadHitsHookName(i));
+    while(state.KeepRunning()) {
+        for(auto& event : restore(state))
+            r.ApplyReadHitsHook(i, event.Reconstructed());
+    }
+    state.SetItemsProcessed(state.Iterations()*events().Size());
+}
+
+void Clustering_NextGen(State& state) {
+    const auto& r = reconstructor();
+    const auto input = clusterhits();
+    while(state.KeepRunning()) {
+        for(const auto& sorted_clusterhits : input) {
+            Reconstruct_bench::sorted_clusters_t sorted_clusters;
+            r.Clustering(sorted_clusterhits, sorted_clusters);
+            DoNotOptimize(sorted_clusters);
+        }
+    }
+    state.SetLabel(r.ClusteringName());
+    state.SetItemsProcessed(state.Iterations()*input.size());
+}
+
+void CandidateBuilder(State& state) {
+    const auto& r = reconstructor();
+    const auto input = clusterhits();
+    vector<Reconstruct_bench::sorted_clusters_t> sorted_clusters(input.size());
+    while(state.KeepRunning()) {
+        // the candidate builder modifies the clusters, so build them freshly
+        state.PauseTiming();
+        for(size_t i=0;i<input.size();i++) {
+            sorted_clusters[i].clear();
+            r.Clustering(input[i], sorted_clusters[i]);
+        }
+        state.ResumeTiming();
+
+        for(auto& clusters : sorted_clusters) {
+            TEventData reconstructed;
+            r.BuildCandidates(clusters, reconstructed);
+            DoNotOptimize(reconstructed);
+        }
+    }
+    state.SetItemsProcessed(state.Iterations()*input.size());
+}
+
+} // anonymous namespace
+
+ANT_BENCHMARK(Reconstruct_Full);
+ANT_BENCHMARK(Reconstruct_ReadHitsHook)->ArgRange([] () {
+    return (long long)reconstructor().ReadHitsHooks();
+});
+ANT_BENCHMARK(Clustering_NextGen);
+ANT_BENCHMARK(CandidateBuilder);
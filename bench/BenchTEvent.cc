@@ -0,0 +1,46 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+#include "bench_config.h"
+
+#include "tree/TEvent.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+
+namespace {
+
+// serialize and deserialize via the TEvent streamer, as done for TTrees
+void roundtrip(State& state, const StoredEvents& events) {
+    vector<TEvent> restored;
+    restored.reserve(events.Size());
+    for(size_t i=0;i<events.Size();i++)
+        restored.emplace_back(events.Get(i));
+
+    while(state.KeepRunning()) {
+        for(auto& event : restored) {
+            const auto buffer = StoredEvents::Serialize(event);
+            event = StoredEvents::Deserialize(buffer);
+        }
+    }
+    state.SetItemsProcessed(state.Iterations()*events.Size());
+    state.SetBytesProcessed(state.Iterations()*events.Bytes());
+}
+
+void TEvent_Roundtrip_Unpacked(State& state) {
+    static const StoredEvents events(string(BENCH_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz", false);
+    roundtrip(state, events);
+}
+
+void TEvent_Roundtrip_Reconstructed(State& state) {
+    static const StoredEvents events(string(BENCH_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz", true);
+    roundtrip(state, events);
+}
+
+} // anonymous namespace
+
+ANT_BENCHMARK(TEvent_Roundtrip_Unpacked);
+ANT_BENCHMARK(TEvent_Roundtrip_Reconstructed);
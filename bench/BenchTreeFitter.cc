@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+#include "bench_config.h"
+
+#include "base/WrapTFile.h"
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "analysis/input/pluto/PlutoReader.h"
+#include "analysis/utils/fitter/TreeFitter.h"
+#include "analysis/utils/uncertainties/Constant.h"
+#include "analysis/utils/MCFakeReconstructed.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+using namespace ant::analysis;
+
+namespace {
+
+struct fitinput_t {
+    double Ebeam;
+    TParticlePtr Proton;
+    TParticleList Photons;
+};
+
+// complete 4pi events without smearing, as in the TreeFitter test
+vector<fitinput_t> read(const string& plutofile) {
+    EnsureSetup();
+    auto rootfile = make_shared<WrapTFileInput>(string(BENCH_BLOBS_DIRECTORY)+"/"+plutofile);
+    input::PlutoReader reader(rootfile);
+    utils::MCFakeReconstructed mc_fake(true);
+
+    vector<fitinput_t> inputs;
+    while(true) {
+        input::event_t event;
+        if(!reader.ReadNextEvent(event))
+            break;
+        auto particles = mc_fake.Get(event.MCTrue());
+        auto protons = particles.Get(ParticleTypeDatabase::Proton);
+        if(protons.size() != 1)
+            continue;
+        inputs.push_back({event.MCTrue().ParticleTree->Get()->Ek(),
+                          protons.front(),
+                          particles.Get(ParticleTypeDatabase::Photon)});
+    }
+    return inputs;
+}
+
+void fit(State& state, ParticleTypeTreeDatabase::Channel channel, const vector<fitinput_t>& inputs) {
+    utils::TreeFitter treefitter(ParticleTypeTreeDatabase::Get(channel),
+                                 utils::UncertaintyModels::Constant::make(), true);
+    treefitter.SetZVertexSigma(3.0);
+
+    long long nFits = 0;
+    while(state.KeepRunning()) {
+        for(const auto& input : inputs) {
+            treefitter.PrepareFits(input.Ebeam, input.Proton, input.Photons);
+            APLCON::Result_t res;
+            while(treefitter.NextFit(res)) {
+                DoNotOptimize(res.Probability);
+                nFits++;
+            }
+        }
+    }
+    state.SetItemsProcessed(nFits);
+    state.SetLabel("fits");
+}
+
+void TreeFitter_Etap2g(State& state) {
+    static const auto inputs = read("Pluto_Etap2g.root");
+    fit(state, ParticleTypeTreeDatabase::Channel::EtaPrime_2g, inputs);
+}
+
+void TreeFitter_EtapOmegaG(State& state) {
+    static const auto inputs = read("Pluto_EtapOmegaG.root");
+    fit(state, ParticleTypeTreeDatabase::Channel::EtaPrime_gOmega_ggPi0_4g, inputs);
+}
+
+} // anonymous namespace
+
+ANT_BENCHMARK(TreeFitter_Etap2g);
+ANT_BENCHMARK(TreeFitter_EtapOmegaG);
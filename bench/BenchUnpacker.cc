@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+#include "bench_config.h"
+
+#include "unpacker/Unpacker.h"
+#include "unpacker/UnpackerAcqu.h"
+
+#include "tree/TEvent.h"
+
+#include "base/tmpfile_t.h"
+#include "base/std_ext/string.h"
+#include "base/std_ext/misc.h"
+
+#include <string>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+
+namespace {
+
+long long unpack(const string& filename) {
+    auto unpacker = Unpacker::Get(filename);
+    long long nEvents = 0;
+    while(auto event = unpacker->NextEvent()) {
+        DoNotOptimize(event);
+        nEvents++;
+    }
+    return nEvents;
+}
+
+void label_allocations(State& state, unsigned long long allocations, long long nEvents) {
+    if(nEvents>0)
+        state.SetLabel(std_ext::formatter() << double(allocations)/nEvents << " allocations/event");
+}
+
+void Unpacker_Acqu(State& state) {
+    EnsureSetup();
+    const string filename = string(BENCH_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz";
+    long long nEvents = 0;
+    const auto allocations = Allocations();
+    while(state.KeepRunning())
+        nEvents += unpack(filename);
+    label_allocations(state, Allocations() - allocations, nEvents);
+    state.SetItemsProcessed(nEvents);
+}
+
+// macro benchmark on synthesized files, argument is the hit multiplicity
+void Unpacker_Mk2(State& state) {
+    tmpfolder_t folder;
+    const string filename = folder.foldername+"/synthesized.dat";
+    SynthesizeMk2(filename, MacroEvents, unsigned(state.Range()));
+
+    long long nEvents = 0;
+    const auto allocations = Allocations();
+    while(state.KeepRunning())
+        nEvents += unpack(filename);
+    label_allocations(state, Allocations() - allocations, nEvents);
+    state.SetItemsProcessed(nEvents);
+}
+
+// same with the data buffers unpacked in parallel, argument is the number of threads
+void Unpacker_Mk2Parallel(State& state) {
+    tmpfolder_t folder;
+    const string filename = folder.foldername+"/synthesized.dat";
+    SynthesizeMk2(filename, MacroEvents, 50);
+
+    UnpackerAcqu::Parallel::Threads = unsigned(state.Range());
+    std_ext::execute_on_destroy reset([] () {
+        UnpackerAcqu::Parallel::Threads = 0;
+    });
+
+    long long nEvents = 0;
+    while(state.KeepRunning())
+        nEvents += unpack(filename);
+    state.SetItemsProcessed(nEvents);
+}
+
+} // anonymous namespace
+
+ANT_BENCHMARK(Unpacker_Acqu);
+ANT_BENCHMARK(Unpacker_Mk2)->Arg(10)->Arg(50)->Arg(200)->MinTime(2);
+ANT_BENCHMARK(Unpacker_Mk2Parallel)->Arg(1)->Arg(2)->Arg(4)->MinTime(2);
@@ -0,0 +1,241 @@
+#include "Benchmark.h"
+
+#include "base/std_ext/memory.h"
+#include "base/std_ext/string.h"
+
+#include "cereal/archives/json.hpp"
+#include "cereal/types/vector.hpp"
+#include "cereal/types/string.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace ant;
+using namespace ant::bench;
+
+double Runner::MinTime = 0.5;
+
+State::State(long long maxIterations_, vector<long long> args_) :
+    maxIterations(maxIterations_),
+    args(move(args_))
+{}
+
+void State::PauseTiming()
+{
+    if(!timing)
+        return;
+    real_seconds += chrono::duration<double>(clock_t::now() - start_real).count();
+    cpu_seconds += double(std::clock() - start_cpu)/CLOCKS_PER_SEC;
+    timing = false;
+}
+
+void State::ResumeTiming()
+{
+    if(timing)
+        return;
+    start_real = clock_t::now();
+    start_cpu = std::clock();
+    timing = true;
+}
+
+Benchmark::Benchmark(const string& name, function_t function) :
+    Name(name),
+    Function(move(function))
+{}
+
+Benchmark* Benchmark::Arg(long long arg)
+{
+    ArgsList.emplace_back(vector<long long>{arg});
+    return this;
+}
+
+Benchmark* Benchmark::Args(const vector<long long>& args)
+{
+    ArgsList.emplace_back(args);
+    return this;
+}
+
+Benchmark* Benchmark::ArgRange(function<long long()> n)
+{
+    ArgRangeSize = move(n);
+    return this;
+}
+
+Benchmark* Benchmark::MinTime(double seconds)
+{
+    MinSeconds = seconds;
+    return this;
+}
+
+namespace {
+
+vector<unique_ptr<Benchmark>>& registry() {
+    static vector<unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+struct result_t {
+    string Name;
+    std::int64_t Iterations;
+    double RealTime; // per iteration in ns
+    double CPUTime;  // per iteration in ns
+    double ItemsPerSecond;
+    double BytesPerSecond;
+    string Label;
+    string Error;
+
+    template<class Archive>
+    void save(Archive& archive) const {
+        archive(cereal::make_nvp("name", Name),
+                cereal::make_nvp("iterations", Iterations),
+                cereal::make_nvp("real_time", RealTime),
+                cereal::make_nvp("cpu_time", CPUTime),
+                cereal::make_nvp("time_unit", string("ns")),
+                cereal::make_nvp("items_per_second", ItemsPerSecond),
+                cereal::make_nvp("bytes_per_second", BytesPerSecond),
+                cereal::make_nvp("label", Label),
+                cereal::make_nvp("error_message", Error));
+    }
+};
+
+struct context_t {
+    template<class Archive>
+    void save(Archive& archive) const {
+        char hostname[256] = {};
+        gethostname(hostname, sizeof(hostname)-1);
+        const auto now = std::time(nullptr);
+        char date[64] = {};
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(addressof(now)));
+#ifdef NDEBUG
+        const string build_type("release");
+#else
+        const string build_type("debug");
+#endif
+        archive(cereal::make_nvp("date", string(date)),
+                cereal::make_nvp("host_name", string(hostname)),
+                cereal::make_nvp("num_cpus", std::thread::hardware_concurrency()),
+                cereal::make_nvp("build_type", build_type),
+                cereal::make_nvp("min_time", Runner::MinTime));
+    }
+};
+
+result_t runBenchmark(const Benchmark& benchmark, const string& name, const vector<long long>& args) {
+    const double minTime = benchmark.MinSeconds > 0 ? benchmark.MinSeconds : Runner::MinTime;
+
+    // increase the iterations until the timed loop takes long enough
+    long long n = 1;
+    while(true) {
+        State state(n, args);
+        try {
+            benchmark.Function(state);
+        }
+        catch(const exception& e) {
+            state.SkipWithError(e.what());
+        }
+        state.PauseTiming();
+
+        if(!state.Error().empty())
+            return {name, 0, 0, 0, 0, 0, state.Label(), state.Error()};
+
+        constexpr long long maxIterations = 1000000000;
+        if(state.RealSeconds() >= minTime || n >= maxIterations) {
+            const auto iterations = state.Iterations();
+            const auto per_iteration = [iterations] (double seconds) {
+                return iterations > 0 ? 1e9*seconds/iterations : 0.0;
+            };
+            const auto per_second = [&state] (long long count) {
+                return state.RealSeconds() > 0 ? count/state.RealSeconds() : 0.0;
+            };
+            return {name, iterations,
+                        per_iteration(state.RealSeconds()), per_iteration(state.CPUSeconds()),
+                        per_second(state.ItemsProcessed()), per_second(state.BytesProcessed()),
+                        state.Label(), ""};
+        }
+
+        const double multiplier = state.RealSeconds() > 0 ? 1.4*minTime/state.RealSeconds() : 10.0;
+        n = std::min(maxIterations, static_cast<long long>(n*std::max(2.0, std::min(multiplier, 10.0))));
+    }
+}
+
+void print(ostream& s, const result_t& r) {
+    s << left << setw(50) << r.Name << right;
+    if(!r.Error.empty()) {
+        s << " ERROR: " << r.Error << endl;
+        return;
+    }
+    s << setw(12) << r.Iterations
+      << setw(15) << fixed << setprecision(0) << r.RealTime << " ns"
+      << setw(15) << fixed << setprecision(0) << r.CPUTime << " ns";
+    if(r.ItemsPerSecond > 0)
+        s << setw(12) << setprecision(3) << r.ItemsPerSecond/1e3 << " k items/s";
+    if(r.BytesPerSecond > 0)
+        s << setw(12) << setprecision(3) << r.BytesPerSecond/(1<<20) << " MB/s";
+    if(!r.Label.empty())
+        s << " " << r.Label;
+    s << endl;
+}
+
+} // anonymous namespace
+
+Benchmark* ant::bench::Register(const string& name, Benchmark::function_t function)
+{
+    registry().emplace_back(std_ext::make_unique<Benchmark>(name, move(function)));
+    return registry().back().get();
+}
+
+int Runner::Run(const string& filter, const string& jsonfile)
+{
+    const regex re(filter);
+
+    vector<result_t> results;
+    for(const auto& benchmark : registry()) {
+        auto argsList = benchmark->ArgsList;
+        if(benchmark->ArgRangeSize) {
+            long long n = 0;
+            try {
+                n = benchmark->ArgRangeSize();
+            }
+            catch(const exception& e) {
+                results.push_back({benchmark->Name, 0, 0, 0, 0, 0, "", e.what()});
+                print(cout, results.back());
+                continue;
+            }
+            for(long long i=0;i<n;i++)
+                argsList.emplace_back(vector<long long>{i});
+        }
+        if(argsList.empty())
+            argsList.emplace_back();
+
+        for(const auto& args : argsList) {
+            std_ext::formatter name;
+            name << benchmark->Name;
+            for(auto arg : args)
+                name << "/" << arg;
+            if(!filter.empty() && !regex_search(string(name), re))
+                continue;
+
+            results.emplace_back(runBenchmark(*benchmark, name, args));
+            print(cout, results.back());
+        }
+    }
+
+    if(!jsonfile.empty()) {
+        ofstream f(jsonfile);
+        cereal::JSONOutputArchive archive(f);
+        archive(cereal::make_nvp("context", context_t()),
+                cereal::make_nvp("benchmarks", results));
+    }
+
+    return int(count_if(results.begin(), results.end(), [] (const result_t& r) {
+        return !r.Error.empty();
+    }));
+}
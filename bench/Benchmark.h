@@ -0,0 +1,166 @@
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ant {
+namespace bench {
+
+/**
+ * @brief The State class controls the timed loop of one benchmark run
+ *
+ * Similar to Google Benchmark, the benchmark function runs its timed code in
+ * `while(state.KeepRunning()) { ... }`, the number of iterations is chosen by the runner.
+ * Setup code before the loop is not timed.
+ */
+class State {
+public:
+    explicit State(long long maxIterations, std::vector<long long> args = {});
+
+    bool KeepRunning() {
+        if(!running) {
+            running = true;
+            ResumeTiming();
+        }
+        if(iterations < maxIterations) {
+            ++iterations;
+            return true;
+        }
+        PauseTiming();
+        return false;
+    }
+
+    /**
+     * @brief PauseTiming excludes the following code from the measurement, for example preparing input data
+     */
+    void PauseTiming();
+    void ResumeTiming();
+
+    long long Iterations() const { return iterations; }
+
+    /**
+     * @brief Range returns the argument given by Benchmark::Arg
+     * @param i index if several arguments were given
+     */
+    long long Range(std::size_t i = 0) const { return args.at(i); }
+
+    void SetItemsProcessed(long long items) { itemsProcessed = items; }
+    void SetBytesProcessed(long long bytes) { bytesProcessed = bytes; }
+    void SetLabel(const std::string& label_) { label = label_; }
+
+    /**
+     * @brief SkipWithError marks the benchmark as failed, the function should return afterwards
+     */
+    void SkipWithError(const std::string& msg) { error = msg; maxIterations = 0; }
+
+    double RealSeconds() const { return real_seconds; }
+    double CPUSeconds() const { return cpu_seconds; }
+    long long ItemsProcessed() const { return itemsProcessed; }
+    long long BytesProcessed() const { return bytesProcessed; }
+    const std::string& Label() const { return label; }
+    const std::string& Error() const { return error; }
+
+protected:
+
+    long long maxIterations;
+    long long iterations = 0;
+    std::vector<long long> args;
+    bool running = false;
+
+    using clock_t = std::chrono::steady_clock;
+    clock_t::time_point start_real;
+    std::clock_t start_cpu = 0;
+    bool timing = false;
+    double real_seconds = 0;
+    double cpu_seconds = 0;
+
+    long long itemsProcessed = 0;
+    long long bytesProcessed = 0;
+    std::string label;
+    std::string error;
+};
+
+/**
+ * @brief The Benchmark class is one registered benchmark function, see ANT_BENCHMARK
+ */
+class Benchmark {
+public:
+    using function_t = std::function<void(State&)>;
+
+    Benchmark(const std::string& name, function_t function);
+
+    /**
+     * @brief Arg adds one run with the given argument, accessible via State::Range
+     */
+    Benchmark* Arg(long long arg);
+
+    /**
+     * @brief Args adds one run with several arguments
+     */
+    Benchmark* Args(const std::vector<long long>& args);
+
+    /**
+     * @brief ArgRange adds runs with arguments 0..n-1, where n is determined just before running,
+     * for example the number of hooks of the current setup
+     */
+    Benchmark* ArgRange(std::function<long long()> n);
+
+    /**
+     * @brief MinTime overrides the minimal time of the timed loop, for example for slow macro benchmarks
+     */
+    Benchmark* MinTime(double seconds);
+
+    const std::string Name;
+    const function_t Function;
+    std::vector<std::vector<long long>> ArgsList;
+    std::function<long long()> ArgRangeSize;
+    double MinSeconds = 0;
+};
+
+/**
+ * @brief Register a benchmark, prefer the ANT_BENCHMARK macro
+ */
+Benchmark* Register(const std::string& name, Benchmark::function_t function);
+
+/**
+ * @brief Runner runs all registered benchmarks and reports the results
+ */
+class Runner {
+public:
+    /**
+     * @brief Run all benchmarks with matching names
+     * @param filter regular expression, runs all benchmarks if empty
+     * @param jsonfile write results to this file, skipped if empty
+     * @return number of failed benchmarks
+     */
+    static int Run(const std::string& filter, const std::string& jsonfile);
+
+    /**
+     * @brief MinTime in seconds each benchmark runs at least
+     */
+    static double MinTime;
+};
+
+/**
+ * @brief DoNotOptimize prevents the compiler from removing the computation of value
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}} // namespace ant::bench
+
+#define ANT_BENCHMARK_CONCAT2(a, b) a##b
+#define ANT_BENCHMARK_CONCAT(a, b) ANT_BENCHMARK_CONCAT2(a, b)
+
+/**
+ * @brief ANT_BENCHMARK registers a function void(ant::bench::State&),
+ * use for example ANT_BENCHMARK(func)->Arg(10)->Arg(100) for parametrized runs
+ */
+#define ANT_BENCHMARK(func) \
+    static ::ant::bench::Benchmark* ANT_BENCHMARK_CONCAT(bench_registered_, __LINE__) \
+    __attribute__((unused)) = ::ant::bench::Register(#func, func)
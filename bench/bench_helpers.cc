@@ -0,0 +1,108 @@
+#include "bench_helpers.h"
+#include "bench_config.h"
+
+#include "unpacker/UnpackerAcqu.h"
+#include "unpacker/detail/UnpackerAcqu_writer.h"
+
+#include "unpacker/Unpacker.h"
+#include "reconstruct/Reconstruct.h"
+
+#include "expconfig/ExpConfig.h"
+#include "expconfig/setups/Setup.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "TBufferFile.h"
+
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+
+string bench::SetupName = "Setup_2014_07_EPT_Prod";
+unsigned bench::MacroEvents = 20000;
+
+void bench::EnsureSetup()
+{
+    ExpConfig::Setup::SetByName(SetupName);
+}
+
+void bench::SynthesizeMk2(const string& filename, unsigned nEvents, unsigned multiplicity)
+{
+    EnsureSetup();
+
+    // raw channels which map one-to-one to a logical channel
+    vector<uint16_t> rawchannels;
+    {
+        vector<UnpackerAcquConfig::hit_mapping_t> hit_mappings;
+        vector<UnpackerAcquConfig::scaler_mapping_t> scaler_mappings;
+        auto& setup = ExpConfig::Setup::GetByType<UnpackerAcquConfig>();
+        setup.BuildMappings(hit_mappings, scaler_mappings);
+        for(const auto& m : hit_mappings) {
+            if(m.RawChannels.size() != 1)
+                continue;
+            auto& rawchannel = m.RawChannels.front();
+            if(rawchannel.NoMask() != rawchannel.Mask)
+                continue;
+            rawchannels.push_back(rawchannel.RawChannel);
+        }
+    }
+
+    unpacker::acqu::Mk2Writer writer(filename);
+    writer.WriteHeader(string(BENCH_BLOBS_DIRECTORY)+"/Acqu_oneevent-big.dat.xz");
+
+    std::mt19937 rng(4711);
+    std::uniform_int_distribution<size_t> channel(0, rawchannels.size()-1);
+    std::uniform_int_distribution<uint16_t> value(0, 0xfff);
+
+    vector<uint32_t> hits;
+    for(unsigned i=0;i<nEvents;i++) {
+        hits.clear();
+        for(unsigned j=0;j<multiplicity;j++)
+            hits.push_back(unpacker::acqu::Mk2Writer::MakeHit(rawchannels[channel(rng)], value(rng)));
+        writer.AddEvent(hits);
+    }
+}
+
+bench::StoredEvents::StoredEvents(const string& filename, bool reconstruct)
+{
+    EnsureSetup();
+    auto unpacker = Unpacker::Get(filename);
+    auto reconstructor = reconstruct ? std_ext::make_unique<Reconstruct>() : nullptr;
+    while(auto event = unpacker->NextEvent()) {
+        if(reconstructor)
+            reconstructor->DoReconstruct(event.Reconstructed());
+        buffers.emplace_back(Serialize(event));
+    }
+}
+
+size_t bench::StoredEvents::Bytes() const
+{
+    size_t bytes = 0;
+    for(const auto& b : buffers)
+        bytes += b.size();
+    return bytes;
+}
+
+TEvent bench::StoredEvents::Get(size_t i) const
+{
+    return Deserialize(buffers.at(i));
+}
+
+vector<char> bench::StoredEvents::Serialize(TEvent& event)
+{
+    // same path as writing TEvent into a TTree
+    TBufferFile buffer(TBuffer::kWrite);
+    event.Streamer(buffer);
+    return vector<char>(buffer.Buffer(), buffer.Buffer()+buffer.Length());
+}
+
+TEvent bench::StoredEvents::Deserialize(const vector<char>& buffer)
+{
+    TBufferFile tbuffer(TBuffer::kRead, int(buffer.size()), const_cast<char*>(buffer.data()), false);
+    TEvent event;
+    event.Streamer(tbuffer);
+    return event;
+}
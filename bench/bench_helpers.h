@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ant {
+
+struct TEvent;
+
+namespace bench {
+
+/**
+ * @brief SetupName used by all benchmarks, see EnsureSetup
+ */
+extern std::string SetupName;
+
+/**
+ * @brief MacroEvents number of events synthesized for macro benchmarks
+ */
+extern unsigned MacroEvents;
+
+void EnsureSetup();
+
+/**
+ * @brief Allocations returns the number of heap allocations so far,
+ * counted by the global operator new of the benchmark executables
+ */
+unsigned long long Allocations();
+
+/**
+ * @brief SynthesizeMk2 writes an Acqu Mk2 raw file in the style of Ant-fakeRaw
+ *
+ * The hits are distributed randomly over the raw channels of the current setup,
+ * the values are uniformly distributed 12bit values. The generator is seeded fixed,
+ * so the same file is created for the same parameters.
+ * @param filename output file, uncompressed
+ * @param nEvents number of events
+ * @param multiplicity number of hits per event
+ */
+void SynthesizeMk2(const std::string& filename, unsigned nEvents, unsigned multiplicity);
+
+/**
+ * @brief The StoredEvents class keeps events serialized, so that benchmarks
+ * can restore fresh copies of them repeatedly
+ */
+class StoredEvents {
+public:
+    /**
+     * @brief Unpack the events of a raw file, optionally reconstructed
+     * @param filename
+     * @param reconstruct
+     */
+    StoredEvents(const std::string& filename, bool reconstruct);
+
+    std::size_t Size() const { return buffers.size(); }
+    std::size_t Bytes() const;
+
+    TEvent Get(std::size_t i) const;
+
+    static std::vector<char> Serialize(TEvent& event);
+    static TEvent Deserialize(const std::vector<char>& buffer);
+
+protected:
+    std::vector<std::vector<char>> buffers;
+};
+
+}} // namespace ant::bench
@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+#include "bench_helpers.h"
+
+#include "base/Logger.h"
+#include "tclap/CmdLine.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace ant;
+
+namespace {
+std::atomic<unsigned long long> nAllocations(0);
+}
+
+void* operator new(size_t size)
+{
+    nAllocations.fetch_add(1, memory_order_relaxed);
+    if(auto ptr = malloc(size))
+        return ptr;
+    throw bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+unsigned long long bench::Allocations()
+{
+    return nAllocations.load(memory_order_relaxed);
+}
+
+int main(int argc, char* argv[])
+{
+    TCLAP::CmdLine cmd("Ant benchmark", ' ', "0.1");
+    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9), logging is disabled if not set", false, 0,"level");
+    auto cmd_filter  = cmd.add<TCLAP::ValueArg<string>>("f","filter","Run only benchmarks matching this regex",false,"","regex");
+    auto cmd_json    = cmd.add<TCLAP::ValueArg<string>>("j","json","Write results as JSON to this file",false,"","filename");
+    auto cmd_mintime = cmd.add<TCLAP::ValueArg<double>>("t","min-time","Minimal time in seconds per benchmark",false,bench::Runner::MinTime,"seconds");
+    auto cmd_setup   = cmd.add<TCLAP::ValueArg<string>>("s","setup","Setup used for unpacking and reconstruction",false,bench::SetupName,"name");
+    auto cmd_events  = cmd.add<TCLAP::ValueArg<unsigned>>("e","events","Number of synthesized events in macro benchmarks",false,bench::MacroEvents,"n");
+    cmd.parse(argc, argv);
+
+    SetupLogger();
+    if(cmd_verbose->isSet()) {
+        el::Loggers::setVerboseLevel(cmd_verbose->getValue());
+    }
+    else {
+        // the benchmarks should not be dominated by logging
+        el::Configurations loggerConf;
+        loggerConf.setToDefault();
+        loggerConf.setGlobally(el::ConfigurationType::Enabled, "false");
+        el::Loggers::reconfigureAllLoggers(loggerConf);
+    }
+
+    bench::Runner::MinTime = cmd_mintime->getValue();
+    bench::SetupName = cmd_setup->getValue();
+    bench::MacroEvents = cmd_events->getValue();
+
+    const auto failed = bench::Runner::Run(cmd_filter->getValue(), cmd_json->getValue());
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+/**
+  * @file Ant-acqu-index.cc
+  * @brief Create the .antidx index files for Acqu raw files,
+  * which allow fast sharding and seeking
+  */
+
+#include "unpacker/Unpacker.h"
+#include "unpacker/RawFileReader.h"
+#include "unpacker/detail/UnpackerAcqu_index.h"
+
+#include "expconfig/ExpConfig.h"
+#include "expconfig/setups/SetupRegistry.h"
+
+#include "tree/TEvent.h"
+
+#include "base/Logger.h"
+#include "base/std_ext/system.h"
+#include "tclap/CmdLine.h"
+#include "tclap/ValuesConstraintExtra.h"
+
+#include <cstdio>
+#include <csignal>
+
+using namespace std;
+using namespace ant;
+using unpacker::acqu::Index;
+
+volatile bool interrupt = false;
+
+int main(int argc, char** argv) {
+    SetupLogger();
+
+    signal(SIGINT, [] (int) {
+        cout << ">>> Interrupted" << endl;
+        interrupt = true;
+    });
+
+    TCLAP::CmdLine cmd("Ant-acqu-index", ' ', "0.1");
+
+    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
+    auto cmd_input  = cmd.add<TCLAP::MultiArg<string>>("i","input","Acqu raw files",true,"filename");
+
+    TCLAP::ValuesConstraintExtra<decltype(ExpConfig::Setup::GetNames())> allowedsetupnames(ExpConfig::Setup::GetNames());
+    auto cmd_setup  = cmd.add<TCLAP::ValueArg<string>>("s","setup","Choose setup manually by name",false,"", &allowedsetupnames);
+
+    auto cmd_force = cmd.add<TCLAP::SwitchArg>("f","force","Recreate index even if a valid one exists",false);
+
+    cmd.parse(argc, argv);
+    if(cmd_verbose->isSet()) {
+        el::Loggers::setVerboseLevel(cmd_verbose->getValue());
+    }
+
+    if(std_ext::system::isInteractive())
+        ProgressCounter::Interval = 3;
+
+    if(cmd_setup->isSet())
+        ExpConfig::Setup::SetByName(cmd_setup->getValue());
+
+    Index::CreateOnFirstPass = true;
+
+    int exitcode = EXIT_SUCCESS;
+    for(const auto& inputfile : cmd_input->getValue()) {
+        if(interrupt)
+            break;
+
+        if(!cmd_force->isSet() && Index().Load(inputfile)) {
+            LOG(INFO) << "Found valid index for " << inputfile << ", skipping";
+            continue;
+        }
+        remove(Index::GetFilename(inputfile).c_str());
+
+        // the index is created while unpacking the file completely
+        try {
+            auto unpacker = Unpacker::Get(inputfile);
+            while(auto event = unpacker->NextEvent()) {
+                if(interrupt)
+                    break;
+            }
+        }
+        catch(const std::exception& e) {
+            LOG(ERROR) << "Cannot unpack " << inputfile << ": " << e.what();
+            exitcode = EXIT_FAILURE;
+            continue;
+        }
+
+        if(interrupt)
+            break;
+
+        Index index;
+        if(!index.Load(inputfile)) {
+            LOG(ERROR) << "No index created for " << inputfile;
+            exitcode = EXIT_FAILURE;
+            continue;
+        }
+
+        LOG(INFO) << inputfile << ": " << index.Buffers.size() << " data buffers";
+        if(index.SeekPoints.size() == 1)
+            LOG(WARNING) << inputfile << " is compressed as one single block, seeking must decompress from the start. "
+                         << "Consider recompressing with 'xz -T0' or 'xz --block-size'";
+    }
+
+    return interrupt ? EXIT_FAILURE : exitcode;
+}
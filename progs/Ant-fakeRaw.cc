@@ -1,8 +1,7 @@
 #include "expconfig/ExpConfig.h"
 #include "analysis/input/ant/AntReader.h"
 #include "unpacker/UnpackerAcqu.h"
-#include "unpacker/detail/UnpackerAcqu_legacy.h"
-#include "unpacker/RawFileReader.h"
+#include "unpacker/detail/UnpackerAcqu_writer.h"
 
 #include "expconfig/setups/Setup.h"
 
@@ -17,7 +16,6 @@
 
 #include <memory>
 #include <signal.h>
-#include <fstream>
 
 using namespace std;
 using namespace ant;
@@ -100,31 +98,20 @@ int main(int argc, char** argv) {
 
 
 
-    const auto& outputfilename = cmd_output->getValue();
-    ofstream outputfile(outputfilename);
+    acqu::Mk2Writer writer(cmd_output->getValue());
 
     // copy the header from given file
-    {
-        std::vector<uint32_t> buffer;
-        RawFileReader r;
-        r.open(headerfile);
-        if(!r) {
-            LOG(ERROR) << "Cannot open headerfile for reading";
-            return EXIT_FAILURE;
-        }
-        // header is usually contained within the first 32k bytes
-        r.expand_buffer(buffer, 0x8000/sizeof(uint32_t));
-        buffer.resize(10*0x8000/sizeof(uint32_t));
-        outputfile.write(reinterpret_cast<const char*>(buffer.data()),
-                         buffer.size()*sizeof(uint32_t));
+    try {
+        writer.WriteHeader(headerfile);
+    }
+    catch(const acqu::Mk2Writer::Exception& e) {
+        LOG(ERROR) << e.what();
+        return EXIT_FAILURE;
     }
 
     analysis::input::AntReader reader(inputrootfile, nullptr, nullptr);
 
-    unsigned nEvents = 0;
     analysis::input::event_t event;
-    // ensure first databuffer has Mk2 data marker
-    std::vector<uint32_t> databuffer{acqu::EMk2DataBuff};
     while(reader.ReadNextEvent(event)) {
         if(interrupt)
             break;
@@ -155,53 +142,17 @@ int main(int argc, char** argv) {
                 auto nHits = readhit.RawData.size()/sizeof(uint16_t);
                 for(unsigned i=0;i<nHits;i++) {
                     auto ptr = reinterpret_cast<const uint16_t*>(readhit.RawData.data())+i;
-                    eventbuffer.emplace_back();
-                    auto acquhit = reinterpret_cast<acqu::AcquBlock_t*>(addressof(eventbuffer.back()));
-                    acquhit->id = rawchannel.RawChannel;
-                    acquhit->adc = *ptr;
+                    eventbuffer.emplace_back(acqu::Mk2Writer::MakeHit(rawchannel.RawChannel, *ptr));
                 }
             }
-
-            // finish with end-event marker
-            eventbuffer.push_back(acqu::EEndEvent);
         }
 
-        // each eventbuffer is filled into the buffer with its eventID, eventlength (in bytes)
-        // and some possible end-of-databuffer marker, in total 3 extra words maximum
-        if(databuffer.size()+eventbuffer.size()+3 > 10*0x8000/sizeof(uint32_t)) {
-            databuffer.emplace_back(acqu::EBufferEnd);
-            databuffer.resize(10*0x8000/sizeof(uint32_t));
-            outputfile.write(reinterpret_cast<const char*>(databuffer.data()),
-                             databuffer.size()*sizeof(uint32_t));
-            databuffer.clear();
-            databuffer.emplace_back(acqu::EMk2DataBuff);
-        }
-
-        // fill event into buffer
-        databuffer.emplace_back(nEvents);
-        databuffer.emplace_back(eventbuffer.size()*sizeof(uint32_t));
-        databuffer.insert(databuffer.end(), eventbuffer.begin(), eventbuffer.end());
-
-        nEvents++;
+        writer.AddEvent(eventbuffer);
     }
 
-    // dump last databuffer
-    databuffer.emplace_back(acqu::EBufferEnd);
-    databuffer.resize(10*0x8000/sizeof(uint32_t));
-    outputfile.write(reinterpret_cast<const char*>(databuffer.data()),
-                     databuffer.size()*sizeof(uint32_t));
-
-    // write EEndBuffer
-    databuffer.clear();
-    databuffer.emplace_back(acqu::EEndBuff);
-    databuffer.emplace_back(acqu::EBufferEnd);
-    databuffer.resize(10*0x8000/sizeof(uint32_t));
-    outputfile.write(reinterpret_cast<const char*>(databuffer.data()),
-                     databuffer.size()*sizeof(uint32_t));
-
-    LOG(INFO) << nEvents << " events processed";
+    writer.Close();
 
-    outputfile.close();
+    LOG(INFO) << writer.GetEvents() << " events processed";
 
     return EXIT_SUCCESS;
 }
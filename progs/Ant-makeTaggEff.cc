@@ -22,6 +22,11 @@
 #include "TRint.h"
 #include "TMultiGraph.h"
 #include "TGraphErrors.h"
+#include "TROOT.h"
+#include "RVersion.h"
+#include "Math/MinimizerOptions.h"
+
+#include <thread>
 
 
 using namespace ant;
@@ -99,6 +104,8 @@ static double chi2cut_channels;
 static volatile bool interrupt = false;
 static bool noStore = false;
 static bool histOut = false;
+// threads used to read the files and fit the channels of a triple
+static unsigned nThreads = 1;
 
 auto failExit = [] (const string& message)
 {
@@ -137,6 +144,7 @@ int main( int argc, char** argv )
     // other settings:
     auto cmd_output    = cmd.add<TCLAP::ValueArg<string>>("o", "output", "Output file", false, "", "filename");
     auto cmd_chi2      = cmd.add<TCLAP::ValueArg<double>>("c", "chi2", "chi2 value used as cut condition to skip channels while fitting the background", false, 15.0, "chi2 cut value");
+    auto cmd_threads   = cmd.add<TCLAP::ValueArg<unsigned>>("t", "threads", "Number of threads reading the files and fitting the channels, default all cores, more than one fits with Minuit2", false, std::thread::hardware_concurrency(), "n");
 
     // switches
     auto cmd_batchmode = cmd.add<TCLAP::SwitchArg>("b", "batch",   "Run in batch mode (no ROOT shell afterwards)");
@@ -153,6 +161,19 @@ int main( int argc, char** argv )
     histOut = cmd_output->isSet();
     chi2cut_channels = cmd_chi2->getValue();
 
+    nThreads = std::max(1u, cmd_threads->getValue());
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    // only Minuit2 can fit different channels concurrently. With one thread,
+    // the default minimizer is kept, so the results stay as before
+    if(nThreads>1) {
+        ROOT::EnableThreadSafety();
+        ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+    }
+#else
+    LOG_IF(nThreads>1, WARNING) << "Multiple threads require ROOT6, using one thread";
+    nThreads = 1;
+#endif
+
     unique_ptr<WrapTFileOutput> masterFile;
     if (histOut) {
         masterFile = std_ext::make_unique<WrapTFileOutput>(cmd_output->getValue(), true);
@@ -254,7 +275,7 @@ int main( int argc, char** argv )
 
 taggEffTriple_t* processFiles(const vector<string>& files, shared_ptr<channelHist_t> chHist, const HistogramFactory& histfac)
 {
-    auto taggEff = new taggEffTriple_t(files.at(0),files.at(1),files.at(2),histfac);
+    auto taggEff = new taggEffTriple_t(files.at(0),files.at(1),files.at(2),histfac,nThreads);
     taggEff_t result = taggEff->GetTaggEffSubtracted();
 
     chHist->Fill(result.TaggEffs,result.TaggEffErrors);
@@ -303,7 +324,7 @@ void processCSV(const string& csvFile, shared_ptr<channelHistTime_t> chHistTime,
         if (record.size() != 3)
             throw runtime_error("Found line with wrong number of files, check your file list.");
 
-        taggEffTriple_t taggEff(record.at(0),record.at(1),record.at(2),histfac);
+        taggEffTriple_t taggEff(record.at(0),record.at(1),record.at(2),histfac,nThreads);
         taggEff_t result = taggEff.GetTaggEffSubtracted();
         histLambda->Fill(taggEff.GetDecayConstant());
         GraphExt::FillGraph(graphLambda,result.FirstID.Timestamp,taggEff.GetDecayConstant());
@@ -368,7 +389,7 @@ taggEff_t mediateCSV(const vector<string>& csvFiles, const HistogramFactory& his
             if (record.size() != 3)
                 throw runtime_error("Found line with wrong number of files, check your file list.");
 
-            const auto result = taggEffTriple_t(record.at(0),record.at(1),record.at(2),histfac).GetTaggEffSubtracted();
+            const auto result = taggEffTriple_t(record.at(0),record.at(1),record.at(2),histfac,nThreads).GetTaggEffSubtracted();
 
             if (n_TaggEffs == 0)
             {
@@ -5,6 +5,7 @@
 #include "base/Logger.h"
 #include "tclap/CmdLine.h"
 #include "base/WrapTFile.h"
+#include "base/std_ext/math.h"
 #include "TROOT.h"
 #include "TRint.h"
 #include "TTree.h"
@@ -12,10 +13,12 @@
 #include "PParticle.h"
 
 #include "detail/Corrections.h"
+#include "detail/Prefilter.h"
 
 using namespace std;
 using namespace ant;
 using namespace ant::progs::corrections;
+using namespace ant::progs::prefilter;
 
 
 int main(int argc, char** argv) {
@@ -26,6 +29,8 @@ int main(int argc, char** argv) {
     auto cmd_input   = cmd.add<TCLAP::ValueArg<string>>("i","input", "Input Pluto file", true, "", "pluto.root");
     auto cmd_output  = cmd.add<TCLAP::ValueArg<string>>("o","output", "Output root file", true, "", "output.root");
     auto cmd_nEvents = cmd.add<TCLAP::ValueArg<int>>("m","maxEvents", "Max. number of events to be read", false, 0, "#events");
+    auto cmd_threads = cmd.add<TCLAP::ValueArg<unsigned>>("t","threads", "Number of worker threads, default all cores", false, std::thread::hardware_concurrency(), "n");
+    auto cmd_seed    = cmd.add<TCLAP::ValueArg<unsigned>>("","seed", "Random seed, reproduces the output independent of threads, 0 picks a random one", false, 0, "seed");
     cmd.parse(argc, argv);
 
     if(cmd_verbose->isSet())
@@ -98,12 +103,6 @@ int main(int argc, char** argv) {
     const double weight_max = 1. + corr.get_max_correction()/100.;
     VLOG(1) << "max correction = " << corr.get_max_correction() << "; max weight = " << weight_max;
 
-    input_tree->SetBranchAddress("Particles", &buffer);
-
-    WrapTFileOutput output(cmd_output->getValue());
-    TTree* output_tree = output.CreateInside<TTree>("data", "");
-    output_tree->Branch("Particles", buffer);
-
     const auto find_particle = [] (const TClonesArray& c, const int pid) {
         for (int i=0; i < c.GetEntries(); ++i) {
             PParticle* p = static_cast<PParticle*>(c.At(i));
@@ -113,34 +112,31 @@ int main(int argc, char** argv) {
         return static_cast<PParticle*>(nullptr);
     };
 
-    TRandom3 rng(0);
-    long long accepted = 0;
-    long long read = 0;
+    // called concurrently, Corrections is only accessed via const methods
+    const auto get_weight = [&corr, weight_max, meson_id, lm_id, lp_id, find_particle] (const TClonesArray& particles) {
+        const auto meson = find_particle(particles, meson_id);
+        const auto lm = find_particle(particles, lm_id);
+        const auto lp = find_particle(particles, lp_id);
 
-    for (long long i = 0; i < input_tree->GetEntries(); ++i) {
-        if (maxEvents && i >= maxEvents)
-            break;
+        if (!meson || !lm || !lp)
+            return std_ext::NaN;
 
-        input_tree->GetEntry(i);
-        ++read;
+        double weight = 1. + corr.interpolate(lm, lp, meson)/100.;
+        // weight normalized to weight_max, hence it's always between 0 and 1
+        return weight/weight_max;
+    };
 
-        const auto meson = find_particle(*buffer, meson_id);
-        const auto lm = find_particle(*buffer, lm_id);
-        const auto lp = find_particle(*buffer, lp_id);
+    Prefilter prefilter(cmd_input->getValue(), get_weight);
+    prefilter.Threads = cmd_threads->getValue();
+    prefilter.Seed = cmd_seed->getValue();
+    prefilter.MaxEntries = maxEvents;
 
-        if (meson && lm && lp) {
-            double weight = 1. + corr.interpolate(lm, lp, meson)/100.;
-            // weight normalized to weight_max, hence it's always between 0 and 1
-            double w = weight/weight_max;
+    WrapTFileOutput output(cmd_output->getValue());
+    const auto result = prefilter.Run(output, cmd_output->getValue());
+    const auto accepted = result.Accepted;
+    const auto read = result.Read;
 
-            // rejection
-            if (rng.Uniform(0.,1.) <= w) {
-                output_tree->Fill();
-                ++accepted;
-            }
-        } else
-            LOG(ERROR) << "Not all needed particles found in event " << i;
-    }
+    LOG_IF(result.Invalid > 0, ERROR) << "Not all needed particles found in " << result.Invalid << " events";
 
     double percent_accepted = double(accepted) / read * 100.;
     LOG(INFO) << "in: " << read << ", out: " << accepted << "; "
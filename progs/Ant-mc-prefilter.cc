@@ -4,6 +4,7 @@
 #include "base/Logger.h"
 #include "tclap/CmdLine.h"
 #include "base/std_ext/string.h"
+#include "base/std_ext/math.h"
 #include "base/OptionsList.h"
 #include "base/WrapTFile.h"
 #include "TROOT.h"
@@ -15,10 +16,12 @@
 #include "PParticle.h"
 #include "analysis/utils/MCWeighting.h"
 #include "analysis/plot/HistogramFactory.h"
+#include "detail/Prefilter.h"
 
 using namespace std;
 using namespace ant;
 using namespace ant::calibration::gui;
+using namespace ant::progs::prefilter;
 
 int main(int argc, char** argv) {
     SetupLogger();
@@ -28,24 +31,13 @@ int main(int argc, char** argv) {
     auto cmd_input    = cmd.add<TCLAP::ValueArg<string>>("i","input",  "Input pluto file", true, "", "pluto.root");
     auto cmd_output   = cmd.add<TCLAP::ValueArg<string>>("o","output",  "Output root file",true, "","");
     auto cmd_meson    = cmd.add<TCLAP::ValueArg<string>>("m","meson",  "Meson ", true, "", "omega");
+    auto cmd_threads  = cmd.add<TCLAP::ValueArg<unsigned>>("t","threads", "Number of worker threads, default all cores", false, std::thread::hardware_concurrency(), "n");
+    auto cmd_seed     = cmd.add<TCLAP::ValueArg<unsigned>>("","seed", "Random seed, reproduces the output independent of threads, 0 picks a random one", false, 0, "seed");
     cmd.parse(argc, argv);
 
     if(cmd_verbose->isSet())
         el::Loggers::setVerboseLevel(cmd_verbose->getValue());
 
-    WrapTFileInput infile(cmd_input->getValue());
-
-    TTree* intree = nullptr;
-    if (!infile.GetObject("data",intree))
-        LOG(FATAL) << "\"data\" not found, make sure the provided file is a Pluto file";
-    TClonesArray* buffer = nullptr;
-
-    intree->SetBranchAddress("Particles", &buffer);
-
-    WrapTFileOutput outfile(cmd_output->getValue());
-    TTree* outtree = outfile.CreateInside<TTree>("data", "");
-    outtree->Branch("Particles", buffer);
-
     const analysis::utils::MCWeighting::item_t* mcitem = nullptr;
     double norm = 1.0;
     int pluto_pid=0;
@@ -81,29 +73,27 @@ int main(int argc, char** argv) {
         return (PParticle*)nullptr;
     };
 
-    TRandom3 rng(0);
-    Long64_t accepted = 0;
-
-    for(Long64_t i=0; i<intree->GetEntries(); ++i) {
-        intree->GetEntry(i);
+    // called concurrently, only const access to mcw allowed
+    const auto weight = [&mcw, norm, pluto_pid, findOneParticle] (const TClonesArray& particles) {
+        const auto p = findOneParticle(particles, pluto_pid);
+        const auto bp = findOneParticle(particles, 14001);
+        if(!p || !bp)
+            return std_ext::NaN;
+        const auto E = bp->E()*1000.0 - ParticleTypeDatabase::Proton.Mass(); //MeV
+        LorentzVec boosted = *p;
+        boosted.Boost(-bp->BoostVector());
+        const auto cost = cos(boosted.Theta());
+        return mcw.GetN(E, cost) / norm;
+    };
 
-        const auto p = findOneParticle(*buffer, pluto_pid);
-        const auto bp = findOneParticle(*buffer, 14001);
-        if(p && bp) {
-            const auto E = bp->E()*1000.0 - ParticleTypeDatabase::Proton.Mass(); //MeV
-            LorentzVec boosted = *p;
-            boosted.Boost(-bp->BoostVector());
-            const auto cost = cos(boosted.Theta());
-            const auto rw = mcw.GetN(E, cost) / norm;
-            if(rw > 1.0 || rng.Uniform(0.0,1.0) <= rw) {
-                outtree->Fill();
-                ++accepted;
-            }
-        }
+    Prefilter prefilter(cmd_input->getValue(), weight);
+    prefilter.Threads = cmd_threads->getValue();
+    prefilter.Seed = cmd_seed->getValue();
 
-    }
+    WrapTFileOutput outfile(cmd_output->getValue());
+    const auto result = prefilter.Run(outfile, cmd_output->getValue());
 
-    LOG(INFO) << "In:" << intree->GetEntries() << ", out: " << accepted << " = " << accepted / double(intree->GetEntries()) * 100.0 << " %";
+    LOG(INFO) << "In:" << result.Read << ", out: " << result.Accepted << " = " << result.Accepted / double(result.Read) * 100.0 << " %";
 
     return EXIT_SUCCESS;
 }
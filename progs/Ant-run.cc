@@ -0,0 +1,250 @@
+/**
+  * @file Ant-run.cc
+  * @brief Run Ant or Ant-plot on a list of input files on the local machine and merge the outputs.
+  *
+  *        Replaces extra/AntMapReduce and extra/AntSubmit on single nodes, no batch system required.
+  *        Each input file is processed by its own job, the jobs are pulled from a shared queue
+  *        by as many slots as cores and memory permit, largest files first. Finished outputs are
+  *        merged incrementally with Ant-hadd while other files are still processed, and the merge
+  *        jobs are scheduled in the same slots. Failed jobs are retried, files which still fail are
+  *        listed in <output>.failed, which can be passed as --filelist again.
+  */
+
+#include "base/Logger.h"
+#include "tclap/CmdLine.h"
+#include "base/std_ext/string.h"
+#include "base/std_ext/system.h"
+
+#include "detail/RunPlanner.h"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace ant;
+using namespace ant::progs::run;
+
+volatile bool interrupt = false;
+
+long long filesize(const string& filename) {
+    struct stat st;
+    return stat(filename.c_str(), addressof(st)) == 0 ? st.st_size : 0;
+}
+
+// available memory in MB, 0 if unknown
+unsigned long long available_memory() {
+    ifstream meminfo("/proc/meminfo");
+    string key;
+    unsigned long long value;
+    string unit;
+    while(meminfo >> key >> value >> unit) {
+        if(key == "MemAvailable:")
+            return value/1024;
+    }
+    return 0;
+}
+
+// runs cmd with sh, stdout and stderr go to logfile
+pid_t launch(const string& cmd, const string& logfile) {
+    const auto pid = fork();
+    if(pid != 0)
+        return pid;
+
+    // in the child now
+    const auto fd = open(logfile.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if(fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+    execl("/bin/sh", "sh", "-c", cmd.c_str(), static_cast<char*>(nullptr));
+    _exit(127);
+}
+
+int main(int argc, char** argv) {
+    SetupLogger();
+
+    signal(SIGINT, [] (int) {
+        interrupt = true;
+    });
+
+    TCLAP::CmdLine cmd("Ant-run - Process many files on the local machine and merge the outputs", ' ', "0.1");
+    auto cmd_verbose = cmd.add<TCLAP::ValueArg<int>>("v","verbose","Verbosity level (0..9)", false, 0,"int");
+    auto cmd_cmd = cmd.add<TCLAP::ValueArg<string>>("","cmd","Command template run per input file, {input} and {output} are replaced, e.g. 'Ant-plot -i {input} -o {output} -p Plotter'. Only merge inputs if empty.",false,"","template");
+    auto cmd_output = cmd.add<TCLAP::ValueArg<string>>("o","output","Merged output file",true,"","filename");
+    auto cmd_filelist = cmd.add<TCLAP::ValueArg<string>>("","filelist","Read input files from file, one per line",false,"","filename");
+    auto cmd_jobs = cmd.add<TCLAP::ValueArg<unsigned>>("j","jobs","Maximum number of jobs running in parallel",false,thread::hardware_concurrency(),"n");
+    auto cmd_memperjob = cmd.add<TCLAP::ValueArg<unsigned>>("","mem_per_job","Expected memory per job in MB, limits the number of parallel jobs, 0 to ignore",false,1024,"MB");
+    auto cmd_retries = cmd.add<TCLAP::ValueArg<unsigned>>("","retries","Retry failed jobs this many times",false,2,"n");
+    auto cmd_mergefanin = cmd.add<TCLAP::ValueArg<unsigned>>("","merge","Number of files merged by one merge job",false,10,"n");
+    auto cmd_hadd = cmd.add<TCLAP::ValueArg<string>>("","cmd_hadd","Command to merge files, called with output and inputs",false,"Ant-hadd","cmd");
+    auto cmd_workdir = cmd.add<TCLAP::ValueArg<string>>("","workdir","Folder for intermediate files and logs, default <output>.Ant-run",false,"","folder");
+    auto cmd_keeptmpfiles = cmd.add<TCLAP::SwitchArg>("","keeptmpfiles","Keep intermediate files and logs",false);
+    auto cmd_inputfiles = cmd.add<TCLAP::UnlabeledMultiArg<string>>("inputfiles","Input files",false,"inputfiles");
+
+    cmd.parse(argc, argv);
+    if(cmd_verbose->isSet()) {
+        el::Loggers::setVerboseLevel(cmd_verbose->getValue());
+    }
+
+    vector<string> inputfiles = cmd_inputfiles->getValue();
+    if(cmd_filelist->isSet()) {
+        ifstream filelist(cmd_filelist->getValue());
+        if(!filelist) {
+            LOG(ERROR) << "Cannot open filelist " << cmd_filelist->getValue();
+            return EXIT_FAILURE;
+        }
+        string line;
+        while(getline(filelist, line)) {
+            line = std_ext::string_sanitize(line);
+            if(!line.empty())
+                inputfiles.emplace_back(line);
+        }
+    }
+
+    for(auto& inputfile : inputfiles) {
+        string errmsg;
+        if(!std_ext::system::testopen(inputfile, errmsg)) {
+            LOG(ERROR) << "Cannot open input file " << inputfile << ": " << errmsg;
+            return EXIT_FAILURE;
+        }
+        inputfile = std_ext::system::absolutePath(inputfile);
+    }
+
+    if(inputfiles.empty()) {
+        LOG(ERROR) << "No input files provided";
+        return EXIT_FAILURE;
+    }
+
+    const string mapcmd = cmd_cmd->getValue();
+    if(!mapcmd.empty() && (!std_ext::contains(mapcmd, "{input}") || !std_ext::contains(mapcmd, "{output}"))) {
+        LOG(ERROR) << "Command template must contain {input} and {output}";
+        return EXIT_FAILURE;
+    }
+
+    const string outputfile = cmd_output->getValue();
+    const string workdir = cmd_workdir->isSet() ? cmd_workdir->getValue() : outputfile + ".Ant-run";
+    if(std_ext::system::testopen(outputfile)) {
+        LOG(ERROR) << "Output file " << outputfile << " already exists";
+        return EXIT_FAILURE;
+    }
+    // a user-supplied workdir may contain other files, only remove it if we created it
+    const bool createdWorkdir = !std_ext::system::path_exists(workdir);
+    std_ext::system::exec(std_ext::formatter() << "mkdir -p " << quote(workdir));
+
+    // determine number of slots from cores and memory
+    unsigned slots = max(1u, cmd_jobs->getValue());
+    if(cmd_memperjob->getValue() > 0) {
+        const auto memory = available_memory();
+        if(memory > 0)
+            slots = unsigned(min<unsigned long long>(slots, max(1ull, memory / cmd_memperjob->getValue())));
+    }
+
+    // fill the queue with the largest files first,
+    // then the small ones fill up the gaps at the end
+    sort(inputfiles.begin(), inputfiles.end(), [] (const string& a, const string& b) {
+        return filesize(a) > filesize(b);
+    });
+
+    Planner planner(inputfiles, mapcmd, cmd_hadd->getValue(), workdir,
+                    cmd_mergefanin->getValue(), cmd_retries->getValue());
+
+    LOG(INFO) << "Processing " << inputfiles.size() << " files with " << slots << " parallel jobs, logs in " << workdir;
+
+    map<pid_t, job_t> running;
+
+    while(!interrupt && !planner.Done()) {
+
+        while(running.size() < slots && planner.HasNext()) {
+            auto job = planner.Next();
+            VLOG(5) << "Running " << job.Cmd;
+            const auto pid = launch(job.Cmd, planner.LogFile(job));
+            if(pid < 0) {
+                LOG(ERROR) << "Cannot start job " << job.Name;
+                interrupt = true;
+                break;
+            }
+            running.emplace(pid, move(job));
+        }
+
+        int status = 0;
+        const auto pid = waitpid(-1, addressof(status), 0);
+        if(pid < 0)
+            continue; // interrupted or no children
+        auto it_running = running.find(pid);
+        if(it_running == running.end())
+            continue;
+        auto job = move(it_running->second);
+        running.erase(it_running);
+
+        const bool success = WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS
+                             && std_ext::system::testopen(job.Output);
+
+        for(const auto& merged : planner.Finished(move(job), success, !interrupt)) {
+            if(!cmd_keeptmpfiles->isSet())
+                remove(merged.c_str());
+        }
+    }
+
+    // wait for the remaining jobs, they got the interrupt as well
+    while(!running.empty()) {
+        const auto pid = wait(nullptr);
+        if(pid < 0)
+            break;
+        running.erase(pid);
+    }
+
+    const auto& failed = planner.Failed();
+    if(!failed.empty()) {
+        const auto failedlist = outputfile + ".failed";
+        ofstream f(failedlist);
+        for(const auto& inputfile : failed)
+            f << inputfile << '\n';
+        LOG(WARNING) << failed.size() << " files failed, listed in " << failedlist;
+    }
+
+    if(interrupt || planner.MergeFailed()) {
+        LOG(ERROR) << "Stopped before all outputs were merged, intermediate files kept in " << workdir;
+        return EXIT_FAILURE;
+    }
+
+    const auto result = planner.Result();
+    if(result.empty()) {
+        LOG(ERROR) << "No output produced";
+        return EXIT_FAILURE;
+    }
+
+    if(planner.IsIntermediate(result)) {
+        if(rename(result.c_str(), outputfile.c_str()) != 0) {
+            LOG(ERROR) << "Cannot move " << result << " to " << outputfile;
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        // single input without map command
+        std_ext::system::exec(std_ext::formatter() << "cp " << quote(result) << " " << quote(outputfile));
+    }
+    LOG(INFO) << "Output written to " << outputfile;
+
+    if(!cmd_keeptmpfiles->isSet() && failed.empty()) {
+        // only the outputs and logs of our jobs, the final output was moved away already
+        for(const auto& file : planner.Created())
+            remove(file.c_str());
+        if(createdWorkdir)
+            rmdir(workdir.c_str());
+    }
+
+    return failed.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
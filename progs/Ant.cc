@@ -18,11 +18,14 @@
 #include "calibration/DataBase.h"
 
 #include "unpacker/Unpacker.h"
+#include "unpacker/UnpackerAcqu.h"
 #include "unpacker/RawFileReader.h"
+#include "unpacker/detail/UnpackerAcqu_index.h"
 
 #include "reconstruct/Reconstruct.h"
 
 #include "tree/TAntHeader.h"
+#include "tree/TEventCodec.h"
 
 #include "base/WrapTFile.h"
 #include "base/Logger.h"
@@ -32,10 +35,12 @@
 #include "base/std_ext/system.h"
 #include "base/std_ext/container.h"
 #include "base/GitInfo.h"
+#include "base/Shard.h"
 
 #include "TRint.h"
 #include "TSystem.h"
 #include "TROOT.h"
+#include "RVersion.h"
 
 #include <sstream>
 #include <string>
@@ -72,6 +77,7 @@ int main(int argc, char** argv) {
     auto cmd_setupOptions = cmd.add<TCLAP::MultiArg<string>>("S","setup_options","Options for setup, key=value",false,"");
 
     auto cmd_maxevents = cmd.add<TCLAP::MultiArg<int>>("m","maxevents","Process only max events",false,"maxevents");
+    auto cmd_shard = cmd.add<TCLAP::ValueArg<string>>("","shard","Process only part i of N of the input, outputs of all parts can be merged with Ant-hadd",false,"","i/N");
 
     TCLAP::ValuesConstraintExtra<decltype(analysis::PhysicsRegistry::GetList())> allowedPhysics(analysis::PhysicsRegistry::GetList());
     auto cmd_physicsclasses  = cmd.add<TCLAP::MultiArg<string>>("p","physics","Physics class to run", false, &allowedPhysics);
@@ -86,10 +92,16 @@ int main(int argc, char** argv) {
     auto cmd_calibrations  = cmd.add<TCLAP::MultiArg<string>>("c","calibration","Calibration to run",false,"calibration");
 
     auto cmd_u_disablerecon  = cmd.add<TCLAP::SwitchArg>("","u_disablereconstruct","Unpacker: Disable Reconstruct (disables also all analysis)",false);
+    auto cmd_u_scalersonly  = cmd.add<TCLAP::SwitchArg>("","u_scalersonly","Unpacker: Only unpack scalers, EPICS and tagger hits of Acqu files (fast path for tagging efficiencies and livetimes)",false);
+    auto cmd_u_createindex  = cmd.add<TCLAP::SwitchArg>("","u_createindex","Unpacker: Save an index next to Acqu raw files read completely, used for sharding and seeking (see also Ant-acqu-index)",false);
+    auto cmd_u_threads  = cmd.add<TCLAP::ValueArg<unsigned>>("","u_threads","Unpacker: Number of threads unpacking the data buffers of Acqu files (0 unpacks on the reading thread)",false,0,"n");
 
     auto cmd_p_disableParticleID  = cmd.add<TCLAP::SwitchArg>("","p_disableParticleID","Physics: Disable ParticleID",false);
     auto cmd_p_simpleParticleID  = cmd.add<TCLAP::SwitchArg>("","p_simpleParticleID","Physics: Use simple ParticleID (just protons/photons)",false);
 
+    auto cmd_cerealEvents  = cmd.add<TCLAP::SwitchArg>("","cereal-events","Write TEvents in the cereal format readable by older versions",false);
+    auto cmd_noCalibPrefetch  = cmd.add<TCLAP::SwitchArg>("","no-calib-prefetch","Do not load calibration data for the next changepoint in the background",false);
+
 
 
     cmd.parse(argc, argv);
@@ -101,9 +113,34 @@ int main(int argc, char** argv) {
     if(std_ext::system::isInteractive())
         ProgressCounter::Interval = 3;
 
+    if(cmd_cerealEvents->isSet())
+        TEventCodec::WriteFormat = TEventCodec::Format_t::Cereal;
+
     // enable caching of the calibration database
     ant::calibration::DataBase::OnDiskLayout::EnableCaching = true;
 
+    // load calibration data for the next changepoint while processing events,
+    // the loading reads ROOT files in a background thread
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    if(!cmd_noCalibPrefetch->isSet()) {
+        ROOT::EnableThreadSafety();
+        ant::calibration::DataManager::Prefetch = true;
+    }
+#endif
+
+    // create an index when reading Acqu raw files completely,
+    // only on request as the raw data might be in some read-only or shared location
+    if(cmd_u_createindex->isSet())
+        unpacker::acqu::Index::CreateOnFirstPass = true;
+
+    if(cmd_u_scalersonly->isSet()) {
+        UnpackerAcqu::ScalersOnly::Enabled = true;
+        LOG(INFO) << "Unpacking only scalers and hits of " << UnpackerAcqu::ScalersOnly::KeepHits;
+    }
+
+    if(cmd_u_threads->isSet())
+        UnpackerAcqu::Parallel::Threads = cmd_u_threads->getValue();
+
     // check if input files are readable
     for(const auto& inputfile : cmd_input->getValue()) {
         string errmsg;
@@ -208,6 +245,24 @@ int main(int argc, char** argv) {
     readers.push_back(std_ext::make_unique<analysis::input::PlutoReader>(rootfiles));
     readers.push_back(std_ext::make_unique<analysis::input::GoatReader>(rootfiles));
 
+    // restrict all readers to the same part of the input
+    if(cmd_shard->isSet()) {
+        try {
+            const auto shard = Shard::Parse(cmd_shard->getValue());
+            for(auto& reader : readers) {
+                if(!reader->SetShard(shard)) {
+                    LOG(ERROR) << "The given input files do not support processing shard " << shard;
+                    return EXIT_FAILURE;
+                }
+            }
+            LOG(INFO) << "Processing shard " << shard << " of input";
+        }
+        catch(const Shard::Exception& e) {
+            LOG(ERROR) << e.what();
+            return EXIT_FAILURE;
+        }
+    }
+
 
     // create the list of enabled calibrations here,
     // because now the readers (and underlying unpackers) did the work
@@ -382,6 +382,147 @@ void save_pad(const T* const p, const fs::path& output_dir, const string& filena
     p->Print(path.c_str());
 }
 
+// everything needed for the fit of one EPT channel,
+// which runs in a worker process of the FitDriver
+struct ref_channel_t {
+    int taggCh;
+    const TH1* h_data;
+    double cutoff;
+};
+
+void reference_channel_fit(const ref_channel_t& ch, const IntervalD& fit_range, TDirectory& dir)
+{
+    const auto h_data = ch.h_data;
+    const double cutoff = ch.cutoff;
+
+    // prepare canvas
+    auto c = new TCanvas("c", "", 10,10, 800,800);
+    c->SetTitle(Form("Fit: %s", h_data->GetTitle()));
+    c->cd();
+    c->Divide(1,2);
+    c->cd(1);
+
+    // define observable and ranges
+    RooRealVar var_IM("IM","IM", fit_range.Start(), fit_range.Stop(), "MeV");
+    var_IM.setBins(1000);
+    var_IM.setRange("full", fit_range.Start(), fit_range.Stop());  // define "full" range used for fitting
+
+    // load data to be fitted
+    RooDataHist h_roo_data("h_roo_data","dataset",var_IM,h_data);
+
+    /* MC lineshape fit
+    // build shifted mc lineshape
+    const double offset = h_data->GetBinCenter(h_data->GetMaximumBin()) - ParticleTypeDatabase::EtaPrime.Mass();
+    RooRealVar var_IM_shift("var_IM_shift", "shift in IM", offset, -20., 20.);  // use current offset as starting value (just using 0 would work equally fine)
+    RooProduct var_IM_shift_invert("var_IM_shift_invert","shifted IM",RooArgSet(var_IM_shift, RooConst(-1.)));
+    RooAddition var_IM_shifted("var_IM_shifted","shifted IM",RooArgSet(var_IM,var_IM_shift_invert));
+    RooDataHist h_roo_mc("h_roo_mc","MC lineshape", var_IM, h_mc);
+    RooHistPdf pdf_mc_lineshape("pdf_mc_lineshape","MC lineshape as PDF", var_IM_shifted, var_IM, h_roo_mc, 2);  // 2nd order interpolation (or 4th?)
+
+    // build gaussian
+    RooRealVar  var_gauss_sigma("gauss_sigma","detector resolution", 5., .01, 20.);
+    RooGaussian pdf_gaussian("pdf_gaussian","Gaussian smearing", var_IM, RooConst(0.), var_gauss_sigma);
+
+    // build signal as convolution, note that the gaussian must be the second PDF (see documentation)
+    RooFFTConvPdf pdf_signal("pdf_signal","MC_lineshape (X) gauss",var_IM, pdf_mc_lineshape, pdf_gaussian) ;
+    */
+
+    // --- Build CB Function PDF ---
+    RooRealVar cb_x0("cb_x0", "expectation value", 960, 950, 975);
+    RooRealVar cb_sigma("cb_sigma", "standard deviation", 3, .01, 20);
+    RooRealVar cb_alpha("cb_alpha", "transition gauss to power function", 1.3, .5, 2.);
+    RooRealVar cb_n("cb_n", "parameter power function", 1, .1, 10);
+    //RooCBShape pdf_signal("signal", "CB Function", var_IM, cb_x0, cb_sigma, cb_alpha, cb_n);
+    //RooNovosibirsk pdf_signal("signal", "Novosibirsk function", var_IM, cb_x0, cb_sigma, cb_n);
+    RooGaussExp pdf_signal("signal", "Simple CB function", var_IM, cb_x0, cb_sigma, cb_n);
+
+    // build background with ARGUS function
+    RooRealVar argus_cutoff("argus_cutoff","argus pos param", cutoff);  // upper threshold, calculated for beam energy
+    RooRealVar argus_shape("argus_chi","argus shape param #chi", -5, -25., 5.);
+    //RooRealVar argus_p("argus_p","argus p param", 0.5, 0, 1);
+    RooRealVar argus_p("argus_p","argus p param", .5);
+    RooArgusBG pdf_background("pdf_background","bkg argus",var_IM,argus_cutoff,argus_shape,argus_p);
+
+    const double n_total = h_data->Integral();
+    // build sum
+    RooRealVar nsig("N_sig","#signal events", n_total/2, 0., 2*n_total);
+    RooRealVar nbkg("N_bkg","#background events", n_total/2, 0., 2*n_total);
+    RooAddPdf pdf_sum("pdf_sum","total sum",RooArgList(pdf_signal,pdf_background),RooArgList(nsig,nbkg));
+
+    RooFitResult* fit = pdf_sum.fitTo(h_roo_data, Extended(), SumW2Error(kTRUE), Range("full"), Save(), PrintLevel(-1));
+    fit->Print();
+    LOG(INFO) << "Covariance Matrix:";
+    fit->covarianceMatrix().Print();
+    RooPlot* frame = var_IM.frame();
+    h_roo_data.plotOn(frame);
+    frame->GetXaxis()->SetLabelSize(.05f);
+    frame->GetXaxis()->SetTitleSize(.05f);
+    frame->GetYaxis()->SetLabelSize(.05f);
+    frame->GetYaxis()->SetTitleSize(.05f);
+    frame->GetXaxis()->SetRangeUser(fit_range.Start(), fit_range.Stop());
+    frame->SetTitle("Reference");
+
+    auto p = new TPaveText();
+    p->SetFillColor(0);
+    p->SetFillStyle(0);
+    p->SetX1NDC(0.14);
+    p->SetX2NDC(0.39);
+    p->SetY1NDC(0.38);
+    p->SetY2NDC(0.86);
+    p->SetTextSize(.04f);
+
+    // define lambda to insert lines in stat box
+    const auto addLine = [] (TPaveText& p, const RooRealVar& v, const string& name = "") {
+        p.InsertText(Form("%s = %.2f #pm %.2f", name.empty() ? v.GetName() : name.c_str(), v.getValV(), v.getError()));
+    };
+
+    //pdf_background.plotOn(frame);
+    pdf_sum.plotOn(frame, Components(pdf_background), Name("bkg"), LineColor(kAzure-3), PrintEvalErrors(-1));
+    pdf_sum.plotOn(frame, Components(pdf_signal), Name("signal"), LineColor(kGreen+1));
+    pdf_sum.plotOn(frame, Name("sum"), LineColor(kRed+1), PrintEvalErrors(-1));
+    frame->Draw();
+    pdf_sum.paramOn(frame);
+
+    RooHist* hresid = frame->residHist();
+    hresid->SetTitle("Residuals");
+    hresid->GetXaxis()->SetRangeUser(fit_range.Start(), fit_range.Stop());
+    hresid->GetXaxis()->SetTitle("m(#gamma#gamma) [MeV]");
+    hresid->GetXaxis()->SetLabelSize(.05f);
+    hresid->GetXaxis()->SetTitleSize(.05f);
+    hresid->GetXaxis()->SetTickLength(.08f);
+    hresid->GetYaxis()->SetLabelSize(.05f);
+
+    const double chi2ndf = frame->chiSquare(fit->floatParsFinal().getSize());
+
+    p->InsertText(Form("#chi^{2}/dof = %.2f", chi2ndf));
+//    addLine(*p, var_IM_shift,    "#Delta IM");
+//    addLine(*p, var_gauss_sigma, "#sigma");
+    addLine(*p, cb_x0,    "cb_mean");
+    addLine(*p, cb_sigma, "cb_sigma");
+    addLine(*p, cb_alpha, "cb_alpha");
+    addLine(*p, cb_n,     "cb_n");
+    addLine(*p, argus_cutoff,    "c");
+    addLine(*p, argus_shape,     "#chi");
+    addLine(*p, argus_p,         "p");
+    addLine(*p, nsig,            "n_{sig}");
+    addLine(*p, nbkg,            "n_{bkg}");
+    p->Draw();
+
+    c->cd(2);
+    hresid->Draw();
+
+    c->Modified();
+    c->Update();
+
+    TVectorD values(3);
+    values[0] = chi2ndf;
+    values[1] = nsig.getValV();
+    values[2] = nsig.getError();
+    dir.WriteTObject(addressof(values), "values");
+    dir.WriteTObject(frame, "frame");
+    dir.WriteTObject(c, "canvas");
+}
+
 void reference_fit(const WrapTFileInput& input, const string& cuts, const vector<int>& EPTrange,
                    const WrapTFileInput& mc, pair<double, double>& result)
 {
@@ -401,8 +542,6 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
     } else
         LOG(WARNING) << "No MC input provided, some default values will be used for efficiency corrections";
 
-    TCanvas* c = new TCanvas("c", "", 10,10, 800,800);
-
     string hist = "EtapDalitz_plot_Ref/" + cuts +  "/h/Data/taggChannel_vs_etapIM_kinfitted";
     if (!input.GetObject(hist, ref_data))
         throw runtime_error("Couldn't find " + hist + " in file " + input.FileNames());
@@ -433,156 +572,69 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
 
     canvas c_N("Number eta' based on Reference");
 
-    // loop over the provided EPT channels
-    for (const auto taggCh : EPTrange) {
-        if (interrupt)
-            break;
-
-        fit_result_t res;
-        res.taggCh = taggCh;
+    // the EPT channels are fitted independently by the fitdriver,
+    // so prepare all of them first
+    FitDriver fitdriver(settings.fitcache);
+    fitdriver.Workers = settings.workers;
 
+    vector<FitDriver::bin_t> bins;
+    for (const auto taggCh : EPTrange) {
         const double taggE = EPT->GetPhotonEnergy(unsigned(taggCh));
         const int taggBin = taggCh+1;
-        LOG(INFO) << "Fitting EPT channel " << taggCh << " (E_gamma = " << taggE << " MeV)";
 
-        h_data = ref_data->ProjectionX("h_data", taggBin, taggBin);
+        // projections need unique names as they are kept until all fits are done
+        h_data = ref_data->ProjectionX(Form("h_data_%d", taggCh), taggBin, taggBin);
         if (taggCh == 40)  // close to threshold, decrease histogram IM range
             h_data->GetXaxis()->SetRangeUser(900,1100);
-        h_mc = ref_mc->ProjectionX("h_mc", taggBin, taggBin);
-        if (trueIM_EPT)
-            h_true = trueIM_EPT->ProjectionX("h_true", taggBin, taggBin);
+        if (settings.rebin)
+            h_data->Rebin(settings.rebin);
 
         const double cutoff = maxIM(taggE);
         VLOG(1) << "EPT E = " << taggE << ", calculated cutoff value: " << cutoff;
 
-        // clear and prepare canvas
-        c->Clear();
-        c->SetTitle(Form("Fit: %s", h_data->GetTitle()));
-        c->cd();
-        c->Divide(1,2);
-        c->cd(1);
+        const ref_channel_t ch{taggCh, h_data, cutoff};
+        bins.emplace_back("ref_fit_channel" + to_string(taggCh),
+                          progs::fitdriver::Hash_t() << "EtapDalitz_fit/Ref" << *h_data << cutoff
+                          << fit_range.Start() << fit_range.Stop(),
+                          [ch, fit_range] (TDirectory& dir) {
+            reference_channel_fit(ch, fit_range, dir);
+        });
+    }
 
-        // define observable and ranges
-        RooRealVar var_IM("IM","IM", fit_range.Start(), fit_range.Stop(), "MeV");
-        var_IM.setBins(1000);
-        var_IM.setRange("full", fit_range.Start(), fit_range.Stop());  // define "full" range used for fitting
+    // keep the results, they own the fitted curves
+    const auto fitdriver_results = interrupt ? vector<FitDriver::result_t>() : fitdriver.Run(bins);
 
-        // load data to be fitted
-        if (settings.rebin)
-            h_data->Rebin(settings.rebin);
-        RooDataHist h_roo_data("h_roo_data","dataset",var_IM,h_data);
-
-        /* MC lineshape fit
-        // build shifted mc lineshape
-        const double offset = h_data->GetBinCenter(h_data->GetMaximumBin()) - ParticleTypeDatabase::EtaPrime.Mass();
-        RooRealVar var_IM_shift("var_IM_shift", "shift in IM", offset, -20., 20.);  // use current offset as starting value (just using 0 would work equally fine)
-        RooProduct var_IM_shift_invert("var_IM_shift_invert","shifted IM",RooArgSet(var_IM_shift, RooConst(-1.)));
-        RooAddition var_IM_shifted("var_IM_shifted","shifted IM",RooArgSet(var_IM,var_IM_shift_invert));
-        RooDataHist h_roo_mc("h_roo_mc","MC lineshape", var_IM, h_mc);
-        RooHistPdf pdf_mc_lineshape("pdf_mc_lineshape","MC lineshape as PDF", var_IM_shifted, var_IM, h_roo_mc, 2);  // 2nd order interpolation (or 4th?)
-
-        // build gaussian
-        RooRealVar  var_gauss_sigma("gauss_sigma","detector resolution", 5., .01, 20.);
-        RooGaussian pdf_gaussian("pdf_gaussian","Gaussian smearing", var_IM, RooConst(0.), var_gauss_sigma);
-
-        // build signal as convolution, note that the gaussian must be the second PDF (see documentation)
-        RooFFTConvPdf pdf_signal("pdf_signal","MC_lineshape (X) gauss",var_IM, pdf_mc_lineshape, pdf_gaussian) ;
-        */
+    TCanvas* c = nullptr;
+    for (size_t i = 0; i < fitdriver_results.size(); i++) {
+        if (interrupt)
+            break;
 
-        // --- Build CB Function PDF ---
-        RooRealVar cb_x0("cb_x0", "expectation value", 960, 950, 975);
-        RooRealVar cb_sigma("cb_sigma", "standard deviation", 3, .01, 20);
-        RooRealVar cb_alpha("cb_alpha", "transition gauss to power function", 1.3, .5, 2.);
-        RooRealVar cb_n("cb_n", "parameter power function", 1, .1, 10);
-        //RooCBShape pdf_signal("signal", "CB Function", var_IM, cb_x0, cb_sigma, cb_alpha, cb_n);
-        //RooNovosibirsk pdf_signal("signal", "Novosibirsk function", var_IM, cb_x0, cb_sigma, cb_n);
-        RooGaussExp pdf_signal("signal", "Simple CB function", var_IM, cb_x0, cb_sigma, cb_n);
-
-        // build background with ARGUS function
-        RooRealVar argus_cutoff("argus_cutoff","argus pos param", cutoff);  // upper threshold, calculated for beam energy
-        RooRealVar argus_shape("argus_chi","argus shape param #chi", -5, -25., 5.);
-        //RooRealVar argus_p("argus_p","argus p param", 0.5, 0, 1);
-        RooRealVar argus_p("argus_p","argus p param", .5);
-        RooArgusBG pdf_background("pdf_background","bkg argus",var_IM,argus_cutoff,argus_shape,argus_p);
-
-        const double n_total = h_data->Integral();
-        // build sum
-        RooRealVar nsig("N_sig","#signal events", n_total/2, 0., 2*n_total);
-        RooRealVar nbkg("N_bkg","#background events", n_total/2, 0., 2*n_total);
-        RooAddPdf pdf_sum("pdf_sum","total sum",RooArgList(pdf_signal,pdf_background),RooArgList(nsig,nbkg));
-
-        RooFitResult* fit = pdf_sum.fitTo(h_roo_data, Extended(), SumW2Error(kTRUE), Range("full"), Save(), PrintLevel(-1));
-        fit->Print();
-        LOG(INFO) << "Covariance Matrix:";
-        fit->covarianceMatrix().Print();
-        RooPlot* frame = var_IM.frame();
-        h_roo_data.plotOn(frame);
-        frame->GetXaxis()->SetLabelSize(.05f);
-        frame->GetXaxis()->SetTitleSize(.05f);
-        frame->GetYaxis()->SetLabelSize(.05f);
-        frame->GetYaxis()->SetTitleSize(.05f);
-        frame->GetXaxis()->SetRangeUser(fit_range.Start(), fit_range.Stop());
-        frame->SetTitle("Reference");
-
-        auto p = new TPaveText();
-        p->SetFillColor(0);
-        p->SetFillStyle(0);
-        p->SetX1NDC(0.14);
-        p->SetX2NDC(0.39);
-        p->SetY1NDC(0.38);
-        p->SetY2NDC(0.86);
-        p->SetTextSize(.04f);
-
-        // define lambda to insert lines in stat box
-        const auto addLine = [] (TPaveText& p, const RooRealVar& v, const string& name = "") {
-            p.InsertText(Form("%s = %.2f #pm %.2f", name.empty() ? v.GetName() : name.c_str(), v.getValV(), v.getError()));
-        };
+        const auto taggCh = EPTrange.at(i);
+        const auto& r = fitdriver_results[i];
 
-        //pdf_background.plotOn(frame);
-        pdf_sum.plotOn(frame, Components(pdf_background), Name("bkg"), LineColor(kAzure-3), PrintEvalErrors(-1));
-        pdf_sum.plotOn(frame, Components(pdf_signal), Name("signal"), LineColor(kGreen+1));
-        pdf_sum.plotOn(frame, Name("sum"), LineColor(kRed+1), PrintEvalErrors(-1));
-        frame->Draw();
-        pdf_sum.paramOn(frame);
-        // number of item index seems to reflect the order plotOn is called on a RooPlot:
-        // index 0 is histogram, 1 is background, 2 is signal, 3 is sum (called ploton in that order), 4 is paramBox
+        fit_result_t res;
+        res.taggCh = taggCh;
+
+        const double taggE = EPT->GetPhotonEnergy(unsigned(taggCh));
+        const int taggBin = taggCh+1;
+        LOG(INFO) << "Fit of EPT channel " << taggCh << " (E_gamma = " << taggE << " MeV)";
+
+        h_mc = ref_mc->ProjectionX("h_mc", taggBin, taggBin);
+        if (trueIM_EPT)
+            h_true = trueIM_EPT->ProjectionX("h_true", taggBin, taggBin);
+
+        const auto& values = *r.Get<TVectorD>("values");
+        res.chi2ndf = values[0];
+        // curves are named as plotted in reference_channel_fit
+        const auto frame = r.Get<RooPlot>("frame");
         res.signal = frame->getCurve("signal");
         res.bkg = frame->getCurve("bkg");
 
-        RooHist* hresid = frame->residHist();
-        hresid->SetTitle("Residuals");
-        hresid->GetXaxis()->SetRangeUser(fit_range.Start(), fit_range.Stop());
-        hresid->GetXaxis()->SetTitle("m(#gamma#gamma) [MeV]");
-        hresid->GetXaxis()->SetLabelSize(.05f);
-        hresid->GetXaxis()->SetTitleSize(.05f);
-        hresid->GetXaxis()->SetTickLength(.08f);
-        hresid->GetYaxis()->SetLabelSize(.05f);
-
-        const double chi2ndf = frame->chiSquare(fit->floatParsFinal().getSize());
-        res.chi2ndf = chi2ndf;
-
-        p->InsertText(Form("#chi^{2}/dof = %.2f", chi2ndf));
-//        addLine(*p, var_IM_shift,    "#Delta IM");
-//        addLine(*p, var_gauss_sigma, "#sigma");
-        addLine(*p, cb_x0,    "cb_mean");
-        addLine(*p, cb_sigma, "cb_sigma");
-        addLine(*p, cb_alpha, "cb_alpha");
-        addLine(*p, cb_n,     "cb_n");
-        addLine(*p, argus_cutoff,    "c");
-        addLine(*p, argus_shape,     "#chi");
-        addLine(*p, argus_p,         "p");
-        addLine(*p, nsig,            "n_{sig}");
-        addLine(*p, nbkg,            "n_{bkg}");
-        p->Draw();
-
-        c->cd(2);
-        hresid->Draw();
-
         //TODO: maybe provide default efficiency corrections if no true MC histogram provided
         constexpr double BR2g = .022;
         const double eff_corr = h_true ? h_mc->GetEntries()/h_true->GetEntries() : 35034360./1e8;
-        const double n_tot_corr = nsig.getValV()/eff_corr/BR2g;
-        const double n_error = nsig.getError()/eff_corr/BR2g;
+        const double n_tot_corr = values[1]/eff_corr/BR2g;
+        const double n_error = values[2]/eff_corr/BR2g;
         total_number_etap += n_tot_corr;
         total_n_err += n_error*n_error;
         res.n_etap = n_tot_corr;
@@ -591,9 +643,7 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
         LOG(INFO) << "Number of efficiency corrected eta' for EPT channel "
                   << taggCh << ": " << n_tot_corr << " +/- " << n_error;
 
-        c->Modified();
-        c->Update();
-
+        c = r.Get<TCanvas>("canvas");
         save_pad(c, settings.out_dir, "ref_fit_channel" + to_string(taggCh) + ".pdf");
 
         // add the number of eta' for the current EPT channel to the corresponding graph
@@ -609,6 +659,10 @@ void reference_fit(const WrapTFileInput& input, const string& cuts, const vector
         results.emplace_back(move(res));
     }
 
+    // show the last fit, as the canvas used to be reused for all channels
+    if (c)
+        c->Draw();
+
     result = {total_number_etap, sqrt(total_n_err)};
     LOG(INFO) << "Total number of eta': " << result.first << " +/- " << result.second;
 
@@ -1363,6 +1417,8 @@ int main(int argc, char** argv) {
     auto cmd_EPTrange = cmd.add<TCLAP::ValueArg<string>>("c","EPTrange","EPT channel range for reference fits, e.g. 0-40 or 0-10,35-40",
                                                          false,"0-40","channels");
     auto cmd_rebin = cmd.add<TCLAP::ValueArg<int>>("","rebin","Number of bins to rebin for some to-be-fitted histograms",false,0,"int");
+    auto cmd_workers = cmd.add<TCLAP::ValueArg<unsigned>>("","workers","Number of reference fits running in parallel",false,std::thread::hardware_concurrency(),"n");
+    auto cmd_fitcache = cmd.add<TCLAP::ValueArg<string>>("","fitcache","Folder to cache reference fit results, unchanged fits are not repeated",false,"","folder");
 
     cmd.parse(argc, argv);
 
@@ -1381,6 +1437,9 @@ int main(int argc, char** argv) {
     if (settings.rebin)
         LOG(INFO) << "Some of the to-be-fitted histograms will be rebinned combining " << settings.rebin << " bins";
 
+    settings.workers = cmd_workers->getValue();
+    settings.fitcache = cmd_fitcache->getValue();
+
     settings.corrections = cmd_corrections->getValue();
     if (settings.corrections)
         LOG(INFO) << "Radiative corrections for the TFF calculation will be applied";
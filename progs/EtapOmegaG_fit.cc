@@ -18,6 +18,8 @@
 #include "expconfig/ExpConfig.h"
 #include "base/Detector_t.h"
 
+#include "detail/FitDriver.h"
+
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TF1.h"
@@ -26,6 +28,8 @@
 #include "TGraphErrors.h"
 #include "TMultiGraph.h"
 #include "TVectorT.h"
+#include "TVectorD.h"
+#include "TDirectory.h"
 
 #include "TSystem.h"
 #include "TRint.h"
@@ -62,6 +66,7 @@ auto debug = false;
 using namespace ant;
 using namespace std;
 using namespace RooFit;
+using ant::progs::fitdriver::FitDriver;
 
 // use APLCON to calculate the total sum with error propagation
 // Value, Sigma, Pull
@@ -163,6 +168,39 @@ struct fit_return_t : ant::root_drawable_traits {
 
     double ymax = 160;
 
+    // keeps the objects alive when read from a FitDriver result
+    FitDriver::result_t source;
+
+    void Write(TDirectory& dir) const {
+        dir.WriteTObject(fitresult, "fitresult");
+        dir.WriteTObject(fitplot, "fitplot");
+        dir.WriteTObject(residual, "residual");
+        TVectorD values(3);
+        values[0] = chi2ndf;
+        values[1] = peakpos;
+        values[2] = threshold;
+        dir.WriteTObject(addressof(values), "values");
+    }
+
+    static fit_return_t Read(const FitDriver::result_t& result, const fit_params_t& p) {
+        fit_return_t r;
+        r.p = p;
+        r.source = result;
+        r.fitresult = result.Get<RooFitResult>("fitresult");
+        r.fitplot = result.Get<RooPlot>("fitplot");
+        r.residual = result.Get<RooHist>("residual");
+        // order as plotted in the fit
+        r.h_data = dynamic_cast<RooHist*>(r.fitplot->getObject(0));
+        r.f_sum = dynamic_cast<RooCurve*>(r.fitplot->getObject(1));
+        r.f_bkg = dynamic_cast<RooCurve*>(r.fitplot->getObject(2));
+        r.f_sig = dynamic_cast<RooCurve*>(r.fitplot->getObject(3));
+        const auto& values = *result.Get<TVectorD>("values");
+        r.chi2ndf = values[0];
+        r.peakpos = values[1];
+        r.threshold = values[2];
+        return r;
+    }
+
     void Draw(const string& option) const override
     {
         auto nsig = getPar_N();
@@ -539,7 +577,8 @@ N_t doReference(const WrapTFileInput& input,
                 const unique_ptr<ofstream>& textout,
                 const std::string& imgdir,
                 vector<string> cutchoice,
-                const interval<int>& taggChRange) {
+                const interval<int>& taggChRange,
+                const FitDriver& fitdriver) {
     analysis::HistogramFactory::DirStackPush HistFacDir(analysis::HistogramFactory("Ref"));
 
     auto Tagger = ExpConfig::Setup::GetDetector<TaggerDetector_t>();
@@ -596,23 +635,41 @@ N_t doReference(const WrapTFileInput& input,
         *textout << formatCutString(pickedCut) << '\n';
     }
 
+    // the tagger channels are fitted independently by the fitdriver,
+    // so prepare all of them first
+    vector<fit_params_t> params;
+    vector<FitDriver::bin_t> bins;
     for(auto taggch=taggChRange.Stop();taggch>=taggChRange.Start();taggch--) {
-        LOG(INFO) << "Fitting TaggCh=" << taggch;
         fit_params_t p;
         p.TaggCh = taggch;
         p.Eg = Tagger->GetPhotonEnergy(taggch);
 
-        // fit MC lineshape to data
+        // fit MC lineshape to data, projections need unique names
+        // as they are kept until all fits are done
         const auto taggbin = taggch+1;
-        p.h_mc   = ref_mc->ProjectionX("h_mc",taggbin,taggbin);
-        p.h_data = ref_data->ProjectionX("h_data",taggbin,taggbin);
+        p.h_mc   = ref_mc->ProjectionX(("h_mc_TaggCh="+to_string(taggch)).c_str(),taggbin,taggbin);
+        p.h_data = ref_data->ProjectionX(("h_data_TaggCh="+to_string(taggch)).c_str(),taggbin,taggbin);
 
         // higher tagger channels have quite low number of signal events
         // provide better starting value in this case
         if(p.TaggCh>=38)
             p.start_Nsig = 1e2;
 
-        auto r = doReferenceFit(p);
+        params.emplace_back(p);
+        bins.emplace_back("Ref_TaggCh="+to_string(taggch),
+                          progs::fitdriver::Hash_t() << "EtapOmegaG_fit/Ref"
+                          << *p.h_mc << *p.h_data << p.Eg << p.start_Nsig,
+                          [p] (TDirectory& dir) {
+            doReferenceFit(p).Write(dir);
+        });
+    }
+
+    const auto fitdriver_results = fitdriver.Run(bins);
+
+    for(size_t i=0;i<params.size();i++) {
+        const auto& p = params[i];
+        const auto taggbin = p.TaggCh+1;
+        auto r = fit_return_t::Read(fitdriver_results[i], p);
 
         calcNEffCorr(r.getPar_N(), // N from fit
                      N_t::fromIntegral(*p.h_mc), // N_mcreco
@@ -795,10 +852,15 @@ N_t doReference(const WrapTFileInput& input,
 
 const string sig_prefix   = "EtapOmegaG_plot_Sig";
 
-N_t doSignal(const string& sig_histpath,
-              const WrapTFileInput& input,
-              const WrapTFileInput& mctestinput,
-              N_t& N_fit, bool showcanvas)
+struct sig_hists_t {
+    TH1D* sig_data;
+    TH1D* sig_mc;
+    TH1D* sig_mctrue_generated;
+};
+
+sig_hists_t getSignalHists(const string& sig_histpath,
+                           const WrapTFileInput& input,
+                           const WrapTFileInput& mctestinput)
 {
     TH1D* sig_data;
     TH1D* sig_mc;
@@ -836,14 +898,13 @@ N_t doSignal(const string& sig_histpath,
 
     }
 
-    analysis::HistogramFactory::DirStackPush HistFacDir(analysis::HistogramFactory("Sig"));
-
+    return {sig_data, sig_mc, sig_mctrue_generated};
+}
 
-    // start creating the overview (more will be added after fits)
-    ant::canvas c_overview("Sig Overview");
-    c_overview << drawoption("colz")
-               << sig_mc << sig_data
-               << sig_mctrue_generated;
+fit_return_t doSignalFit(const sig_hists_t& h)
+{
+    const auto sig_data = h.sig_data;
+    const auto sig_mc = h.sig_mc;
 
     // define observable and ranges
     RooRealVar x("IM","IM", sig_data->GetXaxis()->GetXmin(), sig_data->GetXaxis()->GetXmax(), "MeV");
@@ -887,13 +948,8 @@ N_t doSignal(const string& sig_histpath,
     // use , Optimize(false), Strategy(2) for double gaussian...?!
 
     fit_return_t r;
-    r.ymax = 300;
-
     r.fitresult = pdf_sum.fitTo(h_roo_data, Extended(), SumW2Error(kTRUE), Range("full"), Save(), PrintLevel(debug ? 3 : -1));
 
-    if(showcanvas)
-        r.fitresult->Print();
-
     // draw output and remember pointer
     r.fitplot = x.frame();
 
@@ -916,13 +972,31 @@ N_t doSignal(const string& sig_histpath,
     r.f_bkg = dynamic_cast<RooCurve*>(r.fitplot->findObject(0));
     pdf_sum.plotOn(r.fitplot, Components(pdf_signal), LineColor(kGreen));
     r.f_sig = dynamic_cast<RooCurve*>(r.fitplot->findObject(0));
+    return r;
+}
+
+N_t doSignal(const sig_hists_t& h, fit_return_t r,
+             N_t& N_fit, bool showcanvas)
+{
+    analysis::HistogramFactory::DirStackPush HistFacDir(analysis::HistogramFactory("Sig"));
+
+    // start creating the overview (more will be added after fits)
+    ant::canvas c_overview("Sig Overview");
+    c_overview << drawoption("colz")
+               << h.sig_mc << h.sig_data
+               << h.sig_mctrue_generated;
+
+    r.ymax = 300;
+
+    if(showcanvas)
+        r.fitresult->Print();
 
     // do efficiency correction
     // (simple here, as integrated over all tagger channels)
-    N_fit = N_t(nsig);
+    N_fit = r.getPar_N();
     calcNEffCorr(N_fit,
-                 N_t::fromIntegral(*sig_mc),
-                 N_t::fromIntegral(*sig_mctrue_generated),
+                 N_t::fromIntegral(*h.sig_mc),
+                 N_t::fromIntegral(*h.sig_mctrue_generated),
                  r.N_effcorr
                  );
 
@@ -980,6 +1054,8 @@ int main(int argc, char** argv) {
     auto cmd_cut = cmd.add<TCLAP::MultiArg<string>>("c","cut","Select cuts instead of default provided", false, "");
     auto cmd_textout = cmd.add<TCLAP::ValueArg<string>>("","textout","Dump numbers to file as text (gnuplot compatible)",false,"", "");
     auto cmd_imgdir = cmd.add<TCLAP::ValueArg<string>>("","imgdir","Output folder for SaveMultiImages calls",false,"", "");
+    auto cmd_workers = cmd.add<TCLAP::ValueArg<unsigned>>("","workers","Number of fits running in parallel",false,std::thread::hardware_concurrency(),"n");
+    auto cmd_fitcache = cmd.add<TCLAP::ValueArg<string>>("","fitcache","Folder to cache fit results, unchanged fits are not repeated",false,"","folder");
 
     cmd.parse(argc, argv);
 
@@ -1008,6 +1084,9 @@ int main(int argc, char** argv) {
     if(cmd_mctestinput->isSet())
         mctestinput.OpenFile(cmd_mctestinput->getValue());
 
+    FitDriver fitdriver(cmd_fitcache->getValue());
+    fitdriver.Workers = cmd_workers->getValue();
+
     const bool skipRef = cmd_skipref->isSet();
     const bool skipSig = cmd_skipsig->isSet();
 
@@ -1046,7 +1125,8 @@ int main(int argc, char** argv) {
         N_t BR_etap_2g(2.20/100.0,0.08/100.0); // branching ratio eta'->2g is about 2.2 % (PDG)
         auto N_ref_events = doReference(input, mctestinput, textout_stream,
                                         cmd_imgdir->getValue(),
-                                        cmd_cut->getValue(), taggChRange);
+                                        cmd_cut->getValue(), taggChRange,
+                                        fitdriver);
         LOG(INFO) << "Number of eta' -> 2g events (effcorr): " << N_ref_events;
         APLCON::Fit_Settings_t fit_settings;
         fit_settings.ConstraintAccuracy = 1e-2;
@@ -1116,11 +1196,28 @@ int main(int argc, char** argv) {
                                  "/IM_Pi0g[1]");
         }
 
+        // fit all cut selections in parallel
+        vector<sig_hists_t> sig_hists;
+        vector<FitDriver::bin_t> bins;
         for(const auto& sig_histpath : sig_histpaths) {
+            sig_hists.emplace_back(getSignalHists(sig_histpath, input, mctestinput));
+            const auto& h = sig_hists.back();
+            bins.emplace_back(sig_histpath.substr(sig_prefix.size()+1),
+                              progs::fitdriver::Hash_t() << "EtapOmegaG_fit/Sig"
+                              << *h.sig_data << *h.sig_mc,
+                              [h] (TDirectory& dir) {
+                doSignalFit(h).Write(dir);
+            });
+        }
+        const auto fitdriver_results = fitdriver.Run(bins);
+
+        for(size_t i=0;i<sig_histpaths.size();i++) {
+            const auto& sig_histpath = sig_histpaths[i];
             LOG(INFO) << "Cut selection: " << sig_histpath;
 
             N_t N_fit;
-            const auto N_sig_events = doSignal(sig_histpath, input, mctestinput, N_fit, sig_histpaths.size()==1);
+            const auto N_sig_events = doSignal(sig_hists[i], fit_return_t::Read(fitdriver_results[i], {}),
+                                               N_fit, sig_histpaths.size()==1);
 
             const auto BR_etap_omega_g = calcBranchingRatio(N_sig_events, N_etap);
             if(BR_etap_omega_g.Sigma/BR_etap_omega_g.Value>0.5)
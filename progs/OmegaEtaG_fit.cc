@@ -17,6 +17,8 @@
 #include "expconfig/setups/SetupRegistry.h"
 #include "expconfig/detectors/Tagger.h"
 
+#include "detail/FitDriver.h"
+
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TF1.h"
@@ -47,11 +49,14 @@
 #include "TGraphErrors.h"
 #include "base/PhysicsMath.h"
 #include "TPavesText.h"
+#include "TVectorD.h"
+#include "TDirectory.h"
 
 using namespace ant;
 using namespace ant::std_ext;
 using namespace std;
 using namespace RooFit;
+using ant::progs::fitdriver::FitDriver;
 
 struct ValError {
     double v;
@@ -117,7 +122,14 @@ struct FitOmegaPeak {
     FitOmegaPeak& operator=(const FitOmegaPeak&) = default;
     FitOmegaPeak& operator=(FitOmegaPeak&&) = default;
 
+    void Write(TDirectory& dir) const;
+    static FitOmegaPeak Read(const FitDriver::result_t& result);
+
     friend ostream& operator<<(ostream& s, const FitOmegaPeak& argus_f);
+
+protected:
+    // the numbers stored by Write, in order
+    vector<double*> numbers();
 };
 
 TH2D* extrudeX(const TH1* slice, const BinSettings& xbins, const string& newname="") {
@@ -146,6 +158,34 @@ T* getHist(WrapTFileInput& f, const string& hpath) {
 
 using cosTbins_t = vector<tuple<double,interval<double>,FitOmegaPeak>>;
 
+// everything needed for one fit, which runs in a worker process of the FitDriver
+struct fit_bin_t {
+    string Name;
+    double cosT;
+    interval<double> Eg;
+    const TH1* h_data;
+    const TH1* h_mc;
+    double n_mc_input;
+    ValError lumi;
+    double binwidth;
+    interval<double> fitrange;
+    string title;
+    string imgname; // saves the fit canvas if not empty
+
+    FitDriver::bin_t MakeBin() const {
+        progs::fitdriver::Hash_t hash;
+        hash << "OmegaEtaG_fit/FitOmegaPeak" << *h_data << *h_mc << n_mc_input
+             << lumi.v << lumi.e << binwidth << fitrange.Start() << fitrange.Stop() << title;
+        const fit_bin_t b = *this;
+        return {Name, hash, [b] (TDirectory& dir) {
+                auto canvas = new TCanvas();
+                canvas->SetCanvasSize(600,600);
+                FitOmegaPeak(b.h_data, b.h_mc, b.n_mc_input, b.lumi, b.binwidth, b.fitrange, canvas, b.title).Write(dir);
+                dir.WriteTObject(canvas, "canvas");
+            }};
+    }
+};
+
 int main(int argc, char** argv) {
     SetupLogger();
 
@@ -166,6 +206,8 @@ int main(int argc, char** argv) {
     auto cmd_range_min = cmd.add<TCLAP::ValueArg<double>>("","range_min","Fitrange [MeV]",false,670.0,"double [MeV]");
     auto cmd_range_max = cmd.add<TCLAP::ValueArg<double>>("","range_max","Fitrange [MeV]",false,900.0,"double [MeV]");
   //  auto cmd_range     = cmd.add<TCLAP::ValueArg<interval<double>>>("","range","Fit range",false,"","range");
+    auto cmd_workers   = cmd.add<TCLAP::ValueArg<unsigned>>("","workers","Number of fits running in parallel",false,std::thread::hardware_concurrency(),"n");
+    auto cmd_fitcache  = cmd.add<TCLAP::ValueArg<string>>("","fitcache","Folder to cache fit results, unchanged fits are not repeated",false,"","folder");
 
     cmd.parse(argc, argv);
     if(cmd_verbose->isSet()) {
@@ -227,54 +269,31 @@ int main(int argc, char** argv) {
 //    canvas("uncorr") << h_im_direct << endc;
 //    canvas("corr")  << h_im_corr << endc;
 
-    cosTbins_t ctbins;
-
+    // the bins are fitted independently by the fitdriver, so prepare all of them first
+    vector<fit_bin_t> fitbins;
 
     if(cmd_mode->getValue() == "global") {
-        ctbins.reserve(1);
         auto h_data =  getHist<TH1D>(input_data, cmd_histpath->getValue()+datahist+cmd_histname->getValue());
-        ctbins.push_back({NaN,interval<double>(NaN,NaN),{
-               h_data,
-                getHist<TH1D>(input_mc  , cmd_histpath->getValue()+refhist+cmd_histname->getValue()),
-                        n_mc->Integral(),
-                                   total_lumi,1.0,TH_ext::getBins(h_data->GetXaxis())}});
+        fitbins.push_back({"global", NaN, interval<double>(NaN,NaN),
+                           h_data,
+                           getHist<TH1D>(input_mc  , cmd_histpath->getValue()+refhist+cmd_histname->getValue()),
+                           n_mc->Integral(),
+                           total_lumi, 1.0, TH_ext::getBins(h_data->GetXaxis()), "", ""});
     } else if(cmd_mode->getValue() == "cosT") {
 
         const auto nbins=int(n_mc->GetNbinsX());
 
-        ctbins.reserve(unsigned(nbins));
-        TGraphErrors* g = new TGraphErrors(nbins);
-        TGraphErrors* geff = new TGraphErrors(nbins);
-        const auto SetPoint = [] (TGraphErrors& g, const int& i, const ValError& x, const ValError& y) {
-            g.SetPoint(i,x.v, y.v);
-            g.SetPointError(i,x.e,y.e);
-        };
-
         for(size_t i=0;i<unsigned(nbins);++i) {
-            const auto cosT = n_mc->GetBinCenter(int(i+1));
             const string basepath = std_ext::formatter() << cmd_histpath->getValue() << "/cosT_" << i;
             const auto h_data = getHist<TH1D>(input_data,std_ext::formatter() << basepath << datahist << cmd_histname->getValue());
             const auto h_mc = getHist<TH1D>(input_mc,  std_ext::formatter() << basepath << refhist  << cmd_histname->getValue());
-            ctbins.push_back({n_mc->GetBinCenter(int(i+1)),{NaN,NaN},
-                    {
-                        h_data,
-                        h_mc,
-                        n_mc->GetBinContent(int(1+i)),
-                           total_lumi, n_mc->GetBinWidth(int(1+i)),TH_ext::getBins(h_data->GetXaxis())
-                    }});
-
-            const auto& fitres = ctbins.at(i);
-            SetPoint(*g,    int(i), {cosT, 0.}, get<2>(fitres).vn_corr);
-            SetPoint(*geff, int(i), {cosT, 0.}, get<2>(fitres).rec_eff);
+            fitbins.push_back({formatter() << "cosT_" << i, n_mc->GetBinCenter(int(i+1)), {NaN,NaN},
+                               h_data,
+                               h_mc,
+                               n_mc->GetBinContent(int(1+i)),
+                               total_lumi, n_mc->GetBinWidth(int(1+i)), TH_ext::getBins(h_data->GetXaxis()), "", ""});
         }
 
-        auto c = new TCanvas();
-        c->Divide(2,1);
-        c->cd(1);
-        g->Draw("AP");
-        c->cd(2);
-        geff->Draw("AP");
-
 //        if(cmd_ITtest->isSet()) {
 //            TGraph* io = new TGraph(int(ctbins.size()));
 //            int i=0;
@@ -323,11 +342,8 @@ int main(int argc, char** argv) {
 
         //canvas->Divide(nc,n_tagger_bins);
 
-        ctbins.reserve( unsigned(nc * n_tagger_groups ));
-
         const auto cosTslicelimit = cmd_cosTslice->getValue();
         const auto Taggslicelimit = cmd_Taggslice->getValue();
-        TCanvas* canvas = nullptr;
 
         for(int c=1;c<=nc; ++c) {
 
@@ -350,8 +366,9 @@ int main(int argc, char** argv) {
 
                 const auto tagger_bin = tagger_group * ntaggergroup;
 
-                auto h_data_slice = h_data2d->ProjectionX("data_slice",tagger_bin,tagger_bin+ntaggergroup-1);
-                auto h_mc_slice   = h_mc2d->ProjectionX(  "mc_slice",  tagger_bin,tagger_bin+ntaggergroup-1);
+                // slices need unique names, as they are kept until all fits are done
+                auto h_data_slice = h_data2d->ProjectionX(Form("data_slice_%d_%d",c,tagger_group),tagger_bin,tagger_bin+ntaggergroup-1);
+                auto h_mc_slice   = h_mc2d->ProjectionX(  Form("mc_slice_%d_%d",c,tagger_group),  tagger_bin,tagger_bin+ntaggergroup-1);
 
                 h_data_slice->GetXaxis()->SetRangeUser(fitrange.Start(), fitrange.Stop());
                 h_mc_slice->GetXaxis()->SetRangeUser(fitrange.Start(), fitrange.Stop());
@@ -363,24 +380,17 @@ int main(int argc, char** argv) {
                 //auto pad = canvas->cd(1 + tagger_group + (c-1)*n_tagger_bins);
                 const string title = formatter() << "W=" << round(math::W(Eg.Center(), ParticleTypeDatabase::Proton)*100.0)/100.0 << " MeV cos(#theta)_{cm}=" << cosT;
 
-                delete canvas;
-                canvas = new TCanvas();
-                canvas->SetCanvasSize(600,600);
-
-                ctbins.push_back({cosT,Eg,
-                                     {
-                                         h_data_slice,
-                                         h_mc_slice,
-                                         n_mc_input->Integral(int(tagger_bin),int(tagger_bin)+ntaggergroup-1),
-                                         lumi_slice,
-                                         cosT_binwidth,
-                                         TH_ext::getBins(h_data_slice->GetXaxis()),
-                                         canvas,
-                                        title
-                                     }});
-
                 const string fname = formatter() << (c-1)*n_tagger_groups+tagger_group << "_W=" << round(math::W(Eg.Center(), ParticleTypeDatabase::Proton)) << "cosTbin=" << c-1;
-                canvas->SaveMultiImages(fname.c_str());
+
+                fitbins.push_back({fname, cosT, Eg,
+                                   h_data_slice,
+                                   h_mc_slice,
+                                   n_mc_input->Integral(int(tagger_bin),int(tagger_bin)+ntaggergroup-1),
+                                   lumi_slice,
+                                   cosT_binwidth,
+                                   TH_ext::getBins(h_data_slice->GetXaxis()),
+                                   title,
+                                   fname});
             }
 
 
@@ -390,6 +400,56 @@ int main(int argc, char** argv) {
         LOG(FATAL) << "invalid mode: " << cmd_mode->getValue();
     }
 
+    FitDriver fitdriver(cmd_fitcache->getValue());
+    fitdriver.Workers = cmd_workers->getValue();
+
+    vector<FitDriver::bin_t> bins;
+    for(const auto& b : fitbins)
+        bins.emplace_back(b.MakeBin());
+    // keep the results, they own the fit canvases
+    const auto fitdriver_results = fitdriver.Run(bins);
+
+    cosTbins_t ctbins;
+    ctbins.reserve(fitbins.size());
+    for(size_t i=0;i<fitbins.size();++i) {
+        const auto& b = fitbins[i];
+        const auto& r = fitdriver_results[i];
+        ctbins.emplace_back(b.cosT, b.Eg, FitOmegaPeak::Read(r));
+
+        auto canvas = r.Get<TCanvas>("canvas");
+        if(!b.imgname.empty())
+            canvas->SaveMultiImages(b.imgname.c_str());
+        // the cosTE mode used to show only the last of its many fits
+        if(cmd_mode->getValue() != "cosTE" || i+1 == fitbins.size())
+            canvas->Draw();
+    }
+
+    if(cmd_mode->getValue() == "cosT") {
+
+        const auto nbins=int(ctbins.size());
+
+        TGraphErrors* g = new TGraphErrors(nbins);
+        TGraphErrors* geff = new TGraphErrors(nbins);
+        const auto SetPoint = [] (TGraphErrors& g, const int& i, const ValError& x, const ValError& y) {
+            g.SetPoint(i,x.v, y.v);
+            g.SetPointError(i,x.e,y.e);
+        };
+
+        for(size_t i=0;i<unsigned(nbins);++i) {
+            const auto& fitres = ctbins.at(i);
+            const auto cosT = get<0>(fitres);
+            SetPoint(*g,    int(i), {cosT, 0.}, get<2>(fitres).vn_corr);
+            SetPoint(*geff, int(i), {cosT, 0.}, get<2>(fitres).rec_eff);
+        }
+
+        auto c = new TCanvas();
+        c->Divide(2,1);
+        c->cd(1);
+        g->Draw("AP");
+        c->cd(2);
+        geff->Draw("AP");
+    }
+
 
     const auto delim = '\t';
 
@@ -656,6 +716,39 @@ FitOmegaPeak::FitOmegaPeak(const TH1 *h_data, const TH1 *h_mc, const double n_mc
 
 }
 
+vector<double*> FitOmegaPeak::numbers()
+{
+    return {
+        &vnsig.v, &vnsig.e, &vnbkg.v, &vnbkg.e, &chi2ndf,
+        &rec_eff.v, &rec_eff.e, &vn_corr.v, &vn_corr.e,
+        &sigmaOmega.v, &sigmaOmega.e, &sigma.v, &sigma.e,
+        &argus_c.v, &argus_c.e, &argus_p.v, &argus_p.e, &argus_f.v, &argus_f.e,
+        &mshift.v, &mshift.e, &nMC, &nMCInput
+    };
+}
+
+void FitOmegaPeak::Write(TDirectory& dir) const
+{
+    auto copy = *this;
+    const auto n = copy.numbers();
+    TVectorD values(int(n.size()));
+    for(size_t i=0;i<n.size();++i)
+        values[int(i)] = *n[i];
+    dir.WriteTObject(addressof(values), "values");
+}
+
+FitOmegaPeak FitOmegaPeak::Read(const FitDriver::result_t& result)
+{
+    FitOmegaPeak f;
+    const auto n = f.numbers();
+    const auto& values = *result.Get<TVectorD>("values");
+    if(values.GetNrows() != int(n.size()))
+        throw runtime_error("Unexpected number of values in result of fit "+result.Name);
+    for(size_t i=0;i<n.size();++i)
+        *n[i] = values[int(i)];
+    return f;
+}
+
 ostream& operator<<(ostream &s, const FitOmegaPeak &f)
 {
     s << "[NSig="    << f.vnsig
@@ -12,6 +12,7 @@
 
 #include "base/ParticleType.h"
 
+#include "detail/FitDriver.h"
 
 
 #include "TH1D.h"
@@ -20,6 +21,8 @@
 #include "TCanvas.h"
 #include "TPaveText.h"
 #include "TGraphErrors.h"
+#include "TVectorD.h"
+#include "TDirectory.h"
 
 #include "TSystem.h"
 #include "TRint.h"
@@ -32,6 +35,7 @@ using namespace ant::std_ext;
 using namespace ant::analysis;
 using namespace ant::analysis::utils;
 using namespace SIGMA;
+using ant::progs::fitdriver::FitDriver;
 
 
 int main(int argc, char** argv) {
@@ -58,6 +62,8 @@ int main(int argc, char** argv) {
     auto cmd_seenprefix    = cmd.add<TCLAP::ValueArg<string>>("","seenprefix","Name of hist",false,"hist00","name");
 
     auto cmd_output        = cmd.add<TCLAP::ValueArg<string>>("o","output","Output file",false,"","filename");
+    auto cmd_workers       = cmd.add<TCLAP::ValueArg<unsigned>>("","workers","Number of fits running in parallel",false,std::thread::hardware_concurrency(),"n");
+    auto cmd_fitcache      = cmd.add<TCLAP::ValueArg<string>>("","fitcache","Folder to cache fit results, unchanged fits are not repeated",false,"","folder");
 
 
     TCLAP::ValuesConstraintExtra<decltype(ExpConfig::Setup::GetNames())> allowedsetupnames(ExpConfig::Setup::GetNames());
@@ -124,12 +130,40 @@ int main(int argc, char** argv) {
             * BR::Sigma_Pi0p * BR::Pi0_gg
             * BR::K0S_Pi0Pi0 * BR::Pi0_gg * BR::Pi0_gg;
 
+    // the bins of data and mc are fitted independently by the fitdriver
+    FitDriver fitdriver(cmd_fitcache->getValue());
+    fitdriver.Workers = cmd_workers->getValue();
+
+    const auto makeBin = [] (const string& name, TH2D* hist) {
+        return FitDriver::bin_t(name,
+                                progs::fitdriver::Hash_t() << "SigmaPlus_fit/fitHist" << *hist,
+                                [hist] (TDirectory& dir) {
+            const auto r = tools::fitHist(hist);
+            TVectorD values(2);
+            values[0] = r.v;
+            values[1] = r.e;
+            dir.WriteTObject(addressof(values), "values");
+        });
+    };
+    const auto readBin = [] (const FitDriver::result_t& r) -> ValError {
+        const auto& values = *r.Get<TVectorD>("values");
+        return {values[0], values[1]};
+    };
+
+    vector<FitDriver::bin_t> bins;
+    for (auto i = 0u ; i < TaggerBins::EPTBinning().size() ; ++i)
+    {
+        bins.emplace_back(makeBin(formatter() << "Data_bin=" << i, dalitzHists.at(i)));
+        bins.emplace_back(makeBin(formatter() << "MC_bin=" << i, dalitzHists_MC.at(i)));
+    }
+    const auto fitdriver_results = fitdriver.Run(bins);
+
     for (auto i = 0u ; i < TaggerBins::EPTBinning().size() ; ++i)
     {
         const auto binRange            = taggerBinRanges.at(i);
 
-        const auto result       = tools::fitHist(dalitzHists.at(i));
-        const auto resultmc     = tools::fitHist(dalitzHists_MC.at(i));
+        const auto result       = readBin(fitdriver_results.at(2*i));
+        const auto resultmc     = readBin(fitdriver_results.at(2*i+1));
         const auto eff  = resultmc / seenMCs.at(i);
         const auto resultEffCor = result / eff;
         const auto integralLumi = tools::CountSeenMc(h_lumi,binRange);
@@ -0,0 +1,243 @@
+#include "FitDriver.h"
+
+#include "base/tmpfile_t.h"
+#include "base/Logger.h"
+#include "base/std_ext/memory.h"
+#include "base/std_ext/misc.h"
+#include "base/std_ext/string.h"
+#include "base/std_ext/system.h"
+
+#include "TFile.h"
+#include "TH1.h"
+#include "TDirectory.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <map>
+
+#include <sys/stat.h> // for fchmod
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace ant;
+using namespace ant::progs::fitdriver;
+
+void Hash_t::add(const void* data, size_t size)
+{
+    // FNV-1a, good enough to detect changed inputs
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    for(size_t i=0;i<size;i++) {
+        Value ^= bytes[i];
+        Value *= 1099511628211ull;
+    }
+}
+
+Hash_t& Hash_t::operator<<(const TH1& h)
+{
+    for(auto axis : {h.GetXaxis(), h.GetYaxis(), h.GetZaxis()}) {
+        *this << axis->GetNbins() << axis->GetXmin() << axis->GetXmax();
+        const auto& bins = *axis->GetXbins();
+        if(bins.GetSize()>0)
+            add(bins.GetArray(), sizeof(double)*unsigned(bins.GetSize()));
+    }
+    for(int i=0;i<h.GetNcells();i++)
+        *this << h.GetBinContent(i) << h.GetBinError(i);
+    return *this;
+}
+
+Hash_t& Hash_t::operator<<(const string& s)
+{
+    *this << static_cast<long long>(s.size());
+    add(s.data(), s.size());
+    return *this;
+}
+
+Hash_t& Hash_t::operator<<(double v)
+{
+    add(addressof(v), sizeof(v));
+    return *this;
+}
+
+Hash_t& Hash_t::operator<<(long long v)
+{
+    add(addressof(v), sizeof(v));
+    return *this;
+}
+
+string Hash_t::ToString() const
+{
+    return std_ext::formatter() << hex << setw(16) << setfill('0') << Value;
+}
+
+TObject* FitDriver::result_t::GetObject(const string& name) const
+{
+    auto obj = file->Get(name.c_str());
+    if(!obj)
+        throw Exception("Cannot find "+name+" in result of fit "+Name);
+    return obj;
+}
+
+FitDriver::FitDriver(const string& cachedir_) :
+    cachedir(cachedir_)
+{
+    if(cachedir.empty()) {
+        tmpfolder = std_ext::make_unique<tmpfolder_t>();
+    }
+    else if(gSystem->AccessPathName(cachedir.c_str()) && gSystem->mkdir(cachedir.c_str(), true) != 0) {
+        throw Exception("Cannot create fit cache folder "+cachedir);
+    }
+}
+
+FitDriver::~FitDriver() = default;
+
+string FitDriver::resultfile(const bin_t& bin) const
+{
+    // the name is only for the user browsing the cache,
+    // the hash makes it unique
+    string name = bin.Name.substr(0, 100);
+    for(auto& c : name) {
+        if(!isalnum(c) && c != '-' && c != '=')
+            c = '_';
+    }
+    return std_ext::formatter()
+            << (cachedir.empty() ? tmpfolder->foldername : cachedir)
+            << "/" << name << "_" << bin.Hash.ToString() << ".root";
+}
+
+namespace {
+
+// runs the fit and writes the result file, returns false on error
+bool runFit(const FitDriver::bin_t& bin, const string& filename) noexcept
+{
+    // write to temporary file first, so the cache never contains results
+    // of aborted fits, and concurrent runs need their own temporary file
+    string tmpfile = filename + ".XXXXXX";
+    {
+        const int fd = mkstemp(&tmpfile[0]);
+        if(fd == -1) {
+            LOG(WARNING) << "Cannot create temporary file for fit " << bin.Name;
+            return false;
+        }
+        // mkstemp only allows the owner to read the file
+        fchmod(fd, 0644);
+        close(fd);
+    }
+    try {
+        const auto prev_Directory = gDirectory;
+        std_ext::execute_on_destroy restoreDir([prev_Directory] () {
+            gDirectory = prev_Directory;
+        });
+
+        unique_ptr<TFile> output(TFile::Open(tmpfile.c_str(), "RECREATE"));
+        if(!output || output->IsZombie()) {
+            remove(tmpfile.c_str());
+            return false;
+        }
+        output->cd();
+        bin.Fit(*output);
+        output->Close();
+    }
+    catch(const exception& e) {
+        LOG(WARNING) << "Fit " << bin.Name << " failed: " << e.what();
+        remove(tmpfile.c_str());
+        return false;
+    }
+    if(rename(tmpfile.c_str(), filename.c_str()) != 0) {
+        remove(tmpfile.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
+
+vector<FitDriver::result_t> FitDriver::Run(const vector<bin_t>& bins) const
+{
+    vector<string> filenames;
+    vector<size_t> todo;
+    for(size_t i=0;i<bins.size();i++) {
+        filenames.emplace_back(resultfile(bins[i]));
+        if(cachedir.empty() || !std_ext::system::testopen(filenames.back()))
+            todo.emplace_back(i);
+    }
+
+    LOG(INFO) << "Running " << todo.size() << " fits with up to " << max(1u, Workers)
+              << " workers, " << bins.size()-todo.size() << " fits taken from cache";
+
+    vector<string> failed;
+
+    if(Workers <= 1) {
+        for(auto i : todo) {
+            LOG(INFO) << "Fitting " << bins[i].Name;
+            if(!runFit(bins[i], filenames[i]))
+                failed.emplace_back(bins[i].Name);
+        }
+    }
+    else {
+        // flush before forking, otherwise buffered output is printed by every worker
+        cout.flush();
+        cerr.flush();
+        fflush(nullptr);
+
+        map<pid_t, size_t> running;
+        auto it_todo = todo.begin();
+        while(it_todo != todo.end() || !running.empty()) {
+
+            if(it_todo != todo.end() && running.size() < Workers) {
+                const auto i = *it_todo++;
+                const auto pid = fork();
+                if(pid < 0)
+                    throw Exception("Cannot fork worker for fit "+bins[i].Name);
+                if(pid == 0) {
+                    // worker process, skip any cleanup of the parent's state
+                    _exit(runFit(bins[i], filenames[i]) ? EXIT_SUCCESS : EXIT_FAILURE);
+                }
+                running.emplace(pid, i);
+                continue;
+            }
+
+            int status = 0;
+            const auto pid = waitpid(-1, addressof(status), 0);
+            if(pid < 0)
+                throw Exception("Waiting for fit workers failed");
+            auto it_running = running.find(pid);
+            if(it_running == running.end())
+                continue;
+            const auto& bin = bins[it_running->second];
+            if(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+                VLOG(3) << "Finished fit " << bin.Name;
+            }
+            else {
+                failed.emplace_back(bin.Name);
+            }
+            running.erase(it_running);
+        }
+    }
+
+    if(!failed.empty())
+        throw Exception("Fits failed: "+std_ext::concatenate_string(failed, ", "));
+
+    // open the results in order of the bins, keep the current directory
+    const auto prev_Directory = gDirectory;
+    std_ext::execute_on_destroy restoreDir([prev_Directory] () {
+        gDirectory = prev_Directory;
+    });
+
+    vector<result_t> results(bins.size());
+    for(size_t i=0;i<bins.size();i++) {
+        auto& r = results[i];
+        r.Name = bins[i].Name;
+        r.FromCache = find(todo.begin(), todo.end(), i) == todo.end();
+        r.file = shared_ptr<TFile>(TFile::Open(filenames[i].c_str(), "READ"));
+        if(!r.file || r.file->IsZombie())
+            throw Exception("Cannot read result of fit "+r.Name+" from "+filenames[i]);
+    }
+    return results;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TDirectory;
+class TFile;
+class TH1;
+class TObject;
+
+namespace ant {
+
+struct tmpfolder_t;
+
+namespace progs {
+namespace fitdriver {
+
+/**
+ * @brief The Hash_t struct builds a hash of everything a fit depends on
+ *
+ * Used as key for the fit cache, so add all input histograms and settings
+ * which change the outcome of the fit.
+ */
+struct Hash_t {
+    std::uint64_t Value = 14695981039346656037ull; // FNV-1a offset basis
+
+    Hash_t& operator<<(const TH1& h);
+    Hash_t& operator<<(const std::string& s);
+    Hash_t& operator<<(const char* s) { return *this << std::string(s); }
+    Hash_t& operator<<(double v);
+    Hash_t& operator<<(long long v);
+    Hash_t& operator<<(int v) { return *this << static_cast<long long>(v); }
+    Hash_t& operator<<(unsigned v) { return *this << static_cast<long long>(v); }
+
+    std::string ToString() const;
+
+protected:
+    void add(const void* data, std::size_t size);
+};
+
+/**
+ * @brief The FitDriver class runs independent fits, for example of tagger channels, in parallel
+ *
+ * RooFit is not thread-safe, so every fit runs in its own forked worker process, which
+ * inherits the complete state (histograms, setup, RooFit settings) of the caller. The fit
+ * writes its results (RooFitResult, RooPlot, ...) into the provided directory, which is
+ * backed by a ROOT file read back by the caller. The results are returned in the order
+ * of the provided bins, independent of the order the workers finish.
+ *
+ * If a CacheDir is given, the result files are kept there named by the bin's hash,
+ * and bins with an unchanged hash are not fitted again. Clear the cache directory
+ * after changing the fit model itself.
+ */
+class FitDriver {
+public:
+    /**
+     * @brief fit_t runs the fit and writes everything needed later into output with WriteTObject.
+     * Runs in a worker process, so changes to global state are not visible to the caller.
+     */
+    using fit_t = std::function<void(TDirectory& output)>;
+
+    struct bin_t {
+        std::string Name; // for messages and result file names, should be unique
+        Hash_t Hash;
+        fit_t Fit;
+        bin_t(const std::string& name, const Hash_t& hash, fit_t fit) :
+            Name(name), Hash(hash), Fit(std::move(fit)) {}
+    };
+
+    /**
+     * @brief The result_t struct gives access to the objects written by a fit,
+     * they stay valid as long as a copy of this result exists
+     */
+    struct result_t {
+        std::string Name;
+        bool FromCache = false;
+
+        template<typename T>
+        T* Get(const std::string& name) const {
+            T* ptr = dynamic_cast<T*>(GetObject(name));
+            if(!ptr)
+                throw Exception("Object "+name+" of fit "+Name+" has unexpected type");
+            return ptr;
+        }
+
+    protected:
+        friend class FitDriver;
+        std::shared_ptr<TFile> file;
+        TObject* GetObject(const std::string& name) const;
+    };
+
+    explicit FitDriver(const std::string& cachedir = "");
+    ~FitDriver();
+
+    /**
+     * @brief Run the fits of all bins, or take them from the cache
+     * @param bins to be fitted
+     * @return the results in the order of bins
+     */
+    std::vector<result_t> Run(const std::vector<bin_t>& bins) const;
+
+    unsigned Workers = std::thread::hardware_concurrency(); // fits in-process if 1
+
+    struct Exception : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+protected:
+    const std::string cachedir;
+    std::unique_ptr<tmpfolder_t> tmpfolder; // used without cache
+    std::string resultfile(const bin_t& bin) const;
+};
+
+}}} // namespace ant::progs::fitdriver
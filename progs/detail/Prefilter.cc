@@ -0,0 +1,160 @@
+#include "Prefilter.h"
+
+#include "base/WrapTFile.h"
+#include "base/Logger.h"
+#include "base/std_ext/misc.h"
+#include "base/std_ext/string.h"
+
+#include "TTree.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TClonesArray.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "RVersion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+using namespace ant::progs::prefilter;
+
+Prefilter::Prefilter(const string& inputfile_, weight_t weight_) :
+    inputfile(inputfile_),
+    weight(move(weight_))
+{}
+
+Prefilter::result_t Prefilter::Run(WrapTFileOutput& output, const string& tmpprefix)
+{
+    long long nEntries = 0;
+    {
+        WrapTFileInput input(inputfile);
+        TTree* tree = nullptr;
+        if(!input.GetObject("data", tree))
+            throw Exception("\"data\" not found, make sure the provided file is a Pluto file");
+        nEntries = tree->GetEntries();
+    }
+    if(MaxEntries > 0)
+        nEntries = std::min(nEntries, MaxEntries);
+
+    if(Seed == 0) {
+        Seed = random_device()();
+        LOG(INFO) << "Using random seed " << Seed;
+    }
+
+    const long long nRanges = (nEntries + RangeSize - 1) / RangeSize;
+
+    // always have at least one worker, so that the output tree is created
+    unsigned nWorkers = std::max(1u, Threads);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    if(nWorkers>1)
+        ROOT::EnableThreadSafety();
+#else
+    LOG_IF(nWorkers>1, WARNING) << "Reading with multiple threads requires ROOT6, using one thread";
+    nWorkers = 1;
+#endif
+    nWorkers = unsigned(std::max(1ll, std::min<long long>(nWorkers, nRanges)));
+
+    LOG(INFO) << "Filtering " << nEntries << " entries in " << nRanges
+              << " ranges with " << nWorkers << " threads";
+
+    // worker i processes consecutive ranges, so concatenating the
+    // temporary files in worker order keeps the original order
+    vector<string> tmpfiles;
+    vector<future<result_t>> workers;
+    for(unsigned i=0;i<nWorkers;i++) {
+        tmpfiles.emplace_back(std_ext::formatter() << tmpprefix << ".prefilter" << i << ".root");
+        const auto firstRange = nRanges*i/nWorkers;
+        const auto stopRange = nRanges*(i+1)/nWorkers;
+        workers.emplace_back(async(launch::async, &Prefilter::Work, this,
+                                   firstRange, stopRange, nEntries, tmpfiles.back()));
+    }
+
+    std_ext::execute_on_destroy removeTmpFiles([&tmpfiles] () {
+        for(const auto& tmpfile : tmpfiles)
+            remove(tmpfile.c_str());
+    });
+
+    // wait for all workers before rethrowing
+    // any exceptions, the tmpfiles are still in use otherwise
+    for(auto& w : workers)
+        w.wait();
+
+    result_t result;
+    for(auto& w : workers) {
+        auto r = w.get();
+        result.Read += r.Read;
+        result.Accepted += r.Accepted;
+        result.Invalid += r.Invalid;
+    }
+
+    const auto prev_Directory = gDirectory;
+    std_ext::execute_on_destroy restoreDir([prev_Directory] () {
+        gDirectory = prev_Directory;
+    });
+
+    TChain chain("data");
+    for(const auto& tmpfile : tmpfiles)
+        chain.Add(tmpfile.c_str());
+
+    output.cd();
+    auto outtree = chain.CloneTree(0);
+    if(!outtree)
+        throw Exception("Cannot create output tree from temporary files");
+    outtree->CopyEntries(addressof(chain), -1, "fast");
+
+    return result;
+}
+
+Prefilter::result_t Prefilter::Work(long long firstRange, long long stopRange, long long nEntries,
+                                    const string& tmpfile) const
+{
+    // use plain TFiles here, as WrapTFile logs via the not thread-safe logger
+    unique_ptr<TFile> input(TFile::Open(inputfile.c_str(), "READ"));
+    TTree* intree = input ? dynamic_cast<TTree*>(input->Get("data")) : nullptr;
+    if(!intree)
+        throw Exception("Cannot read \"data\" tree from "+inputfile);
+
+    TClonesArray* buffer = nullptr;
+    intree->SetBranchAddress("Particles", &buffer);
+
+    unique_ptr<TFile> output(TFile::Open(tmpfile.c_str(), "RECREATE"));
+    if(!output || output->IsZombie())
+        throw Exception("Cannot create temporary file "+tmpfile);
+    output->cd();
+    auto outtree = new TTree("data", "");
+    outtree->Branch("Particles", buffer);
+
+    result_t result;
+    for(long long range = firstRange; range < stopRange; ++range) {
+        // seed per range, such that the result is independent of the number of workers
+        TRandom3 rng(Seed + unsigned(range));
+
+        const auto stop = std::min((range+1)*RangeSize, nEntries);
+        for(long long entry = range*RangeSize; entry < stop; ++entry) {
+            intree->GetEntry(entry);
+            ++result.Read;
+
+            const auto w = weight(*buffer);
+            if(!isfinite(w)) {
+                ++result.Invalid;
+                continue;
+            }
+
+            if(w >= 1.0 || rng.Uniform(0.0, 1.0) <= w) {
+                outtree->Fill();
+                ++result.Accepted;
+            }
+        }
+    }
+
+    output->Write();
+    output->Close();
+    return result;
+}
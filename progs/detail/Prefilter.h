@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+class TClonesArray;
+
+namespace ant {
+
+class WrapTFileOutput;
+
+namespace progs {
+namespace prefilter {
+
+/**
+ * @brief The Prefilter class applies rejection sampling to the "data" tree of a Pluto file
+ *
+ * The entries are split into ranges of RangeSize, each range has its own random number
+ * generator seeded from Seed and the range index. Consecutive ranges are distributed over
+ * Threads workers, which read the input on their own and write the accepted entries
+ * to a temporary file each. Those are finally merged in original order by copying the
+ * compressed baskets. The result does not depend on the number of threads.
+ */
+class Prefilter {
+public:
+    /**
+     * @brief weight_t returns the acceptance probability for the particles of an entry,
+     * NaN if the entry lacks the required particles. Called concurrently from all workers.
+     */
+    using weight_t = std::function<double(const TClonesArray& particles)>;
+
+    struct result_t {
+        long long Read = 0;
+        long long Accepted = 0;
+        long long Invalid = 0; // weight was NaN, entry was not written
+    };
+
+    Prefilter(const std::string& inputfile, weight_t weight);
+
+    /**
+     * @brief Run the rejection sampling
+     * @param output file to write the "data" tree into
+     * @param tmpprefix temporary files are named with this prefix, usually the output filename
+     * @return counters of all workers
+     */
+    result_t Run(WrapTFileOutput& output, const std::string& tmpprefix);
+
+    unsigned Threads = std::thread::hardware_concurrency();
+    long long RangeSize = 1000000;
+    unsigned Seed = 0;          // picks some random seed if 0
+    long long MaxEntries = 0;   // read all entries if 0
+
+    struct Exception : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+protected:
+    const std::string inputfile;
+    const weight_t weight;
+
+    result_t Work(long long firstRange, long long stopRange, long long nEntries,
+                  const std::string& tmpfile) const;
+};
+
+}}} // namespace ant::progs::prefilter
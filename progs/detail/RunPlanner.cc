@@ -0,0 +1,131 @@
+#include "RunPlanner.h"
+
+#include "base/Logger.h"
+#include "base/std_ext/string.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace std;
+using namespace ant;
+using namespace ant::progs::run;
+
+string ant::progs::run::quote(const string& s) {
+    string quoted = "'";
+    for(auto c : s) {
+        if(c == '\'')
+            quoted += "'\\''";
+        else
+            quoted += c;
+    }
+    return quoted + "'";
+}
+
+Planner::Planner(const vector<string>& inputfiles,
+                 const string& mapcmd, const string& haddcmd_,
+                 const string& workdir_, unsigned fanin_, unsigned retries_) :
+    haddcmd(haddcmd_),
+    workdir(workdir_),
+    fanin(max(2u, fanin_)),
+    retries(retries_)
+{
+    if(mapcmd.empty()) {
+        mergeable = inputfiles;
+    }
+    else {
+        for(size_t i=0;i<inputfiles.size();i++) {
+            const string name = std_ext::formatter() << "Map_" << i;
+            queue.emplace_back(job_t::type_t::Map, name, vector<string>{inputfiles[i]},
+                               workdir + "/" + name + ".root");
+            auto& job = queue.back();
+            job.Cmd = std_ext::replace_str(std_ext::replace_str(mapcmd, "{input}", quote(job.Inputs.front())),
+                                           "{output}", quote(job.Output));
+        }
+    }
+    nMaps = queue.size();
+    mapsLeft = nMaps;
+    planMerges();
+}
+
+void Planner::planMerges()
+{
+    // merge as soon as enough outputs are there, or everything left when all maps are done
+    while(mergeable.size() >= fanin || (mapsLeft == 0 && mergeable.size() >= 2)) {
+        const auto n = min<size_t>(fanin, mergeable.size());
+        vector<string> inputs(mergeable.begin(), next(mergeable.begin(), n));
+        mergeable.erase(mergeable.begin(), next(mergeable.begin(), n));
+        const string name = std_ext::formatter() << "Merge_" << nMerges++;
+        // merge jobs go first, they free disk space and are needed for the final output
+        queue.emplace_front(job_t::type_t::Merge, name, inputs, workdir + "/" + name + ".root");
+        auto& job = queue.front();
+        job.Cmd = haddcmd + " " + quote(job.Output);
+        for(const auto& input : job.Inputs)
+            job.Cmd += " " + quote(input);
+        mergesLeft++;
+    }
+}
+
+job_t Planner::Next()
+{
+    auto job = move(queue.front());
+    queue.pop_front();
+    created.insert(job.Output);
+    created.insert(LogFile(job));
+    return job;
+}
+
+vector<string> Planner::Finished(job_t job, bool success, bool retry)
+{
+    vector<string> removable;
+
+    if(!success) {
+        if(job.Attempts < retries && retry) {
+            job.Attempts++;
+            LOG(WARNING) << "Job " << job.Name << " failed, retry " << job.Attempts
+                         << ", see " << LogFile(job);
+            queue.emplace_back(move(job));
+            return removable;
+        }
+        if(job.Type == job_t::type_t::Merge) {
+            LOG(ERROR) << "Merge job " << job.Name << " failed, see " << LogFile(job);
+            mergeFailed = true;
+            return removable;
+        }
+        LOG(ERROR) << "Job " << job.Name << " for " << job.Inputs.front() << " failed, see "
+                   << LogFile(job);
+        failed.emplace_back(job.Inputs.front());
+        mapsLeft--;
+        planMerges();
+        return removable;
+    }
+
+    intermediate.insert(job.Output);
+    mergeable.emplace_back(job.Output);
+
+    if(job.Type == job_t::type_t::Map) {
+        mapsLeft--;
+        LOG(INFO) << "Finished " << nMaps - mapsLeft << "/" << nMaps << " files";
+    }
+    else {
+        mergesLeft--;
+        for(const auto& input : job.Inputs) {
+            if(intermediate.erase(input))
+                removable.emplace_back(input);
+        }
+    }
+
+    planMerges();
+    return removable;
+}
+
+string Planner::Result() const
+{
+    if(!Done() || mergeFailed || mergeable.empty())
+        return "";
+    return mergeable.front();
+}
+
+string Planner::LogFile(const job_t& job) const
+{
+    return workdir + "/" + job.Name + ".log";
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ant {
+namespace progs {
+namespace run {
+
+struct job_t {
+    enum class type_t { Map, Merge };
+
+    type_t Type;
+    std::string Name;
+    std::vector<std::string> Inputs;
+    std::string Output;
+    std::string Cmd;
+    unsigned Attempts = 0;
+
+    job_t(type_t type, const std::string& name, const std::vector<std::string>& inputs, const std::string& output) :
+        Type(type), Name(name), Inputs(inputs), Output(output) {}
+};
+
+/**
+ * @brief quote a string for use as a single shell word
+ */
+std::string quote(const std::string& s);
+
+/**
+ * @brief The Planner class decides which map and merge jobs Ant-run runs
+ *
+ * Every input file gets a map job, if a command template is given. Finished outputs are
+ * merged in groups of FanIn by merge jobs, which are queued first as they free disk space.
+ * The caller runs the jobs handed out by Next() and reports back with Finished(), until
+ * Done() is true and Result() names the merged output.
+ */
+class Planner {
+public:
+    /**
+     * @param inputfiles in the order they should be processed
+     * @param mapcmd command template with {input} and {output}, only merges the inputs if empty
+     * @param haddcmd called with the output and the inputs to merge
+     * @param workdir folder for the outputs and logs of the jobs
+     * @param fanin number of files merged by one merge job
+     * @param retries number of times a failed job is queued again
+     */
+    Planner(const std::vector<std::string>& inputfiles,
+            const std::string& mapcmd, const std::string& haddcmd,
+            const std::string& workdir, unsigned fanin, unsigned retries);
+
+    /**
+     * @brief HasNext tells if a job is queued, if not some may be still running
+     */
+    bool HasNext() const { return !queue.empty() && !Done(); }
+
+    /**
+     * @brief Next pops the next queued job, only call if HasNext
+     */
+    job_t Next();
+
+    /**
+     * @brief Finished processes the outcome of a job handed out by Next
+     * @param retry allow to queue the job again if it failed
+     * @return intermediate files which have been merged and can be removed
+     */
+    std::vector<std::string> Finished(job_t job, bool success, bool retry = true);
+
+    bool Done() const { return mergeFailed || (mapsLeft == 0 && mergesLeft == 0); }
+
+    std::size_t Maps() const { return nMaps; }
+    bool MergeFailed() const { return mergeFailed; }
+    const std::vector<std::string>& Failed() const { return failed; }
+
+    /**
+     * @brief Result is the merged output once Done, empty if nothing was produced
+     */
+    std::string Result() const;
+
+    /**
+     * @brief IsIntermediate tells if the file was produced by a job
+     */
+    bool IsIntermediate(const std::string& filename) const { return intermediate.count(filename) > 0; }
+
+    /**
+     * @brief Created lists the outputs and logs of all jobs handed out so far,
+     * which are the only files in the workdir Ant-run may remove
+     */
+    const std::set<std::string>& Created() const { return created; }
+
+    std::string LogFile(const job_t& job) const;
+
+protected:
+    const std::string haddcmd;
+    const std::string workdir;
+    const unsigned fanin;
+    const unsigned retries;
+
+    std::deque<job_t> queue;
+    std::vector<std::string> mergeable;  // outputs ready to be merged
+    std::set<std::string> intermediate;  // files owned by us, deleted after merging
+    std::set<std::string> created;
+    std::vector<std::string> failed;
+
+    std::size_t nMaps = 0;
+    std::size_t mapsLeft = 0;   // queued or running
+    std::size_t mergesLeft = 0; // queued or running
+    unsigned nMerges = 0;
+    bool mergeFailed = false;
+
+    void planMerges();
+};
+
+}}} // namespace ant::progs::run
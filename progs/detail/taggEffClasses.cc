@@ -6,6 +6,7 @@
 #include "base/Logger.h"
 #include "base/interval.h"
 #include "base/PlotExt.h"
+#include "base/std_ext/misc.h"
 
 #include "expconfig/detectors/EPT.h"
 
@@ -15,6 +16,11 @@
 
 #include "tools.h"
 
+#include "Math/MinimizerOptions.h"
+
+#include <algorithm>
+#include <future>
+
 using namespace ant;
 using namespace std;
 using namespace ant::analysis;
@@ -128,7 +134,43 @@ TID taggEffTriple_t::extractStartID(const string& f)
     return header->LastID;
 }
 
-void taggEffTriple_t::initBkgFits()
+namespace {
+
+// runs f(i) for i in [0,n), distributed over the given number of threads,
+// waits for all threads before rethrowing any exception.
+// ROOT's messages from the workers, for example of the fits, are logged afterwards by the calling thread
+template<typename Func>
+void runParallel(size_t n, unsigned threads, Func f) {
+    threads = unsigned(std::max<size_t>(1, std::min<size_t>(threads, n)));
+    if(threads == 1) {
+        for(size_t i=0;i<n;i++)
+            f(i);
+        return;
+    }
+    using messages_t = vector<logger::ROOTMessages::message_t>;
+    vector<messages_t> messages(threads);
+    vector<future<void>> workers;
+    for(unsigned t=0;t<threads;t++) {
+        workers.emplace_back(async(launch::async, [n, threads, t, &f, &messages] () {
+            logger::ROOTMessages root_messages;
+            std_ext::execute_on_destroy keep_messages([&messages, &root_messages, t] () {
+                messages[t] = move(root_messages.Messages);
+            });
+            for(size_t i=t;i<n;i+=threads)
+                f(i);
+        }));
+    }
+    for(auto& w : workers)
+        w.wait();
+    for(const auto& m : messages)
+        logger::ROOTMessages::Log(m);
+    for(auto& w : workers)
+        w.get();
+}
+
+}
+
+void taggEffTriple_t::initBkgFits(unsigned threads)
 {
     AvgBkgRates = timedData::getRatesVsTime({addressof(Bkg1),addressof(Bkg2)},HistFac);
     double dummy(0);
@@ -141,16 +183,25 @@ void taggEffTriple_t::initBkgFits()
         AvgBkgFit->SetParLimits(i,0,upperlimit);
 
     AvgBkgRates->Fit(AvgBkgFit,"Q");
+
+    // creating the graphs and fit functions is not thread-safe
+    const auto graphs = timedData::getChannelRatesVsTime({addressof(Bkg1),addressof(Bkg2)},HistFac);
     for ( auto ch = 0u ; ch < Run.nchannels ; ++ch)
-    {
-        auto graph = timedData::getRatesVsTime({addressof(Bkg1),addressof(Bkg2)},ch,HistFac);
-        bkgFits.emplace_back(bkgFit_t(graph,ch));
-        bkgFits.back().doFit(IntervalD(0,tmax),AvgBkgFit->GetParameter(2));
+        bkgFits.emplace_back(graphs.at(ch),ch,IntervalD(0,tmax),AvgBkgFit->GetParameter(2));
+
+    if(threads > 1 && ROOT::Math::MinimizerOptions::DefaultMinimizerType() != "Minuit2") {
+        LOG(WARNING) << "Default minimizer is not thread-safe, fitting channels with one thread";
+        threads = 1;
     }
+
+    // each channel has its own graph and function, results stay in channel order
+    runParallel(bkgFits.size(), threads, [this] (size_t ch) {
+        bkgFits[ch].doFit();
+    });
 }
 
 taggEffTriple_t::taggEffTriple_t(const string& bkg1f, const string& runf, const string& bkg2f,
-                                 const HistogramFactory& histfac):
+                                 const HistogramFactory& histfac, unsigned threads):
     startID(extractStartID(bkg2f)),
     HistFac(std_ext::to_iso8601(startID.Timestamp),histfac),
     Bkg1(bkg1f),
@@ -167,9 +218,9 @@ taggEffTriple_t::taggEffTriple_t(const string& bkg1f, const string& runf, const
         throw runtime_error("Files in TaggEff-triple not from same Setup!");
 
 
-    sanityChecks();
+    sanityChecks(threads);
 
-    initBkgFits();
+    initBkgFits(threads);
 
     avgRatesSub = HistFac.makeGraph("","runBkgSub");
     avgRatesSub->SetMarkerColor(kRed);
@@ -178,17 +229,23 @@ taggEffTriple_t::taggEffTriple_t(const string& bkg1f, const string& runf, const
     avgRates->SetMarkerColor(kGray);
 }
 
-void taggEffTriple_t::sanityChecks() const
+void taggEffTriple_t::sanityChecks(unsigned threads) const
 {
+    // the files are independent, so read them concurrently
+    const treeLoader_t* loaders[] = {addressof(Bkg1), addressof(Run), addressof(Bkg2)};
+    treeLoader_t::means_t means[3];
+    runParallel(3, threads, [&loaders, &means] (size_t i) {
+        means[i] = loaders[i]->getMeans();
+    });
 
-    auto bkg1 = Bkg1.getMeans();
-    auto run  = Run.getMeans();
-    auto bkg2 = Bkg2.getMeans();
+    const auto& bkg1 = means[0];
+    const auto& run  = means[1];
+    const auto& bkg2 = means[2];
 
     auto nchannels = bkg1.Scalers.size();
 
     // per file checks:
-    for ( auto m: {bkg1, run, bkg2})
+    for ( const auto& m: means)
     {
         for (auto ch = 0u ; ch < nchannels ; ++ch)
         {
@@ -288,16 +345,15 @@ double taggEffTriple_t::GetDecayConstant() const
 
 
 
-taggEffTriple_t::bkgFit_t::bkgFit_t(TGraph* graph, const size_t channel): Graph(graph)
+taggEffTriple_t::bkgFit_t::bkgFit_t(TGraph* graph, const size_t channel,
+                                     const IntervalD& fitrange, const double lambda):
+    Graph(graph)
 {
-    string name = std_ext::formatter() << "channel" << channel;
+    string title = std_ext::formatter() << "channel" << channel;
     Graph->SetMarkerStyle(kPlus);
     Graph->SetMarkerColor(kBlue);
-    Graph->SetTitle(name.c_str());
-}
+    Graph->SetTitle(title.c_str());
 
-void taggEffTriple_t::bkgFit_t::doFit(const IntervalD& fitrange, const double lambda)
-{
     string name = std_ext::formatter() << Graph->GetTitle() << "fit" ;
     string fitFkt = std_ext::formatter() << "[0] + [1] * exp( - " << lambda << " * x)";
     Fit   = new TF1(name.c_str(),fitFkt.c_str(),
@@ -307,7 +363,10 @@ void taggEffTriple_t::bkgFit_t::doFit(const IntervalD& fitrange, const double la
         Fit->SetParameter(i,startparams[i]);
         Fit->SetParLimits(i,0,upperlimit);
     }
+}
 
+void taggEffTriple_t::bkgFit_t::doFit()
+{
     Graph->Fit(Fit,"Q");
 }
 
@@ -355,6 +414,32 @@ TGraph* timedData::getRatesVsTime(const std::list<treeLoader_t*>& tContainers, c
     return graph2d;
 }
 
+vector<TGraph*> timedData::getChannelRatesVsTime(const std::list<treeLoader_t*>& tContainers, const HistogramFactory& histfac)
+{
+    vector<TGraph*> graphs;
+    if(tContainers.empty())
+        return graphs;
+
+    for ( auto channel = 0u ; channel < tContainers.front()->nchannels ; ++channel)
+    {
+        auto graph2d = histfac.makeGraph("",std_ext::formatter() << "ch" << channel << "Bkg");
+
+        graph2d->SetMarkerStyle(kPlus);
+        graph2d->GetXaxis()->SetTitle("time [s]");
+        graph2d->GetYaxis()->SetTitle("avg. rate [Hz]");
+        graphs.emplace_back(graph2d);
+    }
+
+    auto f = [&graphs] (treeLoader_t* t, double evTime) {
+        const auto& rates = t->wrapTree.TaggRates();
+        for ( auto channel = 0u ; channel < graphs.size() ; ++channel)
+            GraphExt::FillGraph(graphs[channel],evTime,rates.at(channel));
+    };
+
+    runOverContainer(tContainers, f);
+    return graphs;
+}
+
 TGraph* timedData::getLtVsTime(const std::list<treeLoader_t*>& tContainers, const HistogramFactory& histfac)
 {
     auto graph = histfac.makeGraph("");
@@ -25,6 +25,8 @@ struct timedData
 {
     static TGraph* getRatesVsTime(const std::list<treeLoader_t*>& tContainers, const analysis::HistogramFactory& histfac);
     static TGraph* getRatesVsTime(const std::list<treeLoader_t*>& tContainers, const size_t channel, const analysis::HistogramFactory& histfac);
+    /// same as getRatesVsTime for each channel, but reads the trees only once
+    static std::vector<TGraph*> getChannelRatesVsTime(const std::list<treeLoader_t*>& tContainers, const analysis::HistogramFactory& histfac);
     static TGraph* getLtVsTime(const std::list<treeLoader_t*>& tContainers, const analysis::HistogramFactory& histfac);
 };
 
@@ -90,7 +92,7 @@ protected:
 
 
 
-    void initBkgFits();
+    void initBkgFits(unsigned threads);
 
 public:
 
@@ -102,9 +104,10 @@ public:
         TGraph* Graph;
         TF1*    Fit;
 
-        bkgFit_t(TGraph* graph, const size_t channel);
+        bkgFit_t(TGraph* graph, const size_t channel, const IntervalD& fitrange, const double lambda);
 
-        void doFit(const IntervalD& fitrange, const double lambda);
+        /// only touches Graph and Fit, so different channels can be fitted concurrently with Minuit2
+        void doFit();
         double operator ()(const double time)  const;
     };
     std::vector<bkgFit_t> bkgFits;
@@ -112,12 +115,17 @@ public:
     TGraph* avgRatesSub = nullptr;
     TGraph* avgRates    = nullptr;
 
+    /**
+     * @brief taggEffTriple_t loads the files and fits the background of each channel
+     * @param threads number of threads reading the files and fitting the channels,
+     * more than one requires ROOT::EnableThreadSafety() and Minuit2 as default minimizer
+     */
     taggEffTriple_t(const std::string& bkg1f, const std::string& runf, const std::string& bkg2f,
-                    const analysis::HistogramFactory& histfac);
+                    const analysis::HistogramFactory& histfac, unsigned threads = 1);
 
     std::string SetupName() const{return Bkg1.setupName;}
 
-    void sanityChecks() const;
+    void sanityChecks(unsigned threads = 1) const;
 
     const taggEff_t  GetTaggEffSubtracted() const;
 
@@ -3,6 +3,8 @@
 #include "event_t.h"
 #include "reader_flags_t.h"
 
+#include "base/Shard.h"
+
 namespace ant {
 namespace analysis {
 namespace input {
@@ -30,6 +32,15 @@ public:
     virtual bool ReadNextEvent(event_t& event) =0;
 
     virtual double PercentDone() const =0;
+
+    /**
+     * @brief SetShard restricts reading to the given part of the input
+     * @param shard the part to be read
+     * @return false if the reader cannot be sharded
+     *
+     * Readers without any input should simply return true.
+     */
+    virtual bool SetShard(const Shard&) { return false; }
 };
 
 }}} // namespace ant::analysis::input
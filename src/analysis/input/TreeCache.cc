@@ -0,0 +1,88 @@
+#include "TreeCache.h"
+
+#include "base/Logger.h"
+
+#include "TTree.h"
+#include "TFile.h"
+#include "TTreeCache.h"
+#include "TEnv.h"
+
+#include <iomanip>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::input;
+
+long long TreeCache::CacheSize = 64 << 20;
+bool TreeCache::Prefetch = true;
+
+TreeCache::TreeCache() :
+    progress([this] (std::chrono::duration<double> elapsed) {
+        Update(elapsed.count());
+    })
+{}
+
+TreeCache::~TreeCache() {}
+
+void TreeCache::AddTree(TTree& tree, const vector<string>& branches)
+{
+    // ROOT checks for asynchronous prefetching when creating the cache
+    if(Prefetch)
+        gEnv->SetValue("TFile.AsyncPrefetching", 1);
+
+    tree.SetCacheSize(CacheSize);
+    if(branches.empty()) {
+        tree.AddBranchToCache("*", true);
+    }
+    else {
+        tree.SetBranchStatus("*", false);
+        for(const auto& branch : branches) {
+            tree.SetBranchStatus(branch.c_str(), true);
+            tree.AddBranchToCache(branch.c_str(), true);
+        }
+    }
+    // we know the branches already, no need to learn them from the first entries
+    tree.StopCacheLearningPhase();
+
+    trees.push_back(addressof(tree));
+    auto file = tree.GetCurrentFile();
+    if(file)
+        last_bytesRead.emplace(file, file->GetBytesRead());
+
+    VLOG(5) << "Enabled read cache for tree " << tree.GetName() << " with "
+            << (branches.empty() ? string("all") : to_string(branches.size())) << " branches";
+}
+
+void TreeCache::SetEntryRange(long long first, long long stop)
+{
+    for(auto tree : trees)
+        tree->SetCacheEntryRange(first, stop);
+}
+
+void TreeCache::Update(double elapsed_seconds)
+{
+    if(trees.empty())
+        return;
+
+    long long bytesRead = 0;
+    for(auto& it : last_bytesRead) {
+        const auto total = it.first->GetBytesRead();
+        bytesRead += total - it.second;
+        it.second = total;
+    }
+
+    double efficiency = 0;
+    unsigned n = 0;
+    for(auto tree : trees) {
+        auto cache = dynamic_cast<TTreeCache*>(tree->GetReadCache(tree->GetCurrentFile()));
+        if(!cache)
+            continue;
+        efficiency += cache->GetEfficiencyRel();
+        n++;
+    }
+
+    LOG(INFO) << "Reading trees with "
+              << std::fixed << setprecision(3) << bytesRead/elapsed_seconds/(1<<20)
+              << " MB/s, cache hit rate "
+              << std::fixed << setprecision(1) << (n>0 ? 100*efficiency/n : 0.0) << " %";
+}
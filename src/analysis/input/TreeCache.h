@@ -0,0 +1,65 @@
+#pragma once
+
+#include "base/ProgressCounter.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+class TTree;
+class TFile;
+
+namespace ant {
+namespace analysis {
+namespace input {
+
+/**
+ * @brief The TreeCache class tunes sequential reading of TTrees
+ *
+ * Reading from network filesystems is dominated by latency, so the TTreeCache
+ * is sized to CacheSize and filled with the used branches right away, skipping
+ * its learning phase. All other branches are disabled.
+ * If Prefetch is enabled, ROOT reads the next baskets asynchronously in a helper thread.
+ * The read rate and cache hit rate are reported via ProgressCounter.
+ */
+class TreeCache {
+public:
+
+    TreeCache();
+    ~TreeCache();
+
+    /**
+     * @brief AddTree enables the cache for the given tree
+     * @param tree the tree to be read
+     * @param branches full names of the branches to be read, all branches if empty
+     */
+    void AddTree(TTree& tree, const std::vector<std::string>& branches = {});
+
+    /**
+     * @brief SetEntryRange restricts prefetching to the entries which will be read
+     * @param first first entry
+     * @param stop entry after the last one
+     */
+    void SetEntryRange(long long first, long long stop);
+
+    /**
+     * @brief CacheSize of the TTreeCache in bytes for each tree
+     */
+    static long long CacheSize;
+
+    /**
+     * @brief Prefetch baskets asynchronously, applies to caches of trees added afterwards
+     */
+    static bool Prefetch;
+
+private:
+    std::vector<TTree*> trees;
+
+    // bytes read per file, since files might be shared among trees
+    std::map<TFile*, long long> last_bytesRead;
+    ProgressCounter progress;
+
+    void Update(double elapsed_seconds);
+};
+
+}}} // namespace ant::analysis::input
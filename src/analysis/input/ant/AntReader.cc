@@ -6,11 +6,14 @@
 #include "base/Logger.h"
 #include "base/WrapTTree.h"
 #include "input/treeEvents_t.h"
+#include "input/TreeCache.h"
 
 #include "TTree.h"
+#include "TBranch.h"
 
 #include <memory>
 #include <stdexcept>
+#include <deque>
 
 using namespace std;
 using namespace ant;
@@ -25,6 +28,7 @@ struct AntReaderInternal {
     virtual double PercentDone() const = 0;
     virtual event_t NextEvent() = 0;
     virtual bool ProvidesSlowControl() const = 0;
+    virtual bool SetShard(const Shard& shard) = 0;
     virtual ~AntReaderInternal() = default;
 };
 
@@ -44,6 +48,9 @@ struct UnpackerReader : AntReaderInternal {
     virtual bool ProvidesSlowControl() const override {
         return unpacker->ProvidesSlowControl();
     }
+    virtual bool SetShard(const Shard& shard) override {
+        return unpacker->SetShard(shard);
+    }
 private:
     unique_ptr<Unpacker::Module> unpacker;
 }; // UnpackerReader
@@ -62,8 +69,10 @@ struct TreeReader : AntReaderInternal {
     virtual ~TreeReader() = default;
 
     virtual double PercentDone() const override {
-        if(tree)
-            return double(current_entry)/double(tree.Tree->GetEntries());
+        if(tree) {
+            const auto entries = stop_entry < 0 ? tree.Tree->GetEntries() : stop_entry - first_entry;
+            return std::min(double(current_entry - first_entry)/double(entries), 1.0);
+        }
         return numeric_limits<double>::quiet_NaN();
     }
 
@@ -71,12 +80,80 @@ struct TreeReader : AntReaderInternal {
         if(!tree)
             return {};
 
+        // enable the cache only now, as setting the shard might read backwards
+        if(!cache_enabled) {
+            cache.AddTree(*tree.Tree, tree.GetLinkedBranchNames());
+            cache.SetEntryRange(current_entry, stop_entry < 0 ? tree.Tree->GetEntries() : stop_entry);
+            cache_enabled = true;
+        }
+
+        if(!leadin_entries.empty()) {
+            tree.Tree->GetEntry(leadin_entries.front());
+            leadin_entries.pop_front();
+            event_t event{move(tree.data())};
+            event.ShardOverlap = Shard::Overlap_t::LeadIn;
+            return event;
+        }
+
         if(current_entry==tree.Tree->GetEntries())
             return {};
 
         tree.Tree->GetEntry(current_entry);
+        event_t event{move(tree.data())};
+        if(stop_entry >= 0 && current_entry >= stop_entry)
+            event.ShardOverlap = Shard::Overlap_t::LeadOut;
         current_entry++;
-        return event_t{move(tree.data())};
+        return event;
+    }
+
+    virtual bool SetShard(const Shard& shard) override {
+        if(!tree)
+            return true;
+
+        const auto range = shard.GetRange(tree.Tree->GetEntries());
+        first_entry = range.Start();
+        stop_entry = range.Stop();
+        current_entry = first_entry;
+
+        // the slowcontrol processors need the last item with backward validity (such as Acqu scalers)
+        // before the shard start, and the last one with forward validity (such as tagging efficiencies),
+        // both might be far away or missing (such as for MC), so limit the search for them
+        constexpr Long64_t maxScan = 100000;
+        Long64_t backward_entry = -1;
+        Long64_t forward_entry = -1;
+        // only read the small slowcontrol flags if present, and not the complete events
+        TBranch* flags_branch = tree.slowcontrols.IsPresent ?
+                                    tree.Tree->GetBranch(tree.slowcontrols.Name.c_str()) : nullptr;
+        for(Long64_t entry = first_entry-1; entry >= 0 && first_entry - entry <= maxScan; --entry) {
+            std::uint8_t flags = 0;
+            if(flags_branch) {
+                flags_branch->GetEntry(entry);
+                flags = tree.slowcontrols;
+            }
+            else {
+                tree.Tree->GetEntry(entry);
+                flags = treeEvents_t::GetSlowControlFlags(event_t{move(tree.data())});
+            }
+            if(backward_entry < 0 && (flags & treeEvents_t::Backward))
+                backward_entry = entry;
+            if(forward_entry < 0 && (flags & treeEvents_t::Forward))
+                forward_entry = entry;
+            if(backward_entry >= 0 && forward_entry >= 0)
+                break;
+        }
+        // without any backward item, the events before the shard are not needed,
+        // otherwise all entries since the last backward item are needed as well
+        leadin_entries.clear();
+        if(backward_entry >= 0) {
+            if(forward_entry >= 0 && forward_entry < backward_entry)
+                leadin_entries.push_back(forward_entry);
+            for(Long64_t entry = backward_entry; entry < first_entry; ++entry)
+                leadin_entries.push_back(entry);
+        }
+
+        LOG(INFO) << "Reading shard " << shard << " with entries " << first_entry << " to " << stop_entry
+                  << " (" << leadin_entries.size() << " lead-in entries)";
+        return true;
     }
 
     virtual bool ProvidesSlowControl() const override {
@@ -88,8 +165,13 @@ struct TreeReader : AntReaderInternal {
 
 private:
     Long64_t current_entry = 0;
+    Long64_t first_entry = 0;
+    Long64_t stop_entry = -1; // negative if not sharded
+    std::deque<Long64_t> leadin_entries;
 
     treeEvents_t tree;
+    TreeCache cache;
+    bool cache_enabled = false;
 }; // TreeReader
 
 }}}} // namespace ant::analysis::input::detail
@@ -129,6 +211,13 @@ reader_flags_t AntReader::GetFlags() const {
         return {};
 }
 
+bool AntReader::SetShard(const Shard& shard)
+{
+    if(reader)
+        return reader->SetShard(shard);
+    return true;
+}
+
 double AntReader::PercentDone() const
 {
     if(reader)
@@ -145,7 +234,8 @@ bool AntReader::ReadNextEvent(event_t& event)
     auto nextevent = reader->NextEvent();
 
     if(nextevent) {
-        if(reconstruct) {
+        // events outside the shard are only needed for their slowcontrol information
+        if(reconstruct && nextevent.ShardOverlap == Shard::Overlap_t::None) {
             TEventData& recon = nextevent.Reconstructed();
             /// \todo improve check if TEvent was run through reconstructed
             /// you may also introduce some flag to force application?
@@ -36,6 +36,8 @@ public:
     virtual bool ReadNextEvent(event_t& event) override;
 
     double PercentDone() const override;
+
+    virtual bool SetShard(const Shard& shard) override;
 };
 
 }
@@ -1,19 +1,20 @@
 #include "event_t.h"
 
 #include "tree/TEventData.h"
-#include "base/std_ext/memory.h"
 
 using namespace ant;
 using namespace ant::analysis::input;
 
 void event_t::MakeReconstructed(const TID& id_reconstructed)
 {
-    reconstructed = std_ext::make_unique<TEventData>(id_reconstructed);
+    RecycleEventData(reconstructed);
+    reconstructed = MakeEventData(id_reconstructed);
 }
 
 void event_t::MakeMCTrue(const TID& id_mctrue)
 {
-    mctrue = std_ext::make_unique<TEventData>(id_mctrue);
+    RecycleEventData(mctrue);
+    mctrue = MakeEventData(id_mctrue);
 }
 
 void event_t::MakeReconstructedMCTrue(const TID& id_reconstructed, const TID& id_mctrue)
@@ -45,11 +46,11 @@ void event_t::EnsureTempBranches()
 void event_t::ClearTempBranches()
 {
     if(empty_reconstructed) {
-        reconstructed = nullptr;
+        RecycleEventData(reconstructed);
         empty_reconstructed = false;
     }
     if(empty_mctrue) {
-        mctrue = nullptr;
+        RecycleEventData(mctrue);
         empty_mctrue = false;
     }
 }
@@ -13,6 +13,8 @@
 #include "TTree.h"
 
 #include <string>
+#include <map>
+#include <vector>
 
 
 using namespace ant;
@@ -26,6 +28,7 @@ bool operator<(const reference_wrapper<TTree>& t1, const reference_wrapper<TTree
 
 GoatReader::GoatReader(const std::shared_ptr<const WrapTFileInput>& rootfiles) :
     current_entry(0),
+    first_entry(0),
     max_entries(0),
     init(true)
 {
@@ -63,6 +66,27 @@ GoatReader::GoatReader(const std::shared_ptr<const WrapTFileInput>& rootfiles) :
     // as all trees have same number of entries, max_entries is given by front element
     max_entries = trees.begin()->get().GetEntries();
 
+    // read only the branches we actually copy, note that
+    // several wrappers might share the same tree
+    {
+        map<TTree*, vector<string>> branches;
+        auto add_branches = [&branches] (const WrapTTree& wraptree) {
+            auto names = wraptree.GetLinkedBranchNames();
+            auto& b = branches[wraptree.Tree];
+            b.insert(b.end(), names.begin(), names.end());
+        };
+        const auto& d = treeDetectorHitInput;
+        for(const WrapTTree& wraptree : initializer_list<reference_wrapper<const WrapTTree>>{
+            d.NaI, d.PID, d.MWPC, d.BaF2, d.Veto,
+            treeTaggerInput.t,
+            treeTriggerInput.t, treeTriggerInput.tEventParams,
+            treeTrackInput.t})
+            add_branches(wraptree);
+        for(const auto& it : branches)
+            cache.AddTree(*it.first, it.second);
+        cache.SetEntryRange(0, max_entries);
+    }
+
     LOG(INFO) << "Successfully opened GoAT file with " << max_entries << " entries";
 }
 
@@ -108,7 +132,18 @@ bool GoatReader::ReadNextEvent(event_t& event)
 
 double GoatReader::PercentDone() const
 {
-    return double(current_entry)/double(max_entries);
+    return double(current_entry-first_entry)/double(max_entries-first_entry);
+}
+
+bool GoatReader::SetShard(const Shard& shard)
+{
+    // GoAT files do not provide slowcontrol, so simply split the entries
+    const auto range = shard.GetRange(max_entries);
+    first_entry = range.Start();
+    current_entry = first_entry;
+    max_entries = range.Stop();
+    cache.SetEntryRange(first_entry, max_entries);
+    return true;
 }
 
 bool GoatReader::treeDetectorHitInput_t::LinkBranches(const WrapTFileInput& input, trees_t& trees)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "analysis/input/DataReader.h"
+#include "analysis/input/TreeCache.h"
 
 #include "base/WrapTTree.h"
 #include "base/types.h"
@@ -135,7 +136,9 @@ protected:
     }
 
     trees_t trees;
+    TreeCache cache;
     long long current_entry;
+    long long first_entry;
     long long max_entries;
     bool init;
 
@@ -147,6 +150,8 @@ public:
     virtual bool ReadNextEvent(event_t& event) override;
 
     double PercentDone() const override;
+
+    virtual bool SetShard(const Shard& shard) override;
 };
 
 }
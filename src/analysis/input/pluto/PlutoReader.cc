@@ -17,6 +17,7 @@
 #include "base/Logger.h"
 #include "base/std_ext/string.h"
 #include "base/std_ext/container.h"
+#include "base/std_ext/misc.h"
 
 #include "TTree.h"
 
@@ -50,6 +51,8 @@ PlutoReader::PlutoReader(const std::shared_ptr<WrapTFileInput>& rootfiles) :
                           );
     }
 
+    stop_entry = plutoTree.Tree->GetEntries();
+
     LOG(INFO) << "MCTrue input active" << (tidTree ? ", with TID match check" : "") << ", entries=" << plutoTree.Tree->GetEntries();
     LOG_IF(!tidTree, WARNING) << "No TID match check enabled";
 
@@ -61,255 +64,221 @@ PlutoReader::PlutoReader(const std::shared_ptr<WrapTFileInput>& rootfiles) :
     }
 
     pluto_database = makeStaticData();
+    plutoID_dilepton = pluto_database->GetParticleID("dilepton");
+    plutoID_dimuon = pluto_database->GetParticleID("dimuon");
 }
 
 PlutoReader::~PlutoReader() {}
 
-/**
- * @brief Find a PParticle in a vector by its ID. ID has to be unique in the vector.
- * @param particles vector to search
- * @param ID Id to look for
- * @return pair<size_t,bool>, first=Index of found particle, bool: true if found and unique, false else
- */
-std::pair<std::size_t,bool> FindParticleByID(const std::vector<const PParticle*> particles, const int ID) {
-
-    std::pair<std::size_t,bool> result = {0, false};
-
-    for(std::size_t i = 0; i<particles.size(); ++i) {
-        if(particles.at(i)->ID() == ID) {
-            if(!result.second) {
-                result.first = i;
-                result.second = true;
-            } else {
-                result.second = false;
-                return result;
-            }
-        }
-    }
-
-    return result;
+unsigned PlutoReader::BlockSize = 1000;
 
-}
-
-std::string PlutoTable(const std::vector<const PParticle*> particles) {
+std::string PlutoReader::PlutoTable(const particle_t* particles, std::size_t n) {
     stringstream s;
-    int i=0;
     s << "Index\tParticleName\tParentIndex\tNameOfParent\t|\tDaughterIndex\n";
-    for(auto& p : particles ) {
-        const PParticle* pl = p;
-        s << i++ << "\t" << GetParticleName(p) << "\t" << p->GetParentIndex() << "\t" << GetParticleName(pl->GetParentId()) << "\t|\t" <<  p->GetDaughterIndex() << "\t" <<  endl;
+    for(size_t i=0;i<n;++i) {
+        const auto& p = particles[i];
+        s << i << "\t" << GetParticleName(p.ID) << "\t" << p.ParentIndex << "\t" << GetParticleName(p.ParentId) << "\t|\t" <<  p.DaughterIndex << "\t" <<  endl;
     }
 
     return s.str();
 }
 
-using PlutoParticles_t = std::vector<const PParticle*>;
-
-bool BuildParticleGunTree(
-        TParticleTree_t& mctrueTree,
-        const PlutoParticles_t& plutoParticles,
-        const vector<TParticleTree_t>& flatTree)
+TParticleTree_t PlutoReader::BuildTree(const particle_t* particles, std::size_t n)
 {
     // any particle with parent or daughter
-    // means it's not a gun
-    for(auto& plutoParticle : plutoParticles) {
-        if(plutoParticle->GetParentIndex()>=0)
-            return false;
-        if(plutoParticle->GetDaughterIndex()>=0)
-            return false;
+    // means it's not a gun, BeamTarget type is also not allowed in guns
+    bool isGun = true;
+    for(size_t i=0;i<n;++i) {
+        const auto& p = particles[i];
+        if(p.ParentIndex>=0 || p.DaughterIndex>=0 || !p.Type || *p.Type == ParticleTypeDatabase::BeamTarget) {
+            isGun = false;
+            break;
+        }
     }
 
-    // BeamTarget type is also not allowed in guns
-    for(auto& antParticleTree : flatTree) {
-        if(antParticleTree->Get()->Type() == ParticleTypeDatabase::BeamTarget)
-            return false;
+    if(isGun) {
+        // build a tree with all particles as leaves and
+        // "pseudo" GunParticle as headnode
+        auto headnode = Tree<TParticlePtr>::MakeNode(
+                            make_shared<TParticle>(
+                                ParticleTypeDatabase::ParticleGun,
+                                // make sure really uses that as some "true" particle...
+                                LorentzVec({std_ext::NaN,std_ext::NaN,std_ext::NaN}, std_ext::NaN)));
+        for(size_t i=0;i<n;++i)
+            headnode->CreateDaughter(make_shared<TParticle>(*particles[i].Type, particles[i].P));
+        return headnode;
     }
 
-    // build a tree with all particles as leaves and
-    // "pseudo" GunParticle as headnode
-
-    mctrueTree = Tree<TParticlePtr>::MakeNode(
-                     make_shared<TParticle>(
-                         ParticleTypeDatabase::ParticleGun,
-                         // make sure really uses that as some "true" particle...
-                         LorentzVec({std_ext::NaN,std_ext::NaN,std_ext::NaN}, std_ext::NaN)));
-
-    for(auto& treeNode : flatTree) {
-        treeNode->SetParent(mctrueTree);
-    }
-
-    return true;
-}
-
-
-bool BuildDecayTree(
-        TParticleTree_t& mctrueTree,
-        const PlutoParticles_t& plutoParticles,
-        const vector<TParticleTree_t>& flatTree,
-        const std::vector<size_t>& dileptonIndices)
-{
-    // loop over both lists (pluto and the flat tree)
-    // in parallel
-    bool missing_decay_treeinfo = false;
-    for(size_t i=0; i<plutoParticles.size(); ++i) {
-
-        auto plutoParticle = plutoParticles.at(i);
-        auto& treeNode = flatTree.at(i);
-
-        auto parent_index = plutoParticle->GetParentIndex();
-
-        // Set up tree relations (parent/daughter)
-        if(parent_index >= 0 && size_t(parent_index) < flatTree.size()) {
-
-            treeNode->SetParent(flatTree.at(parent_index));
-
-        } else {
-
-            // remember the TreeNode might be nullptr (see above)
-            if(treeNode->Get()) {
-                if(mctrueTree) {
-                    // Found more than one possible headnode in MCTrue
-                    mctrueTree = nullptr;
-                    return false;
-                }
-                mctrueTree = treeNode;
-            }
-            else
-            {
-                auto search_result = FindParticleByID(plutoParticles, plutoParticle->GetParentId());
-
-                if(search_result.second) {
-                    VLOG(7) << "Recovered missing pluto decay tree information.";
-                    treeNode->SetParent(flatTree.at(search_result.first));
-                } else {
-                    // recovery failed
-                    missing_decay_treeinfo = true;
+    // find parents by index first, so that no nodes
+    // are created for events without proper decay tree information
+    auto& parents = tree_parents;
+    parents.assign(n, -1);
+    int head = -1;
+    for(size_t i=0;i<n;++i) {
+        const auto& p = particles[i];
+        if(p.ParentIndex >= 0 && size_t(p.ParentIndex) < n) {
+            parents[i] = p.ParentIndex;
+        }
+        else if(p.Type) {
+            // found more than one possible headnode
+            if(head >= 0)
+                return nullptr;
+            head = int(i);
+        }
+        else {
+            // try recovering the parent of dileptons by the pluto ID,
+            // which has to be unique within the event
+            int found = -1;
+            for(size_t j=0;j<n;++j) {
+                if(particles[j].ID != p.ParentId)
+                    continue;
+                if(found >= 0) {
+                    found = -1;
+                    break;
                 }
-
+                found = int(j);
             }
+            if(found < 0)
+                return nullptr;
+            VLOG(7) << "Recovered missing pluto decay tree information.";
+            parents[i] = found;
         }
     }
 
-    if(!mctrueTree)
-        return false;
+    if(head < 0)
+        return nullptr;
 
-    if(missing_decay_treeinfo) {
-        mctrueTree = nullptr;
-        return false;
+    // only the tree itself keeps the nodes
+    auto& nodes = tree_nodes;
+    std_ext::execute_on_destroy clear_nodes([&nodes] () { nodes.clear(); });
+    nodes.resize(n);
+    for(size_t i=0;i<n;++i) {
+        if(particles[i].Type)
+            nodes[i] = Tree<TParticlePtr>::MakeNode(make_shared<TParticle>(*particles[i].Type, particles[i].P));
     }
 
-    // remove artificial Pluto_dilepton particles,
-    // this assumes that a dilepton never
-    // is a parent of a dilepton
-    for(auto i : dileptonIndices) {
-        auto& dilepton = flatTree[i];
-        while(!dilepton->Daughters().empty()) {
-            auto& d =  dilepton->Daughters().front();
-            d->SetParent(dilepton->GetParent());
+    // daughters of artificial dilepton particles are appended to
+    // the parent of the dilepton afterwards, which removes the dileptons from the tree.
+    // This assumes that a dilepton never is a parent of a dilepton
+    for(size_t i=0;i<n;++i) {
+        const auto parent = parents[i];
+        if(!nodes[i] || parent < 0 || !nodes[parent])
+            continue;
+        nodes[i]->SetParent(nodes[parent]);
+    }
+    for(size_t d=0;d<n;++d) {
+        const auto parent = parents[d];
+        if(nodes[d] || parent < 0 || !nodes[parent])
+            continue;
+        for(size_t i=0;i<n;++i) {
+            if(nodes[i] && parents[i] == int(d))
+                nodes[i]->SetParent(nodes[parent]);
         }
-        dilepton->Unlink();
     }
 
-    mctrueTree->Sort(utils::ParticleTools::SortParticleByName);
-
-    return true;
+    auto headnode = nodes[head];
+    headnode->Sort(utils::ParticleTools::SortParticleByName);
+    return headnode;
 }
 
-void PlutoReader::CopyPluto(TEventData& mctrue)
+void PlutoReader::ReadBlock()
 {
-    const auto nParticles = plutoTree.Particles().GetEntries();
-    PlutoParticles_t plutoParticles;
-    plutoParticles.reserve(size_t(nParticles));
-
-    std::vector<size_t> dileptonIndices;
-
-    for(auto i=0;i<nParticles;++i) {
-        auto particle = dynamic_cast<const PParticle*>(plutoTree.Particles()[i]);
-        // remember positions of those weird dilepton/dimuon particles
-        if(particle->ID() == pluto_database->GetParticleID("dilepton") ||
-           particle->ID() == pluto_database->GetParticleID("dimuon"))
-            dileptonIndices.push_back(i);
-        plutoParticles.push_back(particle);
-    }
-
-
-    vector<TParticleTree_t> flatTree;
-    TParticleList finalstateParticles;
-    // convert pluto particles to ant particles and place in buffer list
-    for(size_t i=0; i<plutoParticles.size(); ++i) {
-
-        auto& plutoParticle = plutoParticles[i];
-
-        // find pluto type in database
-        auto type = ParticleTypeDatabase::GetTypeFromPlutoID( plutoParticle->ID() );
-
-        // note that type might be nullptr (in particular for those dileptons...)
-        // then just add some "empty" tree node
-        if(!type) {
-            if(!std_ext::contains(dileptonIndices, i))
+    block.Particles.clear();
+    block.Begin.clear();
+    block.TIDs.clear();
+    block.Next = 0;
+
+    const auto stop = std::min(current_entry + BlockSize, stop_entry);
+    for(auto entry = current_entry; entry < stop; ++entry) {
+        plutoTree.Tree->GetEntry(entry);
+
+        block.Begin.push_back(block.Particles.size());
+
+        const auto nParticles = plutoTree.Particles().GetEntries();
+        for(auto i=0;i<nParticles;++i) {
+            // the TClonesArray contains PParticles only
+            auto plutoParticle = static_cast<const PParticle*>(plutoTree.Particles()[i]);
+
+            // find pluto type in database
+            // note that type might be nullptr (in particular for those dileptons...)
+            auto type = ParticleTypeDatabase::GetTypeFromPlutoID( plutoParticle->ID() );
+            if(!type &&
+               plutoParticle->ID() != plutoID_dilepton &&
+               plutoParticle->ID() != plutoID_dimuon) {
                 // check $PLUTOSYS/src/PStdData.cc what to do, you may add it to the ant Database if you wish
                 throw Exception(std_ext::formatter() << "Unknown pluto particle found: ID="
                                 << plutoParticle->ID());
+            }
 
-            flatTree.emplace_back(Tree<TParticlePtr>::MakeNode(nullptr));
-            continue;
-        }
-
-        // make an AntParticle out of it
-        LorentzVec lv = *plutoParticle;
-        lv *= 1000.0;   // convert to MeV
-        auto antParticle = make_shared<TParticle>(*type,lv);
+            LorentzVec lv = *plutoParticle;
+            lv *= 1000.0;   // convert to MeV
 
-        // Consider final state particle
-        if(plutoParticle->GetDaughterIndex() == -1 ) { // final state
-            finalstateParticles.emplace_back(antParticle);
+            block.Particles.push_back({type, lv,
+                                       plutoParticle->ID(), plutoParticle->GetParentId(),
+                                       plutoParticle->GetParentIndex(), plutoParticle->GetDaughterIndex()});
         }
 
-        // Simulate some tagger hit
-        if( antParticle->Type() == ParticleTypeDatabase::BeamTarget) {
-            const double energy = antParticle->Ek();
-            unsigned channel = 0;
-            if(tagger && tagger->TryGetChannelFromPhoton(energy, channel)) {
-                const double time = 0.0; /// @todo handle non-prompt hits?
-                mctrue.TaggerHits.emplace_back(channel, energy, time);
-            }
+        if(tidTree) {
+            tidTree.Tree->GetEntry(entry);
+            block.TIDs.push_back(tidTree.tid);
         }
-
-        // save it in list with same order as in PlutoParticles
-        flatTree.emplace_back(Tree<TParticlePtr>::MakeNode(antParticle));
-
     }
+    block.Begin.push_back(block.Particles.size());
+}
+
+void PlutoReader::CopyPluto(TEventData& mctrue)
+{
+    const auto begin = block.Begin[block.Next];
+    const auto nParticles = block.Begin[block.Next+1] - begin;
+    const particle_t* particles = nParticles>0 ? addressof(block.Particles[begin]) : nullptr;
 
     // try building the particle tree
     // first check if it's a particle gun event
     // then try building the usual decay tree
-    if(!BuildParticleGunTree(mctrue.ParticleTree, plutoParticles, flatTree)) {
-        if(!BuildDecayTree(mctrue.ParticleTree, plutoParticles, flatTree, dileptonIndices)) {
-            LOG_N_TIMES(10, WARNING) << "Missing decay tree info for event " << mctrue.ID
-                                     << " (max 10 times reported)";
-            VLOG(5)      << "Dumping Pluto particles:\n" << PlutoTable(plutoParticles);
-        }
-    }
-
-    // some diagnostics
-    if(!dileptonIndices.empty()) {
-        VLOG(5) << "Particle tree cleaned from dileptons: " << utils::ParticleTools::GetDecayString(mctrue.ParticleTree);
-        VLOG(5) << "Dumping Pluto particles:\n" << PlutoTable(plutoParticles);
+    mctrue.ParticleTree = BuildTree(particles, nParticles);
+    if(!mctrue.ParticleTree) {
+        LOG_N_TIMES(10, WARNING) << "Missing decay tree info for event " << mctrue.ID
+                                 << " (max 10 times reported)";
+        VLOG(5)      << "Dumping Pluto particles:\n" << PlutoTable(particles, nParticles);
     }
 
-    // calculate energy sum based on direction of particle
     auto& triggerInfos = mctrue.Trigger;
     triggerInfos.ClusterMultiplicity = 0;
     triggerInfos.CBTiming = 0;
     double Esum = 0;
-    for(const auto& particle : finalstateParticles) {
-        if(geometry.DetectorFromAngles(*particle) & Detector_t::Type_t::CB) {
-            Esum += particle->Ek();
+    bool hasDileptons = false;
+    for(size_t i=0;i<nParticles;++i) {
+        const auto& p = particles[i];
+        if(!p.Type) {
+            hasDileptons = true;
+            continue;
+        }
+
+        const double Ek = p.P.E - p.Type->Mass();
+
+        // Simulate some tagger hit
+        if(*p.Type == ParticleTypeDatabase::BeamTarget) {
+            unsigned channel = 0;
+            if(tagger && tagger->TryGetChannelFromPhoton(Ek, channel)) {
+                const double time = 0.0; /// @todo handle non-prompt hits?
+                mctrue.TaggerHits.emplace_back(channel, Ek, time);
+            }
+        }
+
+        // calculate energy sum based on direction of final state particles
+        if(p.DaughterIndex == -1 && geometry.DetectorFromAngles(p.P) & Detector_t::Type_t::CB) {
+            Esum += Ek;
             // expected MCTrue multiplicity
             triggerInfos.ClusterMultiplicity++;
         }
     }
     triggerInfos.CBEnergySum = Esum;
+
+    // some diagnostics
+    if(hasDileptons) {
+        VLOG(5) << "Particle tree cleaned from dileptons: " << utils::ParticleTools::GetDecayString(mctrue.ParticleTree);
+        VLOG(5) << "Dumping Pluto particles:\n" << PlutoTable(particles, nParticles);
+    }
 }
 
 
@@ -318,33 +287,35 @@ bool PlutoReader::ReadNextEvent(event_t& event)
     if(!plutoTree)
         return false;
 
-    if(current_entry >= plutoTree.Tree->GetEntries())
+    if(current_entry >= stop_entry)
         return false;
 
-    plutoTree.Tree->GetEntry(current_entry);
+    if(block.Next >= block.Size())
+        ReadBlock();
 
     // use eventID from file if available
     // also check if it matches with reconstructed TID
+    const TID& tid = tidTree ? block.TIDs[block.Next] : tidTree.tid();
     if(tidTree) {
-        tidTree.Tree->GetEntry(current_entry);
         if(event.HasReconstructed() &&
-           event.Reconstructed().ID != tidTree.tid) {
+           event.Reconstructed().ID != tid) {
             throw Exception(std_ext::formatter()
                             << "TID mismatch: Reconstructed=" << event.Reconstructed().ID
-                            << " not equal to MCTrue=" << tidTree.tid);
+                            << " not equal to MCTrue=" << tid);
         }
     }
 
     // ensure MCTrue branch is there, potentially add TID if invalid so far
     if(!event.HasMCTrue()) {
-        event.MakeMCTrue(tidTree.tid);
+        event.MakeMCTrue(tid);
     }
     else if(event.MCTrue().ID.IsInvalid()) {
-        event.MCTrue().ID = tidTree.tid;
+        event.MCTrue().ID = tid;
     }
 
     CopyPluto(event.MCTrue());
 
+    ++block.Next;
     ++current_entry;
 
     if(!tidTree)
@@ -355,5 +326,21 @@ bool PlutoReader::ReadNextEvent(event_t& event)
 
 double PlutoReader::PercentDone() const
 {
-    return double(current_entry) / double(plutoTree.Tree->GetEntries());
+    return double(current_entry-first_entry) / double(stop_entry-first_entry);
+}
+
+bool PlutoReader::SetShard(const Shard& shard)
+{
+    if(!plutoTree)
+        return true;
+
+    // entries must stay in sync with the reconstructed input, which is split the same way
+    const auto range = shard.GetRange(plutoTree.Tree->GetEntries());
+    first_entry = range.Start();
+    current_entry = first_entry;
+    stop_entry = range.Stop();
+    block = {};
+    if(!tidTree)
+        tidTree.tid().Lower += first_entry;
+    return true;
 }
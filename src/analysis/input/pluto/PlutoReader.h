@@ -7,9 +7,13 @@
 #include "base/ParticleType.h"
 #include "base/WrapTTree.h"
 
+#include "tree/TID.h"
+#include "tree/TParticle.h"
+
 #include <memory>
 #include <string>
 #include <list>
+#include <vector>
 
 #include "TClonesArray.h"
 
@@ -48,9 +52,59 @@ protected:
     TIDTree_t tidTree;
 
     long long current_entry = 0;
+    long long first_entry = 0;
+    long long stop_entry = 0;
+
+    /**
+     * @brief The particle_t struct is the compact copy of a PParticle,
+     * parent and daughter are referred to by index within the same entry
+     */
+    struct particle_t {
+        const ParticleTypeDatabase::Type* Type; // nullptr for artificial dilepton/dimuon
+        LorentzVec P;                           // in MeV
+        int ID;
+        int ParentId;
+        int ParentIndex;
+        int DaughterIndex;
+    };
+
+    /**
+     * @brief The block_t struct holds the particles of consecutive entries,
+     * the TParticles are only created once an entry is handed out
+     *
+     * As TEventData holds the complete TParticleTree_t, the tree of each
+     * handed out entry is still built right away, and not on first access.
+     */
+    struct block_t {
+        std::vector<particle_t> Particles;
+        std::vector<std::size_t> Begin; // per entry, offset in Particles, with one extra for the end
+        std::vector<TID> TIDs;          // only filled if tidTree present
+        std::size_t Next = 0;           // entry to be handed out next
+        std::size_t Size() const { return Begin.empty() ? 0 : Begin.size()-1; }
+    };
+
+    block_t block;
 
+    // resolved once, looking them up by name is expensive
+    int plutoID_dilepton = -1;
+    int plutoID_dimuon = -1;
+
+    void ReadBlock();
     void CopyPluto(TEventData& mctrue);
 
+    // reused by BuildTree for each entry
+    std::vector<int> tree_parents;
+    std::vector<TParticleTree_t> tree_nodes;
+
+    /**
+     * @brief BuildTree links the particles of one entry either as particle gun or as decay tree
+     * @param particles first particle of the entry
+     * @param n number of particles in entry
+     * @return head node of the tree, nullptr if the decay tree information is missing
+     */
+    TParticleTree_t BuildTree(const particle_t* particles, std::size_t n);
+    static std::string PlutoTable(const particle_t* particles, std::size_t n);
+
     PStaticData* pluto_database;
 
 public:
@@ -63,6 +117,13 @@ public:
     virtual bool ReadNextEvent(input::event_t& event) override;
 
     double PercentDone() const override;
+
+    virtual bool SetShard(const Shard& shard) override;
+
+    /**
+     * @brief BlockSize number of entries read and converted at once
+     */
+    static unsigned BlockSize;
 };
 
 }
@@ -1,14 +1,44 @@
 #pragma once
 
+#include "event_t.h"
+
 #include "tree/TEvent.h"
+#include "tree/TEventData.h"
 #include "base/WrapTTree.h"
 
+#include <cstdint>
+
 namespace ant {
 namespace analysis {
 namespace input {
 
+/**
+ * @brief The treeEvents_t struct stores TEvents in a tree,
+ * the format written is selected by TEventCodec::WriteFormat
+ */
 struct treeEvents_t : WrapTTree {
     ADD_BRANCH_T(TEvent, data)
+    // validities of the slowcontrol items in data, see GetSlowControlFlags,
+    // small enough to be scanned without reading the events (missing in older files)
+    ADD_BRANCH_OPT_T(std::uint8_t, slowcontrols)
+
+    enum SlowControlFlag_t : std::uint8_t {
+        Backward = 1 << 0,
+        Forward  = 1 << 1
+    };
+
+    static std::uint8_t GetSlowControlFlags(const event_t& event) {
+        std::uint8_t flags = 0;
+        if(!event.HasReconstructed())
+            return flags;
+        for(const TSlowControl& sc : event.Reconstructed().SlowControls) {
+            if(sc.Validity == TSlowControl::Validity_t::Backward)
+                flags |= Backward;
+            else if(sc.Validity == TSlowControl::Validity_t::Forward)
+                flags |= Forward;
+        }
+        return flags;
+    }
 };
 
-}}}
\ No newline at end of file
+}}}
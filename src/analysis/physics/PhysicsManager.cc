@@ -80,6 +80,7 @@ void PhysicsManager::ReadFrom(
     long long nEventsSaved = 0;
 
     bool reached_maxevents = false;
+    bool reading_leadout = false;
 
 
     ProgressCounter progress(
@@ -117,6 +118,11 @@ void PhysicsManager::ReadFrom(
             }
             nEventsRead++;
 
+            // when sharded, the reader continues after the shard
+            // until the slowcontrol is complete for all events inside
+            if(event.ShardOverlap == Shard::Overlap_t::LeadOut)
+                reading_leadout = true;
+
             // dump it into slowcontrol until full...
             if(slowControlManager.ProcessEvent(move(event)))
                 break;
@@ -141,6 +147,11 @@ void PhysicsManager::ReadFrom(
             logger::DebugInfo::nProcessedEvents = nEventsProcessed;
 
             physics::manager_t manager;
+            manager.triggersimu = triggersimu;
+
+            // events outside the shard are only needed for the slowcontrol,
+            // they are analysed and saved by the neighbouring shards
+            const bool inside_shard = event.ShardOverlap == Shard::Overlap_t::None;
 
             // if we've already reached the maxevents,
             // we just postprocess the remaining slowcontrol buffer (if any)
@@ -154,9 +165,10 @@ void PhysicsManager::ReadFrom(
                         break;
                 }
 
-                if(!reached_maxevents && !buf_event.WantsSkip) {
+                if(!reached_maxevents && !buf_event.WantsSkip && inside_shard) {
 
                     ProcessEvent(event, manager);
+                    triggersimu = manager.triggersimu;
 
                     // prefer Reconstructed ID, but at least one branch should be non-null
                     const auto& eventid = event.HasReconstructed() ? event.Reconstructed().ID : event.MCTrue().ID;
@@ -171,12 +183,20 @@ void PhysicsManager::ReadFrom(
                 }
             }
 
+            if(!inside_shard)
+                continue;
+
             // SaveEvent is the sink for events
             SaveEvent(move(event), manager);
 
             nEventsProcessed++;
         }
         ProgressCounter::Tick();
+
+        if(reading_leadout && slowControlManager.OnlyLeadOutBuffered()) {
+            VLOG(5) << "All events of shard processed, finish.";
+            break;
+        }
     }
 
     for(auto& pclass : physics) {
@@ -269,6 +289,7 @@ void PhysicsManager::SaveEvent(input::event_t event, const physics::manager_t& m
         if(!manager.keepReadHits && !event.SavedForSlowControls)
             event.ClearDetectorReadHits();
 
+        treeEvents.slowcontrols = input::treeEvents_t::GetSlowControlFlags(event);
         treeEvents.data = move(event);
         treeEvents.Tree->Fill();
     }
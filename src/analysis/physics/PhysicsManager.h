@@ -19,6 +19,7 @@ struct event_t;
 
 namespace utils {
 class ParticleID;
+class TriggerSimulation;
 }
 
 namespace input {
@@ -59,6 +60,10 @@ protected:
 
     interval<TID> processedTIDrange;
 
+    // shared by all physics classes via manager_t::TriggerSimu,
+    // kept across events as the MC trigger simulation draws random numbers
+    std::shared_ptr<utils::TriggerSimulation> triggersimu;
+
     // for output of TEvents to TTree
     input::treeEvents_t treeEvents;
 
@@ -3,6 +3,7 @@
 #include "root-addons/cbtaps_display/TH2CB.h"
 #include "utils/Combinatorics.h"
 #include "utils/ParticleTools.h"
+#include "utils/TriggerSimulation.h"
 #include "base/Logger.h"
 
 #include "TF1.h"
@@ -143,9 +144,9 @@ TriggerOverview::TriggerOverview(const string &name, OptionsPtr opts):
 TriggerOverview::~TriggerOverview()
 {}
 
-void TriggerOverview::ProcessEvent(const TEvent& event, manager_t&)
+void TriggerOverview::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    triggersimu.ProcessEvent(event);
+    const auto& triggersimu = manager.TriggerSimu(event);
 
     const auto& branch =  GetBranch(event);
     const auto& trigger = branch.Trigger;
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "analysis/physics/Physics.h"
-#include "utils/TriggerSimulation.h"
 #include "base/WrapTTree.h"
 
 #include <string>
@@ -90,7 +89,6 @@ protected:
 
     Tree_t tree;
 
-    utils::TriggerSimulation triggersimu;
 
 public:
     TriggerOverview(const std::string& name, OptionsPtr opts);
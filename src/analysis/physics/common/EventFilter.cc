@@ -4,6 +4,7 @@
 #include "base/std_ext/string.h"
 #include "base/Logger.h"
 #include "utils/ProtonPermutation.h"
+#include "utils/TriggerSimulation.h"
 
 
 using namespace ant;
@@ -70,7 +71,7 @@ EventFilter::~EventFilter()
 
 void EventFilter::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    triggersimu.ProcessEvent(event);
+    const auto& triggersimu = manager.TriggerSimu(event);
 
     const auto& data = event.Reconstructed();
 
@@ -4,7 +4,6 @@
 
 #include "base/interval.h"
 
-#include "analysis/utils/TriggerSimulation.h"
 
 
 namespace ant {
@@ -18,7 +17,6 @@ protected:
     const double CBEsum;
     const double maxCoplAngle;
 
-    utils::TriggerSimulation triggersimu;
     TH1D* steps;
 
     /**
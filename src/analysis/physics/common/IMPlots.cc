@@ -1,6 +1,8 @@
 #include "IMPlots.h"
 #include "utils/Combinatorics.h"
 #include "utils/ParticleTools.h"
+#include "utils/EventCombinatorics.h"
+#include "utils/TriggerSimulation.h"
 #include "base/Logger.h"
 #include "TH1D.h"
 #include "TTree.h"
@@ -25,32 +27,20 @@ IMPlots::IMPlots(const std::string& name, OptionsPtr opts):
     }
 }
 
-template <typename iter>
-LorentzVec sumlv(iter start, iter end) {
-    LorentzVec s;
-    while(start != end ) {
-        s += **(start);
-        ++start;
-    }
-    return s;
-}
-
 
-void IMPlots::ProcessEvent(const TEvent& event, manager_t&)
+void IMPlots::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    triggersimu.ProcessEvent(event);
-    auto recon_particles = utils::ParticleTypeList::Make(event.Reconstructed().Candidates);
-    const auto& photons = recon_particles.Get(ParticleTypeDatabase::Photon);
+    const auto& taggertimes = manager.TriggerSimu(event).GetCorrectedTaggerTimes();
+    auto& combinatorics = manager.Combinatorics(event.Reconstructed());
 
     for(unsigned n = MinNGamma(); n<MaxNGamma(); ++n) {
-        for( auto comb = utils::makeCombination(photons,n); !comb.done(); ++comb) {
-            const LorentzVec sum = sumlv(comb.begin(), comb.end());
-                for(const auto& h : event.Reconstructed().TaggerHits) {
-                    prs.SetTaggerTime(triggersimu.GetCorrectedTaggerTime(h));
-                    m.at(n - MinNGamma()).Fill(sum.M());
-                }
+        for(const auto im : combinatorics.PhotonCombinations(n).IMs) {
+            for(const auto taggertime : taggertimes) {
+                prs.SetTaggerTime(taggertime);
+                m.at(n - MinNGamma()).Fill(im);
             }
-       }
+        }
+    }
 }
 
 void IMPlots::ShowResult()
@@ -88,19 +78,18 @@ Symmetric2Gamma::Symmetric2Gamma(const string& name, OptionsPtr opts):
 Symmetric2Gamma::~Symmetric2Gamma()
 {}
 
-void Symmetric2Gamma::ProcessEvent(const TEvent& event, manager_t&)
+void Symmetric2Gamma::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    auto recon_particles = utils::ParticleTypeList::Make(event.Reconstructed().Candidates);
-    const auto& photons = recon_particles.Get(ParticleTypeDatabase::Photon);
-    for( auto comb = utils::makeCombination(photons,2); !comb.done(); ++comb) {
-        const TParticlePtr& g1 = comb.at(0);
-        const TParticlePtr& g2 = comb.at(1);
+    auto& combinatorics = manager.Combinatorics(event.Reconstructed());
+    const auto& photons = combinatorics.Photons();
+    const auto& combs = combinatorics.PhotonCombinations(2);
+    for(size_t i=0; i<combs.size(); ++i) {
+        const TParticlePtr& g1 = photons[combs.IndicesOf(i)[0]];
+        const TParticlePtr& g2 = photons[combs.IndicesOf(i)[1]];
 
         const auto Eavg = (g1->Ek()+ g2->Ek()) / 2.0;
         if(fabs(g1->Ek() - Eavg) < perc * Eavg) {
-            const LorentzVec sum = sumlv(comb.begin(), comb.end());
-
-            b_IM = sum.M();
+            b_IM = combs.IMs[i];
             b_E  = Eavg;
 
             b_E1     = g1->Ek();
@@ -2,7 +2,6 @@
 
 #include "analysis/physics/Physics.h"
 #include "plot/PromptRandomHist.h"
-#include "utils/TriggerSimulation.h"
 #include <vector>
 
 class TH1D;
@@ -14,7 +13,6 @@ namespace physics {
 
 class IMPlots : public Physics {
 public:
-    utils::TriggerSimulation triggersimu;
     PromptRandom::Switch prs;
     std::vector<PromptRandom::Hist1> m;
     unsigned MinNGamma() const noexcept { return 2;}
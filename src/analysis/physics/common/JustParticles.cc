@@ -2,6 +2,7 @@
 #include "base/std_ext/math.h"
 #include "expconfig/ExpConfig.h"
 #include "analysis/utils/uncertainties/FitterSergey.h"
+#include "analysis/utils/TriggerSimulation.h"
 
 #include "TTree.h"
 
@@ -52,7 +53,7 @@ JustParticles::JustParticles(const string& name, OptionsPtr opts):
 
 void JustParticles::ProcessEvent(const TEvent& event, manager_t& manager)
 {
-    triggersimu.ProcessEvent(event);
+    const auto& triggersimu = manager.TriggerSimu(event);
 
     steps->Fill("Seen",1.0);
 
@@ -88,8 +89,10 @@ void JustParticles::ProcessEvent(const TEvent& event, manager_t& manager)
 
 
 
-    for(const TTaggerHit& taggerhit : event.Reconstructed().TaggerHits) {
-        promptrandom.SetTaggerTime(triggersimu.GetCorrectedTaggerTime(taggerhit));
+    const auto& taggerhits = event.Reconstructed().TaggerHits;
+    for(size_t i_taggerhit=0;i_taggerhit<taggerhits.size();i_taggerhit++) {
+        const TTaggerHit& taggerhit = taggerhits[i_taggerhit];
+        promptrandom.SetTaggerTime(triggersimu.GetCorrectedTaggerTimes()[i_taggerhit]);
         if(promptrandom.State() == PromptRandom::Case::Outside)
             continue;
 
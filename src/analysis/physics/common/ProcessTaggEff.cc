@@ -15,6 +15,7 @@ ProcessTaggEff::ProcessTaggEff(const std::string& name, OptionsPtr opts) :
 
     useTimeCut  = opts->Get<bool>("useTimeCut", false);
     if(useTimeCut) cout << "Activating time cut for Tagger TDCs of -5 to 5" << endl;
+    treeOnly    = opts->Get<bool>("TreeOnly", false);
 
     auto Tagger = ExpConfig::Setup::GetDetector<TaggerDetector_t>();
     if (!Tagger) throw std::runtime_error("No Tagger found");
@@ -24,19 +25,21 @@ ProcessTaggEff::ProcessTaggEff(const std::string& name, OptionsPtr opts) :
     auto bins_tagger = BinSettings(nchannels);
     auto bins_time   = BinSettings(600,-150,150);
 
-    hist_scalers            = HistFac.makeTH1D("scalars - e^{-} counts",                "channel no.","# per scaler block", bins_tagger,            "scalerHits");
+    if(!treeOnly) {
+        hist_scalers            = HistFac.makeTH1D("scalars - e^{-} counts",                "channel no.","# per scaler block", bins_tagger,            "scalerHits");
 
-    hist_scalers_rate       = HistFac.makeTH1D("scalars - e^{-} rate",                  "channel no.","freq [Hz]",          bins_tagger,            "scalerRates");
-    hist_tdchits_rate       = HistFac.makeTH1D("tdc     - #gamma rate",                 "channel no.","freq [Hz]",          bins_tagger,            "tdcRates");
+        hist_scalers_rate       = HistFac.makeTH1D("scalars - e^{-} rate",                  "channel no.","freq [Hz]",          bins_tagger,            "scalerRates");
+        hist_tdchits_rate       = HistFac.makeTH1D("tdc     - #gamma rate",                 "channel no.","freq [Hz]",          bins_tagger,            "tdcRates");
 
-    hist_tdchits            = HistFac.makeTH1D("tdc - #gamma counts",                   "channel no.","# per scaler block", bins_tagger,            "tdcHits");
-    hist_tdchits_wcut       = HistFac.makeTH1D("tdc - #gamma counts (after time cut)",  "channel no.","# per scaler block", bins_tagger,            "tdcHits_withTimeCut");
+        hist_tdchits            = HistFac.makeTH1D("tdc - #gamma counts",                   "channel no.","# per scaler block", bins_tagger,            "tdcHits");
+        hist_tdchits_wcut       = HistFac.makeTH1D("tdc - #gamma counts (after time cut)",  "channel no.","# per scaler block", bins_tagger,            "tdcHits_withTimeCut");
 
-    hist_tdc_times          = HistFac.makeTH1D("tdc time",                              "tdc time", "Counts",               bins_time,              "tdcTime");
-    hist_tdc_times_wcut     = HistFac.makeTH1D("tdc time (after time cut)",             "tdc time", "Counts",               bins_time,              "tdcTime_withTimeCut");
+        hist_tdc_times          = HistFac.makeTH1D("tdc time",                              "tdc time", "Counts",               bins_time,              "tdcTime");
+        hist_tdc_times_wcut     = HistFac.makeTH1D("tdc time (after time cut)",             "tdc time", "Counts",               bins_time,              "tdcTime_withTimeCut");
 
-    hist_tdc_times_ch       = HistFac.makeTH2D("tdc time v channel",                    "tdc time ","Channel",              bins_time, bins_tagger, "tdcTime_channel");
-    hist_tdc_times_ch_wcut  = HistFac.makeTH2D("tdc time v channel (after time cut)",   "tdc time ","Channel",              bins_time, bins_tagger, "tdcTime_channel_withTimeCut");
+        hist_tdc_times_ch       = HistFac.makeTH2D("tdc time v channel",                    "tdc time ","Channel",              bins_time, bins_tagger, "tdcTime_channel");
+        hist_tdc_times_ch_wcut  = HistFac.makeTH2D("tdc time v channel (after time cut)",   "tdc time ","Channel",              bins_time, bins_tagger, "tdcTime_channel_withTimeCut");
+    }
 
 
     slowcontrol::Variables::TaggerScalers->Request();
@@ -83,16 +86,20 @@ void ProcessTaggEff::processTaggerHits(const TEvent &ev)
     for (const auto& taggerhit: ev.Reconstructed().TaggerHits)
     {
 
-        hist_tdc_times->Fill(taggerhit.Time);
-        hist_tdc_times_ch->Fill(taggerhit.Time, taggerhit.Channel);
-        hist_tdchits->Fill(taggerhit.Channel);
+        if(!treeOnly) {
+            hist_tdc_times->Fill(taggerhit.Time);
+            hist_tdc_times_ch->Fill(taggerhit.Time, taggerhit.Channel);
+            hist_tdchits->Fill(taggerhit.Channel);
+        }
 
         // if time cut is desired, make a time cut around -5,5 ns
         if ((useTimeCut) && (abs(taggerhit.Time) > 5)) continue;
 
-        hist_tdc_times_wcut->Fill(taggerhit.Time);
-        hist_tdc_times_ch_wcut->Fill(taggerhit.Time, taggerhit.Channel);
-        hist_tdchits_wcut->Fill(taggerhit.Channel);
+        if(!treeOnly) {
+            hist_tdc_times_wcut->Fill(taggerhit.Time);
+            hist_tdc_times_ch_wcut->Fill(taggerhit.Time, taggerhit.Channel);
+            hist_tdchits_wcut->Fill(taggerhit.Channel);
+        }
 
         scalerReads.TDCCounts().at(taggerhit.Channel)++;
         scalerReads.TaggTimings().at(taggerhit.Channel).emplace_back(taggerhit.Time);
@@ -108,6 +115,8 @@ void ProcessTaggEff::processBlock()
         scalerReads.TaggCounts().at(ch) = slowcontrol::Variables::TaggerScalers->GetCounts().at(ch);
         scalerReads.TDCRates().at(ch) = ( 1.0e6 * scalerReads.TDCCounts().at(ch)
                                           / slowcontrol::Variables::Clocks->GetExpClock() );
+        if(treeOnly)
+            continue;
         hist_scalers->Fill(ch,scalerReads.TaggCounts().at(ch));
         hist_scalers_rate->Fill(ch,scalerReads.TaggRates().at(ch));
         hist_tdchits_rate->Fill(ch,scalerReads.TDCRates().at(ch));
@@ -134,8 +143,10 @@ void ProcessTaggEff::resetAll()
 
 void ProcessTaggEff::Finish()
 {
-    hist_scalers_rate->Scale(1.0 / seenScalerBlocks);
-    hist_tdchits_rate->Scale(1.0 / seenScalerBlocks);
+    if(!treeOnly) {
+        hist_scalers_rate->Scale(1.0 / seenScalerBlocks);
+        hist_tdchits_rate->Scale(1.0 / seenScalerBlocks);
+    }
 
     LOG(INFO) << "Filled Tree for " << seenEvents
               << " in " << seenScalerBlocks
@@ -149,6 +160,9 @@ void ProcessTaggEff::ShowResult()
                     << TTree_drawable(scalerReads.Tree, "TDCRates")
                     <<  endc;
 
+    if(treeOnly)
+        return;
+
     hist_scalers->SetLineColor(kRed);
     hist_scalers_rate->SetLineColor(kRed);
     canvas("channels") << padoption::Legend << hist_scalers      << samepad << hist_tdchits
@@ -14,23 +14,25 @@ namespace physics {
 struct ProcessTaggEff: public Physics {
 
     bool useTimeCut;
+    // only fill the scalerReads tree, which is all Ant-makeTaggEff needs
+    bool treeOnly;
 
     unsigned seenEvents = 0;
     unsigned seenScalerBlocks = 0;
     unsigned nchannels = std::numeric_limits<unsigned>::quiet_NaN();
 
-    TH1D* hist_scalers;
-    TH1D* hist_tdchits;
+    TH1D* hist_scalers = nullptr;
+    TH1D* hist_tdchits = nullptr;
 
-    TH1D* hist_scalers_rate;
-    TH1D* hist_tdchits_rate;
+    TH1D* hist_scalers_rate = nullptr;
+    TH1D* hist_tdchits_rate = nullptr;
 
-    TH1D* hist_tdc_times;
-    TH2D* hist_tdc_times_ch;
+    TH1D* hist_tdc_times = nullptr;
+    TH2D* hist_tdc_times_ch = nullptr;
 
-    TH1D* hist_tdchits_wcut;
-    TH1D* hist_tdc_times_wcut;
-    TH2D* hist_tdc_times_ch_wcut;
+    TH1D* hist_tdchits_wcut = nullptr;
+    TH1D* hist_tdc_times_wcut = nullptr;
+    TH2D* hist_tdc_times_ch_wcut = nullptr;
 
     struct TreeScalarReads : WrapTTree {
         ADD_BRANCH_T(int,   nEvtsPerRead)
@@ -0,0 +1,34 @@
+#include "manager_t.h"
+
+#include "analysis/utils/EventCombinatorics.h"
+#include "analysis/utils/TriggerSimulation.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::physics;
+
+ant::analysis::utils::EventCombinatorics& manager_t::Combinatorics(const TEventData& eventdata)
+{
+    // usually only the reconstructed eventdata is asked for
+    auto it = find_if(combinatorics.begin(), combinatorics.end(),
+                      [&eventdata] (const shared_ptr<utils::EventCombinatorics>& c) {
+        return addressof(c->EventData()) == addressof(eventdata);
+    });
+    if(it != combinatorics.end())
+        return **it;
+    combinatorics.emplace_back(make_shared<utils::EventCombinatorics>(eventdata));
+    return *combinatorics.back();
+}
+
+const ant::analysis::utils::TriggerSimulation& manager_t::TriggerSimu(const TEvent& event)
+{
+    if(!triggersimu)
+        triggersimu = make_shared<utils::TriggerSimulation>();
+    if(triggersimu_event != addressof(event)) {
+        triggersimu->ProcessEvent(event);
+        triggersimu_event = addressof(event);
+    }
+    return *triggersimu;
+}
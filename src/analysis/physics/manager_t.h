@@ -1,11 +1,23 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 namespace ant {
+
+struct TEvent;
+struct TEventData;
+
 namespace analysis {
 
 class PhysicsManager;
 class SlowControlManager;
 
+namespace utils {
+class EventCombinatorics;
+class TriggerSimulation;
+}
+
 namespace physics {
 
 struct manager_t {
@@ -15,12 +27,33 @@ struct manager_t {
     void KeepDetectorReadHits() {
         keepReadHits = true;
     }
+
+    /**
+     * @brief Combinatorics provides the particles and photon combinations of the given eventdata,
+     * which are built only once per event and shared by all physics classes
+     * @param eventdata usually event.Reconstructed()
+     */
+    utils::EventCombinatorics& Combinatorics(const TEventData& eventdata);
+
+    /**
+     * @brief TriggerSimu provides the trigger simulation of the given event,
+     * which is processed only once per event and shared by all physics classes
+     * @param event the event under investigation
+     * @return the processed trigger simulation, check IsSane() for success
+     */
+    const utils::TriggerSimulation& TriggerSimu(const TEvent& event);
+
 private:
     friend class ant::analysis::PhysicsManager;
     friend class ant::analysis::SlowControlManager;
     bool saveEvent = false;
     bool keepReadHits = false;
 
+    std::vector<std::shared_ptr<utils::EventCombinatorics>> combinatorics;
+
+    // created on first use, kept across events by the PhysicsManager
+    std::shared_ptr<utils::TriggerSimulation> triggersimu;
+    const TEvent* triggersimu_event = nullptr;
 };
 
 }
@@ -342,8 +342,11 @@ void sigmaPlus::ProcessEvent(const ant::TEvent& event, manager_t&)
     }
     if (particleTree)
     {
+        // one hash of the event tree, compared against all channels,
+        // a matching hash is confirmed by comparing the trees
+        utils::ParticleTools::TypeTreeMatcher matcher(particleTree);
 
-        if (particleTree->IsEqual(signal.DecayTree,utils::ParticleTools::MatchByParticleName))
+        if (matcher.Matches(signal.DecayTree, signal.Signature))
         {
             const auto& taggerhits = event.MCTrue().TaggerHits;
 
@@ -368,7 +371,7 @@ void sigmaPlus::ProcessEvent(const ant::TEvent& event, manager_t&)
             tree.MCTrue = phSettings.Index_Signal;
             trueChannel = signal.Name;
         }
-        else if (particleTree->IsEqual(mainBackground.DecayTree,utils::ParticleTools::MatchByParticleName))
+        else if (matcher.Matches(mainBackground.DecayTree, mainBackground.Signature))
         {
             tree.MCTrue = phSettings.Index_MainBkg;
             trueChannel = mainBackground.Name;
@@ -379,7 +382,7 @@ void sigmaPlus::ProcessEvent(const ant::TEvent& event, manager_t&)
             bool found = false;
             for (const auto& otherChannel:otherBackgrounds)
             {
-                if (particleTree->IsEqual(otherChannel.DecayTree,utils::ParticleTools::MatchByParticleName))
+                if (matcher.Matches(otherChannel.DecayTree, otherChannel.Signature))
                 {
                     tree.MCTrue = index;
                     trueChannel = otherChannel.Name;
@@ -81,9 +81,11 @@ struct sigmaPlus :  Physics {
     {
         const std::string Name;
         const ParticleTypeTree DecayTree;
+        const std::uint64_t Signature;
         named_channel_t(const std::string& name, ParticleTypeTree tree):
             Name(name),
-            DecayTree(tree){}
+            DecayTree(tree),
+            Signature(ParticleTypeTreeDatabase::GetSignature(tree)){}
     };
 
     static const named_channel_t              signal;
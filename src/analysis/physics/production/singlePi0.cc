@@ -182,7 +182,10 @@ void singlePi0::ProcessEvent(const ant::TEvent& event, manager_t&)
     auto& particleTree = event.MCTrue().ParticleTree;
     if (particleTree)
     {
-        if (particleTree->IsEqual(signal.DecayTree,utils::ParticleTools::MatchByParticleName))
+        // one hash of the event tree, compared against all channels,
+        // a matching hash is confirmed by comparing the trees
+        utils::ParticleTools::TypeTreeMatcher matcher(particleTree);
+        if (matcher.Matches(signal.DecayTree, signal.Signature))
         {
             const auto& taggerhits = event.MCTrue().TaggerHits;
             const auto  truePi0    = getTruePi0(particleTree);
@@ -209,7 +212,7 @@ void singlePi0::ProcessEvent(const ant::TEvent& event, manager_t&)
             tree.MCTrue() = phSettings.Index_Signal;
             trueChannel = signal.Name;
         }
-        else if (particleTree->IsEqual(mainBackground.DecayTree,utils::ParticleTools::MatchByParticleName))
+        else if (matcher.Matches(mainBackground.DecayTree, mainBackground.Signature))
         {
             tree.MCTrue() = phSettings.Index_MainBkg;
             trueChannel = mainBackground.Name;
@@ -220,7 +223,7 @@ void singlePi0::ProcessEvent(const ant::TEvent& event, manager_t&)
             bool found = false;
             for (const auto& otherChannel:otherBackgrounds)
             {
-                if (particleTree->IsEqual(otherChannel.DecayTree,utils::ParticleTools::MatchByParticleName))
+                if (matcher.Matches(otherChannel.DecayTree, otherChannel.Signature))
                 {
                     tree.MCTrue() = index;
                     trueChannel = otherChannel.Name;
@@ -277,8 +277,11 @@ void triplePi0::ProcessEvent(const ant::TEvent& event, manager_t&)
     }
     if (particleTree)
     {
+        // one hash of the event tree, compared against all channels,
+        // a matching hash is confirmed by comparing the trees
+        utils::ParticleTools::TypeTreeMatcher matcher(particleTree);
 
-        if (particleTree->IsEqual(signal.DecayTree,utils::ParticleTools::MatchByParticleName))
+        if (matcher.Matches(signal.DecayTree, signal.Signature))
         {
             const auto& taggerhits = event.MCTrue().TaggerHits;
 
@@ -300,7 +303,7 @@ void triplePi0::ProcessEvent(const ant::TEvent& event, manager_t&)
             tree.MCTrue = phSettings.Index_Signal;
             trueChannel = signal.Name;
         }
-        else if (particleTree->IsEqual(mainBackground.DecayTree,utils::ParticleTools::MatchByParticleName))
+        else if (matcher.Matches(mainBackground.DecayTree, mainBackground.Signature))
         {
             tree.MCTrue = phSettings.Index_MainBkg;
             trueChannel = mainBackground.Name;
@@ -311,7 +314,7 @@ void triplePi0::ProcessEvent(const ant::TEvent& event, manager_t&)
             bool found = false;
             for (const auto& otherChannel:otherBackgrounds)
             {
-                if (particleTree->IsEqual(otherChannel.DecayTree,utils::ParticleTools::MatchByParticleName))
+                if (matcher.Matches(otherChannel.DecayTree, otherChannel.Signature))
                 {
                     tree.MCTrue = index;
                     trueChannel = otherChannel.Name;
@@ -45,6 +45,15 @@ public:
 
     size_t BufferSize() const { return eventbuffer.size(); }
 
+    /**
+     * @brief OnlyLeadOutBuffered checks if all buffered events were read after the end of a shard
+     * @return true if no event inside the shard is waiting in the buffer
+     */
+    bool OnlyLeadOutBuffered() const {
+        return eventbuffer.empty() ||
+                eventbuffer.front().Event.ShardOverlap == Shard::Overlap_t::LeadOut;
+    }
+
 };
 
 }} // namespace ant::analysis
@@ -0,0 +1,58 @@
+#include "EventCombinatorics.h"
+
+#include "Combinatorics.h"
+
+#include "tree/TEventData.h"
+
+#include "base/std_ext/math.h"
+#include "base/std_ext/memory.h"
+
+#include <numeric>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis::utils;
+
+EventCombinatorics::EventCombinatorics(const TEventData& eventdata_) :
+    eventdata(eventdata_)
+{}
+
+const ParticleTypeList& EventCombinatorics::Particles()
+{
+    if(!particles)
+        particles = std_ext::make_unique<ParticleTypeList>(ParticleTypeList::Make(eventdata.Candidates));
+    return *particles;
+}
+
+const EventCombinatorics::Combinations_t& EventCombinatorics::PhotonCombinations(unsigned n)
+{
+    auto it_combs = photonCombinations.find(n);
+    if(it_combs != photonCombinations.end())
+        return it_combs->second;
+
+    auto& combs = photonCombinations[n];
+    combs.N = n;
+
+    const auto& photons = Photons();
+
+    // combine the indices, so the order is the same as makeCombination(photons, n)
+    vector<unsigned> indices(photons.size());
+    iota(indices.begin(), indices.end(), 0);
+
+    const size_t nCombs = n <= photons.size() ? std_ext::calcNchooseK(int(photons.size()), int(n)) : 0;
+    combs.Indices.reserve(nCombs*n);
+    combs.Sums.reserve(nCombs);
+    combs.IMs.reserve(nCombs);
+
+    for(auto comb = makeCombination(indices, n); !comb.done(); ++comb) {
+        LorentzVec sum;
+        for(auto i : comb) {
+            combs.Indices.push_back(i);
+            sum += *photons[i];
+        }
+        combs.Sums.push_back(sum);
+        combs.IMs.push_back(sum.M());
+    }
+
+    return combs;
+}
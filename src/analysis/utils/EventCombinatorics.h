@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ParticleTools.h"
+
+#include "base/vec/LorentzVec.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ant {
+
+struct TEventData;
+
+namespace analysis {
+namespace utils {
+
+/**
+ * @brief The EventCombinatorics class caches particle lists and photon combinations of one event
+ *
+ * Get it from physics::manager_t::Combinatorics(), then it is shared by all physics classes
+ * processing the same event, and everything is built at most once when first asked for.
+ * Note that the particles are shared as well, so don't modify them.
+ */
+class EventCombinatorics {
+public:
+    explicit EventCombinatorics(const TEventData& eventdata_);
+
+    const TEventData& EventData() const { return eventdata; }
+
+    /**
+     * @brief Particles identified from the candidates with ParticleID::GetDefault()
+     * @return same as ParticleTypeList::Make(EventData().Candidates)
+     */
+    const ParticleTypeList& Particles();
+
+    const TParticleList& Photons() {
+        return Particles().Get(ParticleTypeDatabase::Photon);
+    }
+
+    /**
+     * @brief The Combinations_t struct holds all combinations of N photons as flat arrays,
+     * in the same order as makeCombination(Photons(), N)
+     */
+    struct Combinations_t {
+        unsigned N = 0;
+        std::vector<unsigned>   Indices; // N indices into Photons() for each combination
+        std::vector<LorentzVec> Sums;
+        std::vector<double>     IMs;
+
+        std::size_t size() const { return Sums.size(); }
+        const unsigned* IndicesOf(std::size_t i) const { return Indices.data() + i*N; }
+    };
+
+    const Combinations_t& PhotonCombinations(unsigned n);
+
+protected:
+    const TEventData& eventdata;
+    std::unique_ptr<ParticleTypeList> particles;
+    std::map<unsigned, Combinations_t> photonCombinations;
+};
+
+}}} // namespace ant::analysis::utils
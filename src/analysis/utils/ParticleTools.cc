@@ -267,15 +267,50 @@ bool ParticleTools::MatchByParticleName(const TParticlePtr& a, const ant::Partic
     return a->Type().Name() == b.Name();
 }
 
+std::uint64_t ParticleTools::GetTypeSignature(const TParticleTree_t& ptree)
+{
+    const auto key = [] (const TParticlePtr& p) {
+        return ParticleTypeTreeDatabase::GetSignatureKey(p->Type());
+    };
+    return FlatTree<std::uint64_t>::FromTree(ptree, key).Signature(
+                [] (std::uint64_t k) { return k; });
+}
+
+std::uint64_t ParticleTools::GetTypeSignature(const TParticleFlatTree_t& ptree)
+{
+    return ptree.Signature([] (const TParticlePtr& p) {
+        return ParticleTypeTreeDatabase::GetSignatureKey(p->Type());
+    });
+}
+
 bool ParticleTools::TryFindParticleDatabaseChannel(const TParticleTree_t& ptree, ParticleTypeTreeDatabase::Channel& channel)
 {
-    for(auto ch : ParticleTypeTreeDatabase()) {
-        // channel is of ParticleTypeTreeDatabase::Channel
-        auto db_typetree = ParticleTypeTreeDatabase::Get(ch);
-        if(ptree->IsEqual(db_typetree, utils::ParticleTools::MatchByParticleName)) {
-            channel = ch;
-            return true;
-        }
+    if(!ptree)
+        return false;
+    TypeTreeMatcher matcher(ptree);
+    return ParticleTypeTreeDatabase::TryFind(matcher.Signature, [&matcher] (const ParticleTypeTree& typetree) {
+        return matcher.IsEqual(typetree);
+    }, channel);
+}
+
+ParticleTools::TypeTreeMatcher::TypeTreeMatcher(const TParticleTree_t& ptree) :
+    Signature(ptree ? GetTypeSignature(ptree) : 0),
+    tree(ptree)
+{}
+
+bool ParticleTools::TypeTreeMatcher::Matches(const ParticleTypeTree& typetree, std::uint64_t signature)
+{
+    return signature == Signature && IsEqual(typetree);
+}
+
+bool ParticleTools::TypeTreeMatcher::IsEqual(const ParticleTypeTree& typetree)
+{
+    if(!tree || !typetree)
+        return false;
+    // type trees are sorted by name as well
+    if(!sorted) {
+        sorted = tree->DeepCopy();
+        sorted->Sort(SortParticleByName);
     }
-    return false;
+    return sorted->IsEqual(typetree, MatchByParticleName);
 }
@@ -161,10 +161,45 @@ struct ParticleTools {
 
     static bool MatchByParticleName(const TParticlePtr& a, const ParticleTypeDatabase::Type& b);
 
+    /**
+     * @brief GetTypeSignature hashes the particle types of the tree,
+     * equal to ParticleTypeTreeDatabase::GetSignature of the matching type tree
+     * @note the order of daughters does not matter, the tree does not need to be sorted
+     */
+    static std::uint64_t GetTypeSignature(const TParticleTree_t& ptree);
+    static std::uint64_t GetTypeSignature(const TParticleFlatTree_t& ptree);
+
+    /**
+     * @brief TryFindParticleDatabaseChannel finds the channel in ParticleTypeTreeDatabase matching the tree
+     * @return true if found, channel is set then
+     */
     static bool TryFindParticleDatabaseChannel(
             const TParticleTree_t& ptree,
             ParticleTypeTreeDatabase::Channel& channel);
 
+    /**
+     * @brief The TypeTreeMatcher class compares a particle tree with sorted type trees, such as from ParticleTypeTreeDatabase
+     *
+     * The signatures are compared first, only if they match, a sorted copy
+     * of the particle tree is made once to confirm with IsEqual by particle name.
+     */
+    class TypeTreeMatcher {
+    public:
+        explicit TypeTreeMatcher(const TParticleTree_t& ptree);
+
+        const std::uint64_t Signature;
+
+        /**
+         * @param typetree must be sorted
+         * @param signature of typetree, see ParticleTypeTreeDatabase::GetSignature
+         */
+        bool Matches(const ParticleTypeTree& typetree, std::uint64_t signature);
+        bool IsEqual(const ParticleTypeTree& typetree);
+    private:
+        const TParticleTree_t tree;
+        TParticleTree_t sorted;
+    };
+
 };
 
 }
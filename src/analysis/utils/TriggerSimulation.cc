@@ -5,6 +5,8 @@
 
 #include "base/Logger.h"
 
+#include <numeric>
+
 using namespace std;
 using namespace ant;
 using namespace ant::analysis::utils;
@@ -12,7 +14,13 @@ using namespace ant::analysis::utils;
 TriggerSimulation::TriggerSimulation() :
     config(ExpConfig::Setup::Get().GetTriggerSimuConfig()),
     random_CBESum_threshold(config.CBESum_Edge, config.CBESum_Width)
-{}
+{
+    for(auto ch : config.CBESum_MissingElements) {
+        if(ch >= CBESum_ignored.size())
+            CBESum_ignored.resize(ch+1, false);
+        CBESum_ignored[ch] = true;
+    }
+}
 
 bool TriggerSimulation::ProcessEvent(const TEvent& event)
 {
@@ -28,17 +36,21 @@ bool TriggerSimulation::ProcessEvent(const TEvent& event)
             info.CBTiming = 0;
         }
         else {
-            double TimeEsum = 0.0;
-            double TimeE = 0.0;
+            // gather the CB clusters into flat arrays first,
+            // then the sums below are simple loops over contiguous memory
+            cb_energies.resize(0);
+            cb_times.resize(0);
             for(const auto& cluster : recon.Clusters) {
                 if(cluster.DetectorType != Detector_t::Type_t::CB)
                     continue;
                 // ignore weird clusters
                 if(!cluster.isSane())
                     continue;
-                TimeEsum += cluster.Energy;
-                TimeE += cluster.Energy*cluster.Time;
+                cb_energies.push_back(cluster.Energy);
+                cb_times.push_back(cluster.Time);
             }
+            const double TimeEsum = accumulate(cb_energies.begin(), cb_energies.end(), 0.0);
+            const double TimeE = inner_product(cb_energies.begin(), cb_energies.end(), cb_times.begin(), 0.0);
             info.CBTiming = TimeE/TimeEsum;
         }
     }
@@ -51,7 +63,7 @@ bool TriggerSimulation::ProcessEvent(const TEvent& event)
                 continue;
             if(dethit.ChannelType != Channel_t::Type_t::Integral)
                 continue;
-            if(std_ext::contains(config.CBESum_MissingElements, dethit.Channel))
+            if(dethit.Channel < CBESum_ignored.size() && CBESum_ignored[dethit.Channel])
                 continue;
             // one could also use uncalibrated values
             // with some fixed constant? or average from all gains?
@@ -60,6 +72,8 @@ bool TriggerSimulation::ProcessEvent(const TEvent& event)
         }
     }
 
+    GetCorrectedTaggerTimes(recon.TaggerHits, info.CorrectedTaggerTimes);
+
     if(isMC) {
         if(config.Type == config_t::Type_t::CBESum) {
             // lazy init random generator with timestamp of (first) event
@@ -91,3 +105,11 @@ bool TriggerSimulation::ProcessEvent(const TEvent& event)
 double TriggerSimulation::GetCorrectedTaggerTime(const TTaggerHit& taggerhit) const {
     return taggerhit.Time - GetRefTiming();
 }
+
+void TriggerSimulation::GetCorrectedTaggerTimes(const std::vector<TTaggerHit>& taggerhits, std::vector<double>& times) const
+{
+    const auto refTiming = GetRefTiming();
+    times.resize(taggerhits.size());
+    for(size_t i=0;i<taggerhits.size();i++)
+        times[i] = taggerhits[i].Time - refTiming;
+}
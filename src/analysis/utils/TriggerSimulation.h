@@ -4,6 +4,7 @@
 #include "expconfig/ExpConfig.h"
 
 #include <random>
+#include <vector>
 
 namespace ant {
 
@@ -19,6 +20,7 @@ class TriggerSimulation {
         bool   hasTriggered;
         double CBEnergySum;
         double CBTiming;
+        std::vector<double> CorrectedTaggerTimes;
         info_t() {
             Reset(); // ensure reset on startup
         }
@@ -26,8 +28,9 @@ class TriggerSimulation {
             hasTriggered = false;
             CBEnergySum = std_ext::NaN;
             CBTiming = std_ext::NaN;
+            CorrectedTaggerTimes.clear();
         }
-        bool IsSane() {
+        bool IsSane() const {
             return std::isfinite(CBEnergySum) &&
                     std::isfinite(CBTiming);
         }
@@ -41,6 +44,14 @@ class TriggerSimulation {
     std::unique_ptr<std::default_random_engine> random_gen;
     std::normal_distribution<double> random_CBESum_threshold;
 
+    // CBESum_MissingElements as flags indexed by channel
+    std::vector<bool> CBESum_ignored;
+
+    // energies and times of sane CB clusters,
+    // kept as members to avoid allocations per event
+    std::vector<double> cb_energies;
+    std::vector<double> cb_times;
+
 public:
 
     TriggerSimulation();
@@ -52,6 +63,12 @@ public:
      */
     bool ProcessEvent(const TEvent& event);
 
+    /**
+     * @brief IsSane tells if the last ProcessEvent was successful
+     * @return same as the return value of ProcessEvent
+     */
+    bool IsSane() const { return info.IsSane(); }
+
     /**
      * @brief HasTriggered returns true if the experiment would have accepted this event
      * @return the trigger decision
@@ -78,6 +95,20 @@ public:
      * @note Typically calculated as "Taggertime - RefTiming", but might differ for various beamtimes
      */
     double GetCorrectedTaggerTime(const TTaggerHit& taggerhit) const;
+
+    /**
+     * @brief GetCorrectedTaggerTimes provides the corrected timings of all reconstructed taggerhits
+     * @return corrected tagger timings in ns, same order as event.Reconstructed().TaggerHits
+     * @note calculated once in ProcessEvent, prefer this when looping over all taggerhits
+     */
+    const std::vector<double>& GetCorrectedTaggerTimes() const { return info.CorrectedTaggerTimes; }
+
+    /**
+     * @brief GetCorrectedTaggerTimes corrects the given taggerhits at once
+     * @param taggerhits the taggerhits to be corrected
+     * @param times filled with the corrected timings in ns, same order as taggerhits
+     */
+    void GetCorrectedTaggerTimes(const std::vector<TTaggerHit>& taggerhits, std::vector<double>& times) const;
 };
 
 }
@@ -4,6 +4,8 @@
 #include "base/std_ext/math.h"
 #include "base/std_ext/memory.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace ant;
 
@@ -44,6 +46,22 @@ double ant::ClippedInterpolatorWrapper::boundsCheck_t::clip(double v) const
     return v;
 }
 
+ant::ClippedInterpolatorWrapper::boundsCheck_t::boundsCheck_t(const boundsCheck_t& other) :
+    range(other.range),
+    underflow(other.underflow.load()),
+    unclipped(other.unclipped.load()),
+    overflow(other.overflow.load())
+{}
+
+ant::ClippedInterpolatorWrapper::boundsCheck_t& ant::ClippedInterpolatorWrapper::boundsCheck_t::operator=(const boundsCheck_t& other)
+{
+    range = other.range;
+    underflow = other.underflow.load();
+    unclipped = other.unclipped.load();
+    overflow  = other.overflow.load();
+    return *this;
+}
+
 std::unique_ptr<const Interpolator2D> ClippedInterpolatorWrapper::makeInterpolator(TH2D* hist) {
 
     const unsigned nx = unsigned(hist->GetNbinsX());
@@ -134,7 +152,7 @@ ostream& operator<<(ostream& stream, const ClippedInterpolatorWrapper& o)
 
 ostream& operator<<(ostream& stream, const ClippedInterpolatorWrapper::boundsCheck_t& o)
 {
-    return stream << o.range << "-> [" << o.underflow << "|" << o.unclipped << "|" << o.overflow << "]";
+    return stream << o.range << "-> [" << o.underflow.load() << "|" << o.unclipped.load() << "|" << o.overflow.load() << "]";
 }
 
 } // namespace ant
@@ -146,6 +164,15 @@ double ant::ClippedInterpolatorWrapper::GetPoint(double x, double y) const
     return interp->GetPoint(x,y);
 }
 
+void ant::ClippedInterpolatorWrapper::GetPoints(const vector<double>& x, const vector<double>& y, vector<double>& z) const
+{
+    vector<double> x_clipped(x.size());
+    vector<double> y_clipped(y.size());
+    transform(x.begin(), x.end(), x_clipped.begin(), [this] (double v) { return xrange.clip(v); });
+    transform(y.begin(), y.end(), y_clipped.begin(), [this] (double v) { return yrange.clip(v); });
+    interp->GetPoints(x_clipped, y_clipped, z);
+}
+
 ant::ClippedInterpolatorWrapper::~ClippedInterpolatorWrapper()
 {}
 
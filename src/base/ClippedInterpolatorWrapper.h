@@ -6,6 +6,7 @@
 #include <base/Interpolator.h>
 
 #include <ostream>
+#include <atomic>
 
 class TH2D;
 
@@ -20,13 +21,16 @@ struct ClippedInterpolatorWrapper {
 
     struct boundsCheck_t {
         ant::interval<double> range;
-        mutable unsigned underflow = 0;
-        mutable unsigned unclipped = 0;
-        mutable unsigned overflow  = 0;
+        // atomic, as clipping may happen from several threads
+        mutable std::atomic<unsigned> underflow{0};
+        mutable std::atomic<unsigned> unclipped{0};
+        mutable std::atomic<unsigned> overflow{0};
 
         double clip(double v) const;
 
         boundsCheck_t(const ant::interval<double> r): range(r) {}
+        boundsCheck_t(const boundsCheck_t& other);
+        boundsCheck_t& operator=(const boundsCheck_t& other);
     };
     friend std::ostream& operator<<(std::ostream& stream, const boundsCheck_t& o);
 
@@ -38,6 +42,14 @@ struct ClippedInterpolatorWrapper {
     ~ClippedInterpolatorWrapper();
     double GetPoint(double x, double y) const;
 
+    /**
+     * @brief GetPoints clips all points to the grid and evaluates them at once
+     * @param x coordinates of the points
+     * @param y coordinates of the points, same size as x
+     * @param z resized and filled with the interpolated values
+     */
+    void GetPoints(const std::vector<double>& x, const std::vector<double>& y, std::vector<double>& z) const;
+
     void setInterpolator(interpolator_ptr_t i);
 
     friend std::ostream& operator<<(std::ostream& stream, const ClippedInterpolatorWrapper& o);
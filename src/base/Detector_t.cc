@@ -1,8 +1,12 @@
 #include "Detector_t.h"
 
 #include "base/interval.h"
+#include "base/std_ext/memory.h"
 #include "base/std_ext/string.h"
 
+#include <algorithm>
+#include <cmath>
+#include <set>
 #include <sstream>
 #include <map>
 
@@ -140,15 +144,95 @@ double TaggerDetector_t::GetPhotonEnergyWidth(unsigned channel) const
     }
 }
 
+constexpr unsigned TaggerDetector_t::NoChannel;
+
 bool TaggerDetector_t::TryGetChannelFromPhoton(double photonEnergy, unsigned& channel) const
 {
-    for(channel=0;channel<GetNChannels();++channel) {
-        const auto& i = interval<double>::CenterWidth(
-                            GetPhotonEnergy(channel),
-                            GetPhotonEnergyWidth(channel)
-                            );
-        if(i.Contains(photonEnergy))
-            return true;
-    }
-    return false;
+    channel = GetChannelLookup().Find(photonEnergy);
+    return channel != NoChannel;
+}
+
+void TaggerDetector_t::GetChannelsFromPhotons(const std::vector<double>& photonEnergies,
+                                              std::vector<unsigned>& channels) const
+{
+    const auto& lookup = GetChannelLookup();
+    channels.resize(photonEnergies.size());
+    for(size_t i=0;i<photonEnergies.size();i++)
+        channels[i] = lookup.Find(photonEnergies[i]);
+}
+
+unsigned TaggerDetector_t::channel_lookup_t::Find(double photonEnergy) const
+{
+    // first boundary greater than the energy
+    const auto it = upper_bound(Boundaries.begin(), Boundaries.end(), photonEnergy);
+    if(it == Boundaries.begin())
+        return NoChannel;
+    const auto i = size_t(distance(Boundaries.begin(), it)) - 1;
+    if(Boundaries[i] == photonEnergy)
+        return AtBoundary[i];
+    if(i < Between.size())
+        return Between[i];
+    return NoChannel;
+}
+
+const TaggerDetector_t::channel_lookup_t& TaggerDetector_t::GetChannelLookup() const
+{
+    call_once(channel_lookup_built, [this] () {
+        const auto nChannels = GetNChannels();
+
+        vector<interval<double>> intervals;
+        intervals.reserve(nChannels);
+        for(unsigned ch=0;ch<nChannels;++ch) {
+            intervals.emplace_back(interval<double>::CenterWidth(
+                                       GetPhotonEnergy(ch),
+                                       GetPhotonEnergyWidth(ch)
+                                       ));
+        }
+
+        // intervals with NaN boundaries never contain anything
+        vector<unsigned> byStart;
+        auto lookup = std_ext::make_unique<channel_lookup_t>();
+        auto& boundaries = lookup->Boundaries;
+        for(unsigned ch=0;ch<nChannels;++ch) {
+            const auto& i = intervals[ch];
+            if(!isfinite(i.Start()) || !isfinite(i.Stop()))
+                continue;
+            byStart.emplace_back(ch);
+            boundaries.emplace_back(i.Start());
+            boundaries.emplace_back(i.Stop());
+        }
+        sort(boundaries.begin(), boundaries.end());
+        boundaries.erase(unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+        // sweep over the boundaries and the segments in between in ascending order,
+        // keeping the channels containing the current point in active
+        sort(byStart.begin(), byStart.end(), [&intervals] (unsigned a, unsigned b) {
+            return intervals[a].Start() < intervals[b].Start();
+        });
+        auto nextStart = byStart.begin();
+        set<unsigned> active;
+        set<pair<double, unsigned>> activeByStop;
+
+        auto firstActive = [&] (double x) {
+            while(nextStart != byStart.end() && intervals[*nextStart].Start() <= x) {
+                active.insert(*nextStart);
+                activeByStop.emplace(intervals[*nextStart].Stop(), *nextStart);
+                ++nextStart;
+            }
+            while(!activeByStop.empty() && activeByStop.begin()->first < x) {
+                active.erase(activeByStop.begin()->second);
+                activeByStop.erase(activeByStop.begin());
+            }
+            return active.empty() ? NoChannel : *active.begin();
+        };
+
+        for(size_t i=0;i<boundaries.size();i++) {
+            lookup->AtBoundary.emplace_back(firstActive(boundaries[i]));
+            if(i+1<boundaries.size())
+                lookup->Between.emplace_back(firstActive((boundaries[i]+boundaries[i+1])/2.0));
+        }
+
+        channel_lookup = move(lookup);
+    });
+    return *channel_lookup;
 }
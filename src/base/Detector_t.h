@@ -5,6 +5,9 @@
 #include "base/std_ext/math.h"
 
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -167,8 +170,29 @@ protected:
 struct TaggerDetector_t : Detector_t {
 
     virtual double GetPhotonEnergy(unsigned channel) const = 0;
+
+    /**
+     * @brief TryGetChannelFromPhoton finds the first channel whose energy interval,
+     * given by GetPhotonEnergy and GetPhotonEnergyWidth, contains the photon energy
+     * @param photonEnergy
+     * @param channel set to the found channel
+     * @return true if found
+     *
+     * Uses a table of interval boundaries built on first use, so photon energies
+     * and widths must not change afterwards.
+     */
     bool TryGetChannelFromPhoton(double photonEnergy, unsigned& channel) const;
 
+    static constexpr unsigned NoChannel = std::numeric_limits<unsigned>::max();
+
+    /**
+     * @brief GetChannelsFromPhotons is the batch version of TryGetChannelFromPhoton
+     * @param photonEnergies
+     * @param channels same size as photonEnergies, NoChannel if not found
+     */
+    void GetChannelsFromPhotons(const std::vector<double>& photonEnergies,
+                                std::vector<unsigned>& channels) const;
+
     /**
      * @brief GetPhotonEnergyWidth
      * @param channel
@@ -227,6 +251,19 @@ protected:
         Detector_t(type),
         BeamEnergy(beamEnergy)
     {}
+
+private:
+    // the channel intervals split the energy axis into segments between sorted boundaries,
+    // for each boundary and each segment the first channel containing it is stored
+    struct channel_lookup_t {
+        std::vector<double> Boundaries;
+        std::vector<unsigned> AtBoundary;
+        std::vector<unsigned> Between; // Between[i] is for (Boundaries[i], Boundaries[i+1])
+        unsigned Find(double photonEnergy) const;
+    };
+    mutable std::unique_ptr<const channel_lookup_t> channel_lookup;
+    mutable std::once_flag channel_lookup_built;
+    const channel_lookup_t& GetChannelLookup() const;
 };
 
 inline bool Channel_t::IsIntegral(const Channel_t::Type_t& t) {
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "base/Tree.h"
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstdint>
+
+namespace ant {
+
+/**
+ * @brief The FlatTree class stores a tree in one contiguous array in depth-first order
+ *
+ * Each node knows its parent, its first daughter and its next sibling by index.
+ * As parents always come before their daughters, traversing the whole tree is a plain loop
+ * over the array. Use FromTree/ToTree to convert from/to the shared_ptr-based Tree<T>,
+ * the order of the daughters is kept.
+ */
+template<typename T>
+class FlatTree {
+public:
+
+    using type = T;
+    using tree_t = typename Tree<T>::node_t;
+
+    /// marks a missing parent, daughter or sibling
+    static constexpr std::size_t None = std::numeric_limits<std::size_t>::max();
+
+    FlatTree() = default;
+
+    /**
+     * @brief FromTree converts a Tree into a FlatTree
+     * @param tree the root node, an empty FlatTree is returned for nullptr
+     * @param transform converts the data of each node to T
+     */
+    template<typename U, typename Transform>
+    static FlatTree FromTree(const std::shared_ptr<Tree<U>>& tree, Transform transform) {
+        FlatTree flat;
+        if(tree) {
+            flat.nodes.reserve(tree->Size());
+            flat.add_node(*tree, None, transform);
+        }
+        return flat;
+    }
+
+    static FlatTree FromTree(const tree_t& tree) {
+        return FromTree(tree, [] (const T& data) { return data; });
+    }
+
+    /**
+     * @brief ToTree converts back into a Tree
+     * @return root node, nullptr if the FlatTree is empty
+     */
+    tree_t ToTree() const {
+        if(nodes.empty())
+            return nullptr;
+        std::vector<tree_t> treenodes;
+        treenodes.reserve(nodes.size());
+        for(const auto& n : nodes) {
+            treenodes.emplace_back(Tree<T>::MakeNode(n.Data));
+            if(n.Parent != None)
+                treenodes[n.Parent]->AddDaughter(treenodes.back());
+        }
+        return treenodes.front();
+    }
+
+    std::size_t Size() const { return nodes.size(); }
+    bool Empty() const { return nodes.empty(); }
+
+    T& Get(std::size_t i) { return nodes[i].Data; }
+    const T& Get(std::size_t i) const { return nodes[i].Data; }
+
+    std::size_t Parent(std::size_t i) const { return nodes[i].Parent; }
+    std::size_t FirstDaughter(std::size_t i) const { return nodes[i].FirstDaughter; }
+    std::size_t NextSibling(std::size_t i) const { return nodes[i].NextSibling; }
+
+    bool IsRoot(std::size_t i) const { return nodes[i].Parent == None; }
+    bool IsLeaf(std::size_t i) const { return nodes[i].FirstDaughter == None; }
+
+    std::size_t NumDaughters(std::size_t i) const {
+        std::size_t n = 0;
+        for(auto d = FirstDaughter(i); d != None; d = NextSibling(d))
+            n++;
+        return n;
+    }
+
+    /**
+     * @brief Map runs through the tree depth-first, parents before daughters
+     * @param function applied to the data of each node
+     */
+    template <typename F>
+    void Map(F function) const {
+        for(const auto& n : nodes)
+            function(n.Data);
+    }
+
+    /**
+     * @brief Map_daughters applies function to the data of the direct daughters of node i
+     */
+    template <typename F>
+    void Map_daughters(std::size_t i, F function) const {
+        for(auto d = FirstDaughter(i); d != None; d = NextSibling(d))
+            function(Get(d));
+    }
+
+    /**
+     * @brief Signature calculates a hash of the tree structure and the keys of its nodes
+     * @param key hashes the data of one node, for example the particle type
+     * @return signature of the whole tree, 0 if empty
+     *
+     * The signature does not depend on the order of the daughters, so trees
+     * do not need to be sorted before comparing their signatures.
+     * It is calculated in one pass over the nodes.
+     */
+    template<typename Key>
+    std::uint64_t Signature(Key key) const {
+        if(nodes.empty())
+            return 0;
+        // daughters always come after their parent,
+        // so going backwards sees all daughters before the parent
+        std::vector<std::uint64_t> daughter_sums(nodes.size(), 0);
+        std::uint64_t signature = 0;
+        for(auto i = nodes.size(); i-- > 0;) {
+            signature = mix(mix(std::uint64_t(key(nodes[i].Data))) + daughter_sums[i]);
+            if(nodes[i].Parent != None)
+                daughter_sums[nodes[i].Parent] += mix(signature);
+        }
+        return signature;
+    }
+
+protected:
+
+    struct node_t {
+        T Data;
+        std::size_t Parent;
+        std::size_t FirstDaughter = None;
+        std::size_t NextSibling = None;
+        node_t(T&& data, std::size_t parent) :
+            Data(std::forward<T>(data)), Parent(parent) {}
+    };
+
+    std::vector<node_t> nodes;
+
+    template<typename U, typename Transform>
+    std::size_t add_node(const Tree<U>& treenode, std::size_t parent, Transform& transform) {
+        const auto i = nodes.size();
+        nodes.emplace_back(transform(treenode.Get()), parent);
+        std::size_t last = None;
+        for(const auto& daughter : treenode.Daughters()) {
+            const auto d = add_node(*daughter, i, transform);
+            if(last == None)
+                nodes[i].FirstDaughter = d;
+            else
+                nodes[last].NextSibling = d;
+            last = d;
+        }
+        return i;
+    }
+
+    // finalizer of splitmix64, spreads the bits of the (summed) hashes
+    static std::uint64_t mix(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+};
+
+template<typename T>
+constexpr std::size_t FlatTree<T>::None;
+
+} // namespace ant
@@ -1,54 +1,190 @@
 #include "Interpolator.h"
 
+#include "base/std_ext/math.h"
+
 extern "C" {
-#include "interp2d/interp2d_spline.h"
+#include <gsl/gsl_spline.h>
 }
 
+#include <algorithm>
+
 using namespace std;
 using namespace ant;
 
-struct Interpolator2D::interp2d : ::interp2d {};
-struct Interpolator2D::gsl_interp_accel : ::gsl_interp_accel {};
+namespace {
 
-const interp2d_type* getType(Interpolator2D::Type type) {
-    switch(type) {
-    case Interpolator2D::Type::Bilinear:
-        return interp2d_bilinear;
-    case Interpolator2D::Type::Bicubic:
-        return interp2d_bicubic;
-    }
-    return nullptr;
+// row-major as in interp2d, x is the fast index
+inline size_t index2d(size_t xi, size_t yi, size_t xsize) {
+    return yi*xsize + xi;
 }
 
+// derivatives at the grid points of the natural cubic spline through the values,
+// the values are read from/the derivatives written to data[offset + i*stride]
+void spline_derivatives(const vector<double>& grid,
+                        const vector<double>& data, vector<double>& derivs,
+                        size_t offset, size_t stride)
+{
+    const auto n = grid.size();
+    vector<double> values(n);
+    for(size_t i=0;i<n;i++)
+        values[i] = data[offset + i*stride];
+
+    unique_ptr<gsl_spline, void(*)(gsl_spline*)> spline(
+                gsl_spline_alloc(gsl_interp_cspline, n), gsl_spline_free);
+    gsl_spline_init(spline.get(), grid.data(), values.data(), n);
+    for(size_t i=0;i<n;i++)
+        derivs[offset + i*stride] = gsl_spline_eval_deriv(spline.get(), grid[i], nullptr);
+}
+
+}
 
 Interpolator2D::Interpolator2D(const std::vector<double>& x,
                                const std::vector<double>& y,
                                const std::vector<double>& z,
                                Type type) :
-    X(x), Y(y), Z(z),
-    interp(static_cast<interp2d*>(
-               interp2d_alloc(getType(type), X.size(), Y.size())
-               ), interp2d_free),
-    xa(static_cast<gsl_interp_accel*>(gsl_interp_accel_alloc()), gsl_interp_accel_free),
-    ya(static_cast<gsl_interp_accel*>(gsl_interp_accel_alloc()), gsl_interp_accel_free)
-{
-    if(X.size()*Y.size() != Z.size())
+    X(x), Y(y)
+{
+    if(X.size()*Y.size() != z.size())
         throw Exception("X*Y grid must match to Z values");
-    interp2d_init(interp.get(), X.data(), Y.data(), Z.data(), X.size(), Y.size());
+
+    const size_t min_size = type == Type::Bicubic ? 4 : 2;
+    if(X.size() < min_size || Y.size() < min_size)
+        throw Exception("Insufficient number of grid points for interpolation type");
+
+    for(auto grid : {&X, &Y}) {
+        if(adjacent_find(grid->begin(), grid->end(), greater_equal<double>()) != grid->end())
+            throw Exception("Grid points must be strictly ascending");
+    }
+
+    const auto nx = X.size();
+    const auto ny = Y.size();
+
+    // derivatives at the grid points, only needed for bicubic
+    vector<double> zx(z.size(), 0.0);
+    vector<double> zy(z.size(), 0.0);
+    vector<double> zxy(z.size(), 0.0);
+    if(type == Type::Bicubic) {
+        for(size_t j=0;j<ny;j++)
+            spline_derivatives(X, z, zx, index2d(0, j, nx), 1);
+        for(size_t i=0;i<nx;i++)
+            spline_derivatives(Y, z, zy, index2d(i, 0, nx), nx);
+        for(size_t j=0;j<ny;j++)
+            spline_derivatives(X, zy, zxy, index2d(0, j, nx), 1);
+    }
+
+    coefficients.resize(16*(nx-1)*(ny-1));
+    for(size_t yi=0;yi<ny-1;yi++) {
+        for(size_t xi=0;xi<nx-1;xi++) {
+            const double dx = X[xi+1] - X[xi];
+            const double dy = Y[yi+1] - Y[yi];
+
+            // values and derivatives (in cell units) at the corners,
+            // m/M denotes the lower/upper grid point in x and y
+            const auto i_mm = index2d(xi,   yi,   nx);
+            const auto i_mM = index2d(xi,   yi+1, nx);
+            const auto i_Mm = index2d(xi+1, yi,   nx);
+            const auto i_MM = index2d(xi+1, yi+1, nx);
+
+            const double zmm = z[i_mm], zmM = z[i_mM], zMm = z[i_Mm], zMM = z[i_MM];
+            const double xmm = zx[i_mm]*dx, xmM = zx[i_mM]*dx, xMm = zx[i_Mm]*dx, xMM = zx[i_MM]*dx;
+            const double ymm = zy[i_mm]*dy, ymM = zy[i_mM]*dy, yMm = zy[i_Mm]*dy, yMM = zy[i_MM]*dy;
+            const double dxdy = dx*dy;
+            const double xymm = zxy[i_mm]*dxdy, xymM = zxy[i_mM]*dxdy, xyMm = zxy[i_Mm]*dxdy, xyMM = zxy[i_MM]*dxdy;
+
+            double* c = addressof(coefficients[16*index2d(xi, yi, nx-1)]);
+
+            if(type == Type::Bilinear) {
+                c[0] = zmm;
+                c[1] = zmM - zmm;
+                c[4] = zMm - zmm;
+                c[5] = zmm - zMm - zmM + zMM;
+                continue;
+            }
+
+            // bicubic Hermite patch, same as interp2d's bicubic_eval
+            c[ 0] = zmm;
+            c[ 1] = ymm;
+            c[ 2] = -3*zmm + 3*zmM - 2*ymm - ymM;
+            c[ 3] = 2*zmm - 2*zmM + ymm + ymM;
+            c[ 4] = xmm;
+            c[ 5] = xymm;
+            c[ 6] = -3*xmm + 3*xmM - 2*xymm - xymM;
+            c[ 7] = 2*xmm - 2*xmM + xymm + xymM;
+            c[ 8] = -3*zmm + 3*zMm - 2*xmm - xMm;
+            c[ 9] = -3*ymm + 3*yMm - 2*xymm - xyMm;
+            c[10] = 9*zmm - 9*zMm + 9*zMM - 9*zmM + 6*xmm + 3*xMm - 3*xMM - 6*xmM
+                    + 6*ymm - 6*yMm - 3*yMM + 3*ymM + 4*xymm + 2*xyMm + xyMM + 2*xymM;
+            c[11] = -6*zmm + 6*zMm - 6*zMM + 6*zmM - 4*xmm - 2*xMm + 2*xMM + 4*xmM
+                    - 3*ymm + 3*yMm + 3*yMM - 3*ymM - 2*xymm - xyMm - xyMM - 2*xymM;
+            c[12] = 2*zmm - 2*zMm + xmm + xMm;
+            c[13] = 2*ymm - 2*yMm + xymm + xyMm;
+            c[14] = -6*zmm + 6*zMm - 6*zMM + 6*zmM - 3*xmm - 3*xMm + 3*xMM + 3*xmM
+                    - 4*ymm + 4*yMm + 2*yMM - 2*ymM - 2*xymm - 2*xyMm - xyMM - xymM;
+            c[15] = 4*zmm - 4*zMm + 4*zMM - 4*zmM + 2*xmm + 2*xMm - 2*xMM - 2*xmM
+                    + 2*ymm - 2*yMm - 2*yMM + 2*ymM + xymm + xyMm + xyMM + xymM;
+        }
+    }
+}
+
+size_t Interpolator2D::findCell(const vector<double>& grid, double v)
+{
+    // cell i contains grid[i] <= v < grid[i+1], the last cell includes its upper edge
+    const size_t i = size_t(upper_bound(grid.begin(), grid.end(), v) - grid.begin());
+    return min(i == 0 ? 0 : i-1, grid.size()-2);
+}
+
+double Interpolator2D::evalCell(size_t xi, size_t yi, double x, double y) const
+{
+    const double t = (x - X[xi])/(X[xi+1] - X[xi]);
+    const double u = (y - Y[yi])/(Y[yi+1] - Y[yi]);
+    const double* c = addressof(coefficients[16*index2d(xi, yi, X.size()-1)]);
+    double z = 0;
+    for(int i=3;i>=0;i--) {
+        const double* ci = c + 4*i;
+        z = z*t + (((ci[3]*u + ci[2])*u + ci[1])*u + ci[0]);
+    }
+    return z;
 }
 
 double Interpolator2D::GetPoint(double x, double y) const
 {
-    return interp2d_eval(interp.get(), X.data(), Y.data(), Z.data(), x, y,
-                         xa.get(), ya.get());
+    // also false for NaN
+    if(!(x >= X.front() && x <= X.back() && y >= Y.front() && y <= Y.back()))
+        return std_ext::NaN;
+    return evalCell(findCell(X, x), findCell(Y, y), x, y);
+}
+
+void Interpolator2D::GetPoints(const vector<double>& x, const vector<double>& y, vector<double>& z) const
+{
+    if(x.size() != y.size())
+        throw Exception("Number of x and y coordinates must match");
+
+    z.resize(x.size());
+
+    // neighbouring points often fall into the same cell, so check the last one first
+    size_t xi = 0;
+    size_t yi = 0;
+    for(size_t k=0;k<x.size();k++) {
+        const double xk = x[k];
+        const double yk = y[k];
+        if(!(xk >= X.front() && xk <= X.back() && yk >= Y.front() && yk <= Y.back())) {
+            z[k] = std_ext::NaN;
+            continue;
+        }
+        if(!(X[xi] <= xk && xk < X[xi+1]))
+            xi = findCell(X, xk);
+        if(!(Y[yi] <= yk && yk < Y[yi+1]))
+            yi = findCell(Y, yk);
+        z[k] = evalCell(xi, yi, xk, yk);
+    }
 }
 
 interval<double> Interpolator2D::getXRange() const
 {
-    return { interp->xmin, interp->xmax };
+    return { X.front(), X.back() };
 }
 
 interval<double> Interpolator2D::getYRange() const
 {
-    return { interp->ymin, interp->ymax };
+    return { Y.front(), Y.back() };
 }
@@ -8,19 +8,46 @@
 
 namespace ant {
 
+/**
+ * @brief The Interpolator2D class interpolates values given on a rectangular grid
+ *
+ * The polynomial coefficients of each grid cell are calculated once in the constructor,
+ * evaluating does not modify any state, so one instance can be used from several threads.
+ */
 class Interpolator2D {
 public:
     enum class Type {
         Bilinear, Bicubic
     };
 
+    /**
+     * @brief Interpolator2D
+     * @param x grid points, ascending
+     * @param y grid points, ascending
+     * @param z values, z[i + j*x.size()] belongs to x[i],y[j]
+     * @param type Bicubic uses natural cubic splines for the derivatives at the grid points
+     */
     Interpolator2D(const std::vector<double>& x,
                    const std::vector<double>& y,
                    const std::vector<double>& z,
                    Type type = Type::Bicubic);
 
+    /**
+     * @brief GetPoint evaluates the interpolation at x,y
+     * @return interpolated value, NaN if outside the grid
+     */
     double GetPoint(double x, double y) const;
 
+    /**
+     * @brief GetPoints evaluates the interpolation at many points at once
+     * @param x coordinates of the points
+     * @param y coordinates of the points, same size as x
+     * @param z resized and filled with the interpolated values, NaN if outside the grid
+     */
+    void GetPoints(const std::vector<double>& x,
+                   const std::vector<double>& y,
+                   std::vector<double>& z) const;
+
     struct Exception : std::runtime_error {
         using std::runtime_error::runtime_error; // use base class constructor
     };
@@ -33,17 +60,13 @@ private:
 
     const std::vector<double> X;
     const std::vector<double> Y;
-    const std::vector<double> Z;
-
-    template<typename T>
-    using deleted_unique_ptr = std::unique_ptr<T, std::function<void(T*)>>;
 
-    struct interp2d;
-    deleted_unique_ptr<interp2d> interp;
+    // polynomial in the cell coordinates t,u in [0,1],
+    // 16 coefficients per cell, coefficients[16*cell + 4*i + j] belongs to t^i*u^j
+    std::vector<double> coefficients;
 
-    struct gsl_interp_accel;
-    deleted_unique_ptr<gsl_interp_accel> xa;
-    deleted_unique_ptr<gsl_interp_accel> ya;
+    static std::size_t findCell(const std::vector<double>& grid, double v);
+    double evalCell(std::size_t xi, std::size_t yi, double x, double y) const;
 };
 
 }
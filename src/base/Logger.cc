@@ -3,6 +3,8 @@
 #include "TError.h"
 #include "gsl/gsl_errno.h"
 #include <sstream>
+#include <mutex>
+#include <atomic>
 
 // setup the logger, will be compiled as a little library
 INITIALIZE_EASYLOGGINGPP
@@ -10,6 +12,42 @@ INITIALIZE_EASYLOGGINGPP
 using namespace std;
 using namespace ant::logger;
 
+static void log_root_message(int level, const char* location, const char* msg) {
+    if (level < gErrorIgnoreLevel)
+        return;
+
+    // somehow ROOT issues a very strange warning
+    // when using gROOT->FindObjectAny (called in ant::canvas::FindTCanvas to search for TCanvas)
+    if(level == kWarning &&
+       string(location) == "TClass::TClass" &&
+       string(msg) == "no dictionary for class iterator<bidirectional_iterator_tag,TObject*,long,const TObject**,const TObject*&> is available")
+        return; // ignore it for now
+
+    if(level == kWarning &&
+       string(location) == "TTree::Bronch" &&
+       string(msg) == "Using split mode on a class: TLorentzVector with a custom Streamer")
+        return; // ignore it for now
+
+    if(level == kWarning &&
+       string(location) == "TTree::Bronch" &&
+       string(msg) == "Using split mode on a class: TVector2 with a custom Streamer")
+        return; // ignore it for now
+
+
+    stringstream ss;
+    ss << "ROOT<" << location << ">: " << msg;
+    if(level < kInfo) { LOG(INFO) << ss.str(); }
+    else if(level == kInfo) { LOG(INFO) << ss.str(); }
+    else if(level == kWarning) { LOG(WARNING) << ss.str(); }
+    else {
+        LOG(ERROR) << ss.str();
+        if(DebugInfo::nProcessedEvents>=0)
+            LOG(DEBUG) << "nProcessEvents=" << DebugInfo::nProcessedEvents;
+        if(DebugInfo::nUnpackedBuffers>=0)
+            LOG(DEBUG) << "nUnpackedBuffers=" << DebugInfo::nUnpackedBuffers;
+    }
+}
+
 void SetupLogger(int argc, char* argv[]) {
     START_EASYLOGGINGPP(argc, argv);
     SetupLogger();
@@ -33,44 +71,55 @@ void SetupLogger() {
                     int level, Bool_t, const char *location,
                     const char *msg) {
         // Bool_t is abort, not used for now...
-
-        if (level < gErrorIgnoreLevel)
-            return;
-
-        // somehow ROOT issues a very strange warning
-        // when using gROOT->FindObjectAny (called in ant::canvas::FindTCanvas to search for TCanvas)
-        if(level == kWarning &&
-           string(location) == "TClass::TClass" &&
-           string(msg) == "no dictionary for class iterator<bidirectional_iterator_tag,TObject*,long,const TObject**,const TObject*&> is available")
-            return; // ignore it for now
-
-        if(level == kWarning &&
-           string(location) == "TTree::Bronch" &&
-           string(msg) == "Using split mode on a class: TLorentzVector with a custom Streamer")
-            return; // ignore it for now
-
-        if(level == kWarning &&
-           string(location) == "TTree::Bronch" &&
-           string(msg) == "Using split mode on a class: TVector2 with a custom Streamer")
-            return; // ignore it for now
-
-
-        stringstream ss;
-        ss << "ROOT<" << location << ">: " << msg;
-        if(level < kInfo) { LOG(INFO) << ss.str(); }
-        else if(level == kInfo) { LOG(INFO) << ss.str(); }
-        else if(level == kWarning) { LOG(WARNING) << ss.str(); }
-        else {
-            LOG(ERROR) << ss.str();
-            if(DebugInfo::nProcessedEvents>=0)
-                LOG(DEBUG) << "nProcessEvents=" << DebugInfo::nProcessedEvents;
-            if(DebugInfo::nUnpackedBuffers>=0)
-                LOG(DEBUG) << "nUnpackedBuffers=" << DebugInfo::nUnpackedBuffers;
-        }
-
+        log_root_message(level, location, msg);
     });
 }
 
 long long DebugInfo::nProcessedEvents = -1;
 int DebugInfo::nUnpackedBuffers = -1;
 
+
+// the handler collecting the messages is only installed while
+// any ROOTMessages instance exists, on any thread
+static thread_local ROOTMessages* current_messages = nullptr;
+static mutex handler_mutex;
+static unsigned handler_users = 0;
+static atomic<ErrorHandlerFunc_t> prev_handler(nullptr);
+
+static void collect_root_message(int level, Bool_t abort, const char* location, const char* msg) {
+    if(current_messages) {
+        current_messages->Messages.push_back({level, static_cast<bool>(abort),
+                                              location ? location : "", msg ? msg : ""});
+        return;
+    }
+    const auto handler = prev_handler.load();
+    if(handler)
+        handler(level, abort, location, msg);
+    else
+        DefaultErrorHandler(level, abort, location, msg);
+}
+
+ROOTMessages::ROOTMessages() :
+    prev(current_messages)
+{
+    lock_guard<mutex> lock(handler_mutex);
+    if(handler_users++ == 0) {
+        prev_handler = GetErrorHandler();
+        SetErrorHandler(collect_root_message);
+    }
+    current_messages = this;
+}
+
+ROOTMessages::~ROOTMessages()
+{
+    current_messages = prev;
+    lock_guard<mutex> lock(handler_mutex);
+    if(--handler_users == 0)
+        SetErrorHandler(prev_handler.load());
+}
+
+void ROOTMessages::Log(const vector<message_t>& messages)
+{
+    for(const auto& m : messages)
+        log_root_message(m.Level, m.Location.c_str(), m.Msg.c_str());
+}
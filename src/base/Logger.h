@@ -4,6 +4,8 @@
 #define ELPP_STL_LOGGING
 #define ELPP_DISABLE_DEFAULT_CRASH_HANDLING
 #define ELPP_NO_DEFAULT_LOG_FILE
+// worker threads log as well, for example when unpacking in parallel (see UnpackerAcqu::Parallel)
+#define ELPP_THREAD_SAFE
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
@@ -20,6 +22,9 @@
 #endif
 #pragma GCC diagnostic pop
 
+#include <string>
+#include <vector>
+
 void SetupLogger(int argc, char* argv[]);
 void SetupLogger();
 
@@ -36,5 +41,35 @@ struct DebugInfo {
     static long long nProcessedEvents;
 };
 
+/**
+ * @brief The ROOTMessages class collects the messages ROOT issues on the creating thread during its lifetime
+ *
+ * The ROOT error handler installed by SetupLogger uses the logger, which is not thread-safe. Messages
+ * of other threads still go to that handler, so the global handler does not need to be swapped.
+ */
+class ROOTMessages {
+public:
+    struct message_t {
+        int Level;
+        bool Abort;
+        std::string Location;
+        std::string Msg;
+    };
+    std::vector<message_t> Messages;
+
+    ROOTMessages();
+    ~ROOTMessages();
+    ROOTMessages(const ROOTMessages&) = delete;
+    ROOTMessages& operator=(const ROOTMessages&) = delete;
+
+    /**
+     * @brief Log reports the messages like the handler installed by SetupLogger, call on the main thread only
+     */
+    static void Log(const std::vector<message_t>& messages);
+
+private:
+    ROOTMessages* const prev;
+};
+
 }}
 
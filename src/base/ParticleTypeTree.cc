@@ -1,6 +1,9 @@
 #include "ParticleTypeTree.h"
+#include "FlatTree.h"
 
 #include <stdexcept>
+#include <unordered_map>
+#include <functional>
 
 using namespace std;
 using namespace ant;
@@ -25,6 +28,71 @@ ParticleTypeTree ParticleTypeTreeDatabase::Get(ParticleTypeTreeDatabase::Channel
     return it->second;
 }
 
+std::uint64_t ParticleTypeTreeDatabase::GetSignatureKey(const ParticleTypeDatabase::Type& type)
+{
+    return std::hash<string>()(type.Name());
+}
+
+std::uint64_t ParticleTypeTreeDatabase::GetSignature(const ParticleTypeTree& tree)
+{
+    return FlatTree<std::uint64_t>::FromTree(tree, GetSignatureKey).Signature(
+                [] (std::uint64_t k) { return k; });
+}
+
+bool ParticleTypeTreeDatabase::TryFind(const ParticleTypeTree& tree, Channel& channel)
+{
+    if(!tree)
+        return false;
+
+    // IsEqual needs both trees sorted, so a sorted copy
+    // is only made once the signature is found
+    ParticleTypeTree sorted;
+    auto isEqual = [&tree, &sorted] (const ParticleTypeTree& other) {
+        if(!sorted) {
+            sorted = tree->DeepCopy();
+            sorted->Sort();
+        }
+        return sorted->IsEqual(other, [] (const ParticleTypeDatabase::Type& a,
+                                          const ParticleTypeDatabase::Type& b) {
+            return a.Name() == b.Name();
+        });
+    };
+    return TryFind(GetSignature(tree), isEqual, channel);
+}
+
+bool ParticleTypeTreeDatabase::TryFind(std::uint64_t signature,
+                                       const std::function<bool(const ParticleTypeTree&)>& isEqual,
+                                       Channel& channel)
+{
+    // built once on first use, the database is complete at that point
+    static const auto signatures = [] () {
+        unordered_map<std::uint64_t, Channel> signatures;
+        // emplace keeps the first channel if trees are identical,
+        // as looping over all channels did before
+        for(const auto& item : database)
+            signatures.emplace(GetSignature(item.second), item.first);
+        return signatures;
+    }();
+
+    auto it = signatures.find(signature);
+    if(it == signatures.end())
+        return false;
+    // Get sorts the database
+    if(isEqual(Get(it->second))) {
+        channel = it->second;
+        return true;
+    }
+
+    // the signatures collide, so compare against all channels
+    for(const auto& item : database) {
+        if(isEqual(item.second)) {
+            channel = item.first;
+            return true;
+        }
+    }
+    return false;
+}
+
 // this little tuple maker is hopefully not a trouble maker :)
 template<typename... Types>
 std::tuple<typename std::decay<Types>::type...> to(Types&&... types) {
@@ -4,6 +4,8 @@
 #include "Tree.h"
 
 #include <map>
+#include <cstdint>
+#include <functional>
 
 namespace ant {
 
@@ -64,6 +66,38 @@ public:
 
     static ParticleTypeTree Get(Channel channel);
 
+    /**
+     * @brief GetSignatureKey hashes the name of the type,
+     * same notion of equality as ParticleTools::MatchByParticleName
+     */
+    static std::uint64_t GetSignatureKey(const ParticleTypeDatabase::Type& type);
+
+    /**
+     * @brief GetSignature calculates the FlatTree::Signature of the type tree
+     * @note the tree does not need to be sorted, the order of daughters does not matter
+     */
+    static std::uint64_t GetSignature(const ParticleTypeTree& tree);
+
+    /**
+     * @brief TryFind looks up the channel of the given tree by its signature,
+     * a found channel is confirmed with IsEqual by particle name
+     * @param tree does not need to be sorted
+     * @param channel set to the found channel
+     * @return true if found
+     */
+    static bool TryFind(const ParticleTypeTree& tree, Channel& channel);
+
+    /**
+     * @brief TryFind looks up the channel by the signature of some tree, such as a particle tree
+     * @param signature of the tree, see GetSignature
+     * @param isEqual confirms a found channel by comparing the tree with the channel's sorted tree
+     * @param channel set to the found channel
+     * @return true if found
+     */
+    static bool TryFind(std::uint64_t signature,
+                        const std::function<bool(const ParticleTypeTree&)>& isEqual,
+                        Channel& channel);
+
 protected:
     using database_t = std::map<Channel, ParticleTypeTree>;
     static database_t database;
@@ -11,6 +11,22 @@ extern "C" {
 using namespace std;
 using namespace ant;
 
+namespace {
+
+// for edge cases, mirror the point index as follows:
+// ... y[2] y[1] y[0] y[1] .... y[n-2] y[n-1] y[n] y[n+1] ...
+size_t mirror(int i, size_t n) {
+    if(i<0)
+        i = -i;
+    else if(unsigned(i)>=n)
+        i = int(n)-(i-int(n))-2;
+    if(i<0 || unsigned(i)>=n)
+        throw out_of_range("Window of SavitzkyGolay too large for number of points");
+    return size_t(i);
+}
+
+}
+
 // little trick to forward declare gsl_matrix, which is a POD
 struct SavitzkyGolay::gsl_matrix : ::gsl_matrix {};
 
@@ -25,10 +41,20 @@ SavitzkyGolay::SavitzkyGolay(int window_left, int window_right, int polynom_orde
     n_l(window_left),
     n_r(window_right),
     m(polynom_order),
-    h(MakeH(n_l,n_r,m))
+    coefficients(MakeCoefficients(n_l,n_r,m))
 {
 }
 
+vector<double> SavitzkyGolay::MakeCoefficients(int n_l, int n_r, int m)
+{
+    const auto h = MakeH(n_l, n_r, m);
+    const auto points = n_l + n_r + 1;
+    vector<double> coefficients(points);
+    for(int k=0;k<points;k++)
+        coefficients[k] = ::gsl_matrix_get(h, n_l, k);
+    return coefficients;
+}
+
 SavitzkyGolay::gsl_unique_ptr<SavitzkyGolay::gsl_matrix> SavitzkyGolay::MakeH(int n_l, int n_r, int m)
 {
     const auto points = n_l + n_r + 1;
@@ -90,33 +116,53 @@ SavitzkyGolay::gsl_unique_ptr<SavitzkyGolay::gsl_matrix> SavitzkyGolay::MakeH(in
 vector<double> SavitzkyGolay::Smooth(const vector<double>& y) const
 {
     const int points = n_l + n_r + 1;
+    const int d_n = y.size();
+    vector<double> result(d_n);
 
-    // for edge cases, mirror the input y as follows:
-    // ... y[2] y[1] y[0] y[1] .... y[n-2] y[n-1] y[n] y[n+1] ...
-    auto get_y = [&y] (const int i) {
-        if(i<0)
-            return y.at(-i);
-        if(unsigned(i)>=y.size()) {
-            const auto i_ = y.size()-(i-y.size())-2;
-            return y.at(i_);
-        }
-        return y[i];
+    // only the points at the edges need mirrored values
+    auto convolute_edge = [this, points, &y, &result] (const int i) {
+        double convolution = 0.0;
+        for (int k = 0; k < points; k++)
+            convolution += coefficients[k] * y[mirror(i - n_l + k, y.size())];
+        result[i] = convolution;
     };
 
-    const int d_n = y.size();
-    vector<double> result(d_n);
-    for (int i = 0; i < d_n; i++){
+    const int inner_begin = min(n_l, d_n);
+    const int inner_end = max(d_n - n_r, inner_begin);
+
+    for (int i = 0; i < inner_begin; i++)
+        convolute_edge(i);
+
+    for (int i = inner_begin; i < inner_end; i++){
+        const double* y_i = addressof(y[i - n_l]);
         double convolution = 0.0;
         for (int k = 0; k < points; k++)
-            convolution += gsl_matrix_get(h, n_l, k) * get_y(i - n_l + k);
+            convolution += coefficients[k] * y_i[k];
         result[i] = convolution;
     }
 
+    for (int i = inner_end; i < d_n; i++)
+        convolute_edge(i);
+
     return result;
 }
 
-double SavitzkyGolay::gsl_matrix_get(const gsl_matrix* m, const size_t i, const size_t j)
+vector<double> SavitzkyGolay::SmoothChannels(const vector<double>& y, size_t n_channels) const
 {
-    return ::gsl_matrix_get(m, i, j);
-}
+    if(n_channels == 0 || y.size() % n_channels != 0)
+        throw Exception("Size of values must be a multiple of the number of channels");
 
+    const int points = n_l + n_r + 1;
+    const size_t d_n = y.size() / n_channels;
+    vector<double> result(y.size(), 0.0);
+
+    for (size_t i = 0; i < d_n; i++){
+        double* result_i = addressof(result[i*n_channels]);
+        for (int k = 0; k < points; k++) {
+            const auto i_ = mirror(int(i) - n_l + k, d_n);
+            add_scaled(coefficients[k], addressof(y[i_*n_channels]), result_i, n_channels);
+        }
+    }
+
+    return result;
+}
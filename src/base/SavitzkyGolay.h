@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include <stdexcept>
 
 namespace ant {
 
@@ -16,24 +17,48 @@ struct SavitzkyGolay {
 
     std::vector<double> Smooth(const std::vector<double>& y) const;
 
+    /**
+     * @brief SmoothChannels smoothes many channels at once
+     * @param y values of all channels at all points, y[i*n_channels + ch] is point i of channel ch
+     * @param n_channels number of channels, the size of y must be a multiple of it
+     * @return smoothed values in the same layout as y
+     *
+     * Each channel is smoothed along the points as by Smooth(), but the inner loops
+     * run over the contiguous channels, which is much faster than smoothing each channel separately.
+     */
+    std::vector<double> SmoothChannels(const std::vector<double>& y, std::size_t n_channels) const;
+
     template<typename GetY, typename SetY>
     void Convolute(const GetY& getY, const SetY& setY,
                    const interval<int>& range) const
     {
         double convolution = 0.0;
         const auto points = n_l + n_r + 1;
-        for (int k = 0; k < points; k++) {
-            auto i = k - n_l; // i runs from -n_l to n_r (inclusive), -n_l <= i <= n_r
-
-            // do some wrap around to keep it in range
-            if(i<range.Start())
-                i = range.Start() + (range.Start() - i);
-            else if(i>range.Stop())
-                i = range.Stop()  - (i - range.Stop() );
+        for (int k = 0; k < points; k++)
+            convolution += coefficients[k] * getY(wrap(k - n_l, range));
+        setY(convolution); // implicitly assume i=0
+    }
 
-            convolution += gsl_matrix_get(h, n_l, k) * getY(i);
+    /**
+     * @brief ConvoluteRows smoothes many channels at once at relative point i=0
+     * @param getRow returns the values of all channels at relative point i as std::vector<double>,
+     * all rows must have the same size
+     * @param range of available relative points, inclusive
+     * @param result set to the smoothed values of all channels
+     */
+    template<typename GetRow>
+    void ConvoluteRows(const GetRow& getRow, const interval<int>& range,
+                       std::vector<double>& result) const
+    {
+        const auto points = n_l + n_r + 1;
+        for (int k = 0; k < points; k++) {
+            const std::vector<double>& row = getRow(wrap(k - n_l, range));
+            if(k == 0)
+                result.assign(row.size(), 0.0);
+            else if(row.size() != result.size())
+                throw Exception("All rows must have the same size");
+            add_scaled(coefficients[k], row.data(), result.data(), result.size());
         }
-        setY(convolution); // implicitly assume i=0
     }
 
     struct Exception : std::runtime_error {
@@ -54,11 +79,26 @@ protected:
     };
 
     struct gsl_matrix;
-    const gsl_unique_ptr<gsl_matrix> h;
     static gsl_unique_ptr<gsl_matrix> MakeH(int n_l, int n_r, int m);
 
-    // define wrapper for above templated Convolute method
-    static double gsl_matrix_get(const gsl_matrix* m, const size_t i, const size_t j);
+    // the row of H for the smoothed point, one coefficient per point in the window
+    const std::vector<double> coefficients;
+    static std::vector<double> MakeCoefficients(int n_l, int n_r, int m);
+
+    // mirror relative index i at the borders of range
+    static int wrap(int i, const interval<int>& range) {
+        if(i<range.Start())
+            return range.Start() + (range.Start() - i);
+        if(i>range.Stop())
+            return range.Stop()  - (i - range.Stop() );
+        return i;
+    }
+
+    // result[j] += c*y[j], simple enough to be vectorized by the compiler
+    static void add_scaled(double c, const double* y, double* result, std::size_t n) {
+        for(std::size_t j=0;j<n;j++)
+            result[j] += c*y[j];
+    }
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,37 @@
+#include "Shard.h"
+
+#include "base/std_ext/string.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace ant;
+
+Shard::Shard(unsigned index, unsigned count) :
+    Index(index), Count(count)
+{
+    if(Count == 0)
+        throw Exception("Number of shards must be positive");
+    if(Index >= Count)
+        throw Exception(std_ext::formatter() << "Shard index " << Index << " not smaller than number of shards " << Count);
+}
+
+Shard Shard::Parse(const string& spec)
+{
+    istringstream ss(spec);
+    unsigned index = 0;
+    unsigned count = 0;
+    char slash = 0;
+    if(!(ss >> index >> slash >> count) || slash != '/' || ss.peek() != char_traits<char>::eof())
+        throw Exception(std_ext::formatter() << "Cannot parse shard spec '" << spec << "', expected i/N");
+    return Shard(index, count);
+}
+
+interval<long long> Shard::GetRange(long long n) const
+{
+    // distribute the remainder evenly over the first shards
+    const auto boundary = [n, this] (long long i) {
+        return i*(n/Count) + std::min<long long>(i, n % Count);
+    };
+    return {boundary(Index), boundary(Index+1)};
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "base/interval.h"
+
+#include <string>
+#include <stdexcept>
+#include <ostream>
+#include <cstdint>
+
+namespace ant {
+
+/**
+ * @brief The Shard struct describes the i-th of N contiguous parts of some input
+ *
+ * Readers and unpackers use it to restrict themselves to their part of the input,
+ * see Ant's --shard option. The part boundaries are given in units which
+ * the reader can seek to cheaply, for example tree entries or Acqu data buffers.
+ */
+struct Shard {
+
+    unsigned Index = 0;
+    unsigned Count = 1;
+
+    Shard() = default;
+    Shard(unsigned index, unsigned count);
+
+    /**
+     * @brief Parse creates a shard from spec "i/N" with 0 <= i < N
+     * @param spec the string to be parsed
+     * @return the shard
+     * @throw Exception if spec is malformed
+     */
+    static Shard Parse(const std::string& spec);
+
+    /**
+     * @brief IsTrivial tells if this shard spans the whole input
+     */
+    bool IsTrivial() const { return Count == 1; }
+
+    /**
+     * @brief GetRange splits n items into Count parts of nearly equal size
+     * @param n total number of items
+     * @return half-open interval [Start,Stop) of items belonging to this shard
+     */
+    interval<long long> GetRange(long long n) const;
+
+    /**
+     * @brief The Overlap_t enum marks events which are read outside of the shard's range
+     *
+     * Such events are only used to complete slowcontrol information at the edges of the shard,
+     * but are never analysed or saved, such that the outputs of all shards merge into
+     * the result of an unsharded run.
+     */
+    enum class Overlap_t : std::uint8_t {
+        None,    // inside the shard
+        LeadIn,  // before the shard start
+        LeadOut, // after the shard stop
+    };
+
+    friend std::ostream& operator<<(std::ostream& s, const Shard& o) {
+        return s << o.Index << "/" << o.Count;
+    }
+
+    class Exception : public std::runtime_error {
+        using std::runtime_error::runtime_error; // use base class constructor
+    };
+};
+
+} // namespace ant
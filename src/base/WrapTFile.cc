@@ -19,21 +19,19 @@
 using namespace std;
 using namespace ant;
 
-static std::vector<string> warnings; // need that ugly global variable for ROOT's error handler
-
 std::unique_ptr<TFile> WrapTFile::openFile(const string& filename, const string mode)
 {
-    auto prevErrorHandler = GetErrorHandler();
-    std_ext::execute_on_destroy restore_error_handler([prevErrorHandler] () {
-        SetErrorHandler(prevErrorHandler);
-    });
-    warnings.clear();
-    SetErrorHandler([] (int level, Bool_t abort, const char *location, const char *msg) {
-        warnings.emplace_back(std_ext::formatter() << "[level=" << level << " abort="
-                              << abort << " location=" << location << " msg='" << msg << "']");
-    });
-
-    auto file = std_ext::make_unique<TFile>(filename.c_str(), mode.c_str());
+    // collect the messages of this thread only, so files can be opened from any thread
+    vector<string> warnings;
+    unique_ptr<TFile> file;
+    {
+        logger::ROOTMessages messages;
+        file = std_ext::make_unique<TFile>(filename.c_str(), mode.c_str());
+        for(const auto& m : messages.Messages) {
+            warnings.emplace_back(std_ext::formatter() << "[level=" << m.Level << " abort="
+                                  << m.Abort << " location=" << m.Location << " msg='" << m.Msg << "']");
+        }
+    }
 
     if(!file->IsOpen() || file->IsZombie()) {
         throw Exception("Could not properly open TFile at "+filename+": "+std_ext::concatenate_string(warnings, " / "));
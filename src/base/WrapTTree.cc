@@ -116,6 +116,29 @@ void WrapTTree::LinkBranches(bool requireOptional)
     LinkBranches(nullptr, requireOptional);
 }
 
+std::vector<string> WrapTTree::GetLinkedBranchNames() const
+{
+    if(!Tree)
+        return {};
+
+    vector<string> names;
+    for(const auto& b : branches) {
+        const auto& fullbranchname = branchNamePrefix+b.Name;
+        const auto rootbranch = Tree->GetBranch(fullbranchname.c_str());
+        // optional branches might not be present
+        if(!rootbranch)
+            continue;
+        names.emplace_back(fullbranchname);
+        if(!b.IsROOTArray)
+            continue;
+        // the wrapped leaf reads its counter branch explicitly
+        auto leaf = dynamic_cast<TLeaf*>(rootbranch->GetListOfLeaves()->At(0));
+        if(leaf && leaf->GetLeafCount())
+            names.emplace_back(leaf->GetLeafCount()->GetBranch()->GetName());
+    }
+    return names;
+}
+
 bool WrapTTree::Matches(TTree* tree, bool exact, bool nowarn) const {
     if(tree == nullptr)
         tree = Tree;
@@ -77,6 +77,14 @@ public:
      */
     bool Matches(TTree* tree = nullptr, bool exact = true, bool nowarn = false) const;
 
+    /**
+     * @brief GetLinkedBranchNames lists the branches of Tree which are read by this instance
+     * @return full branch names, including the counter branches of variable-sized ROOTArray branches
+     *
+     * Useful to disable all other branches or to fill the read cache, call after LinkBranches
+     */
+    std::vector<std::string> GetLinkedBranchNames() const;
+
     /**
      * @brief CopyFrom copies contents in branches by name
      * @param src the source of the contents to be copied
@@ -26,7 +26,19 @@ public:
     struct Converter {
         using ptr_t = std::shared_ptr<const Converter>;
 
-        virtual std::vector<double> Convert(const std::vector<uint8_t>& rawData) const = 0;
+        /**
+         * @brief ConvertTo appends the values converted from rawData to values
+         * @param rawData bytes of one hit
+         * @param values caller-provided storage, reuse it for many hits to avoid allocations
+         */
+        virtual void ConvertTo(const std::vector<uint8_t>& rawData, std::vector<double>& values) const = 0;
+
+        std::vector<double> Convert(const std::vector<uint8_t>& rawData) const {
+            std::vector<double> values;
+            ConvertTo(rawData, values);
+            return values;
+        }
+
         virtual ~Converter() = default;
     };
 
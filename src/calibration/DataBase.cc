@@ -10,10 +10,13 @@
 #include "base/std_ext/misc.h"
 #include "base/std_ext/math.h"
 
+#include "TFile.h"
+
 
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <memory>
 
 using namespace std;
 using namespace ant;
@@ -30,6 +33,20 @@ bool DataBase::GetItem(const string& calibrationID,
                        const TID& currentPoint,
                        TCalibrationData& theData,
                        TID& nextChangePoint) const
+{
+    const auto filename = FindItem(calibrationID, currentPoint, nextChangePoint);
+    if(filename.empty())
+        return false;
+    if(!loadFile(filename, theData))
+        return false;
+    LOG(INFO) << "Loaded data for " << calibrationID << " for changepoint " << currentPoint
+              << " from " << Layout.RemoveCalibrationDataFolder(filename);
+    return true;
+}
+
+string DataBase::FindItem(const string& calibrationID,
+                          const TID& currentPoint,
+                          TID& nextChangePoint) const
 {
     // always invalidate the nextChangePoint
     // as long as we don't know anything
@@ -37,17 +54,16 @@ bool DataBase::GetItem(const string& calibrationID,
 
     // handle MC (may even have AdHoc flag set)
     if(currentPoint.isSet(TID::Flags_t::MC)) {
-        if(loadFile(Layout.GetCurrentFile(calibrationID, OnDiskLayout::Type_t::MC), theData)) {
-            LOG(INFO) << "Loaded MC data for " << calibrationID;
-            return true;
-        }
-        return false;
+        auto filename = Layout.GetCurrentFile(calibrationID, OnDiskLayout::Type_t::MC);
+        if(system::path_exists(filename))
+            return filename;
+        return "";
     }
 
     // do not handle loads for AdHoc non-MC TIDs
     if(currentPoint.isSet(TID::Flags_t::AdHoc)) {
         LOG(WARNING) << "Ignoring database load with AdHoc TID=" << currentPoint;
-        return false;
+        return "";
     }
 
     // try to find it in the DataRanges
@@ -62,12 +78,11 @@ bool DataBase::GetItem(const string& calibrationID,
     });
 
     if(it_range != ranges.end()) {
-        if(loadFile(it_range->FolderPath+"/current", theData)) {
-            LOG(INFO) << "Loaded data for " << calibrationID << " for changepoint " << currentPoint
-                      << " from " << Layout.RemoveCalibrationDataFolder(it_range->FolderPath);
+        auto filename = it_range->FolderPath+"/current";
+        if(system::path_exists(filename)) {
             // next change point is given by found range as Stop()+1
             nextChangePoint = ++it_range->Stop();
-            return true;
+            return filename;
         }
         else {
             LOG(WARNING) << "Cannot load data from " << it_range->FolderPath;
@@ -75,7 +90,7 @@ bool DataBase::GetItem(const string& calibrationID,
     }
 
     // check if there's a range coming up at some point
-    // that means even if this method returns false,
+    // that means even if this method returns nothing,
     // the nextChangePoint is correctly set
     ranges.sort();
     it_range = find_if(ranges.begin(), ranges.end(),
@@ -86,13 +101,12 @@ bool DataBase::GetItem(const string& calibrationID,
         nextChangePoint = it_range->Start();
 
     // not found in ranges, so try default data
-    if(loadFile(Layout.GetCurrentFile(calibrationID, OnDiskLayout::Type_t::DataDefault), theData)) {
-        LOG(INFO) << "Loaded default data for " << calibrationID << " for changepoint " << currentPoint;
-        return true;
-    }
+    auto filename = Layout.GetCurrentFile(calibrationID, OnDiskLayout::Type_t::DataDefault);
+    if(system::path_exists(filename))
+        return filename;
 
     // nothing found at all
-    return false;
+    return "";
 }
 
 void DataBase::AddItem(const TCalibrationData& cdata, Calibration::AddMode_t mode)
@@ -270,15 +284,25 @@ bool DataBase::loadFile(const string& filename, TCalibrationData& cdata) const
         throw Exception(formatter() << "Cannot open " << filename << ": " << errmsg );
     }
 
-    try {
-        WrapTFileInput dataFile;
-        dataFile.OpenFile(filename);
-        return dataFile.GetObjectClone("cdata", cdata);
-    }
-    catch(...) {
+    // use TFile directly, as WrapTFile would turn ROOT's warnings into exceptions.
+    // ROOT still reports via its error handler, which logs, so callers on
+    // a background thread collect them with logger::ROOTMessages (see DataManager::Prefetch)
+    const auto prev_Directory = gDirectory;
+    execute_on_destroy restoreDir([prev_Directory] () {
+        gDirectory = prev_Directory;
+    });
+
+    unique_ptr<TFile> dataFile(TFile::Open(filename.c_str(), "READ"));
+    if(!dataFile || dataFile->IsZombie())
         throw Exception(formatter() << "Cannot load object cdata from " << filename);
-    }
 
+    TCalibrationData* ptr = nullptr;
+    dataFile->GetObject("cdata", ptr);
+    if(!ptr)
+        return false;
+    cdata = move(*ptr);
+    delete ptr;
+    return true;
 }
 
 bool DataBase::writeToFolder(const string& folder, const TCalibrationData& cdata) const
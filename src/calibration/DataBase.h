@@ -31,6 +31,27 @@ public:
                  TCalibrationData& theData,
                  TID& nextChangePoint) const;
 
+    /**
+     * @brief FindItem looks up the file GetItem would load, without loading it
+     * @return filename, or empty string if no data is available for currentPoint
+     */
+    std::string FindItem(const std::string& calibrationID,
+                         const TID& currentPoint,
+                         TID& nextChangePoint) const;
+
+    /**
+     * @brief LoadItem reads the file found by FindItem, can be called from any thread
+     * if the ROOT messages are collected with logger::ROOTMessages meanwhile
+     * @return true -> file loaded, false -> file does not exist
+     */
+    bool LoadItem(const std::string& filename, TCalibrationData& cdata) const {
+        return loadFile(filename, cdata);
+    }
+
+    std::string RemoveCalibrationDataFolder(const std::string& path) const {
+        return Layout.RemoveCalibrationDataFolder(path);
+    }
+
     void AddItem(const TCalibrationData& cdata, Calibration::AddMode_t mode);
 
     std::list<std::string> GetCalibrationIDs() const;
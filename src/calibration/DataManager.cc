@@ -16,12 +16,49 @@
 //std
 #include <algorithm>
 #include <iostream>
+#include <future>
 
 using namespace std;
 using namespace ant;
 using namespace ant::calibration;
 
 
+bool DataManager::Prefetch = false;
+
+struct DataManager::prefetch_t::result_t {
+    ParametersPtr Parameters;
+    // collected on the background thread, logged when the result is picked up
+    std::vector<logger::ROOTMessages::message_t> Messages;
+    std::exception_ptr Error;
+};
+
+DataManager::Parameters_t::Parameters_t(TCalibrationData data) :
+    Data(move(data))
+{
+    std::vector<bool> found;
+    for(const auto& val : Data.Data) {
+        if(Values.size()<val.Key+1) {
+            Values.resize(val.Key+1);
+            found.resize(val.Key+1);
+        }
+        Values[val.Key] = val.Value;
+        found[val.Key] = true;
+    }
+    allKeys = all_of(found.begin(), found.end(), [] (bool b) { return b; });
+}
+
+void DataManager::Parameters_t::CopyValuesTo(std::vector<double>& values) const
+{
+    if(values.size()<Values.size())
+        values.resize(Values.size());
+    if(allKeys) {
+        copy(Values.begin(), Values.end(), values.begin());
+        return;
+    }
+    for(const auto& val : Data.Data)
+        values[val.Key] = val.Value;
+}
+
 void DataManager::Init() const
 {
     if(dataBase)
@@ -35,7 +72,8 @@ DataManager::DataManager(const string& calibrationDataFolder_):
 
 DataManager::~DataManager()
 {
-
+    // wait for running prefetches before the database goes away
+    clearCaches();
 }
 
 void DataManager::Add(const TCalibrationData& cdata, Calibration::AddMode_t addMode)
@@ -46,6 +84,8 @@ void DataManager::Add(const TCalibrationData& cdata, Calibration::AddMode_t addM
     }
 
     Init();
+    // the new item may change which data is found for a TID
+    clearCaches();
     dataBase->AddItem(cdata, addMode);
     LOG(INFO) << "Added " << cdata;
 }
@@ -59,9 +99,115 @@ bool DataManager::GetData(const string& calibrationID, const TID& eventID, TCali
 
 bool DataManager::GetData(const string& calibrationID,
                           const TID& eventID, TCalibrationData& cdata, TID& nextChangePoint) const
+{
+    auto params = GetParameters(calibrationID, eventID, nextChangePoint);
+    if(!params)
+        return false;
+    cdata = params->Data;
+    return true;
+}
+
+DataManager::ParametersPtr DataManager::GetParameters(const string& calibrationID,
+                                                      const TID& eventID, TID& nextChangePoint) const
 {
     Init();
-    return dataBase->GetItem(calibrationID,eventID,cdata,nextChangePoint);
+
+    string filename;
+    ParametersPtr params;
+
+    auto it_prefetched = prefetched.find(calibrationID);
+    if(it_prefetched != prefetched.end() && it_prefetched->second.Point == eventID) {
+        auto p = move(it_prefetched->second);
+        prefetched.erase(it_prefetched);
+        filename = p.Filename;
+        nextChangePoint = p.NextChangePoint;
+        const auto result = p.Result.get();
+        logger::ROOTMessages::Log(result->Messages);
+        if(result->Error)
+            rethrow_exception(result->Error);
+        params = result->Parameters;
+    }
+    else {
+        filename = dataBase->FindItem(calibrationID, eventID, nextChangePoint);
+        if(!filename.empty()) {
+            params = findLoaded(filename);
+            TCalibrationData cdata;
+            if(!params && dataBase->LoadItem(filename, cdata))
+                params = make_shared<const Parameters_t>(move(cdata));
+        }
+    }
+
+    if(params) {
+        LOG(INFO) << "Loaded data for " << calibrationID << " for changepoint " << eventID
+                  << " from " << dataBase->RemoveCalibrationDataFolder(filename);
+        loaded[filename] = params;
+    }
+
+    // keep it, so identical data for the following range is shared
+    current[calibrationID] = params;
+
+    if(Prefetch && !nextChangePoint.IsInvalid())
+        startPrefetch(calibrationID, nextChangePoint);
+
+    return params;
+}
+
+DataManager::ParametersPtr DataManager::findLoaded(const string& filename) const
+{
+    auto it_loaded = loaded.find(filename);
+    if(it_loaded == loaded.end())
+        return nullptr;
+    auto params = it_loaded->second.lock();
+    if(!params)
+        loaded.erase(it_loaded);
+    return params;
+}
+
+void DataManager::startPrefetch(const string& calibrationID, const TID& point) const
+{
+    // finding the file is cheap and uses the (not thread-safe) cached layout,
+    // so only the loading runs in the background
+    prefetch_t p;
+    p.Point = point;
+    p.Filename = dataBase->FindItem(calibrationID, point, p.NextChangePoint);
+
+    auto params = p.Filename.empty() ? nullptr : findLoaded(p.Filename);
+    if(params || p.Filename.empty()) {
+        auto result = make_shared<prefetch_t::result_t>();
+        result->Parameters = params;
+        promise<shared_ptr<const prefetch_t::result_t>> ready;
+        ready.set_value(move(result));
+        p.Result = ready.get_future().share();
+    }
+    else {
+        const DataBase& db = *dataBase;
+        const auto filename = p.Filename;
+        p.Result = async(launch::async, [&db, filename] () {
+            auto result = make_shared<prefetch_t::result_t>();
+            // the logger must not be used from here, so collect ROOT's
+            // messages and errors for the thread picking up the result
+            logger::ROOTMessages messages;
+            try {
+                TCalibrationData cdata;
+                if(db.LoadItem(filename, cdata))
+                    result->Parameters = make_shared<const Parameters_t>(move(cdata));
+            }
+            catch(...) {
+                result->Error = current_exception();
+            }
+            result->Messages = move(messages.Messages);
+            return shared_ptr<const prefetch_t::result_t>(move(result));
+        }).share();
+    }
+
+    prefetched[calibrationID] = move(p);
+}
+
+void DataManager::clearCaches() const
+{
+    prefetched.clear();
+    current.clear();
+    loaded.clear();
 }
 
 size_t DataManager::GetNumberOfCalibrationIDs() const
@@ -2,15 +2,19 @@
 
 #include "Calibration.h"
 
+#include "tree/TCalibrationData.h"
+
 //std
 #include <list>
 #include <string>
 #include <memory>
+#include <map>
+#include <future>
+#include <vector>
 
 namespace ant
 {
 
-struct TCalibrationData;
 struct TID;
 
 namespace calibration
@@ -55,6 +59,51 @@ private:
 
     bool override_as_default = false;
 
+public:
+    /**
+     * @brief The Parameters_t struct is the content of one calibration data item,
+     * it's loaded once and then shared read-only by all modules asking for it
+     */
+    struct Parameters_t {
+        TCalibrationData Data;
+        std::vector<double> Values; // Data.Data indexed by Key, zero for missing keys
+
+        explicit Parameters_t(TCalibrationData data);
+
+        /**
+         * @brief CopyValuesTo sets the given values from Data.Data, keeps values for missing keys
+         * @param values grown if too small
+         */
+        void CopyValuesTo(std::vector<double>& values) const;
+    protected:
+        bool allKeys = true; // Data.Data has all keys up to Values.size()
+    };
+    using ParametersPtr = std::shared_ptr<const Parameters_t>;
+
+    /**
+     * @brief Prefetch if true, loads the data for the next change point in a background thread,
+     * requires ROOT::EnableThreadSafety() to be called before
+     */
+    static bool Prefetch;
+
+private:
+    struct prefetch_t {
+        struct result_t; // the parameters with the ROOT messages from loading them
+        TID Point;
+        std::string Filename;
+        TID NextChangePoint;
+        std::shared_future<std::shared_ptr<const result_t>> Result;
+    };
+    // by calibrationID
+    mutable std::map<std::string, prefetch_t> prefetched;
+    mutable std::map<std::string, ParametersPtr> current;
+    // by filename, the files in the database are never changed once written
+    mutable std::map<std::string, std::weak_ptr<const Parameters_t>> loaded;
+
+    ParametersPtr findLoaded(const std::string& filename) const;
+    void startPrefetch(const std::string& calibrationID, const TID& point) const;
+    void clearCaches() const;
+
 public:
     DataManager(const std::string& calibrationDataFolder_);
     virtual ~DataManager();
@@ -70,6 +119,14 @@ public:
                  TCalibrationData& cdata,
                  TID& nextChangePoint) const;
 
+    /**
+     * @brief GetParameters is like GetData, but shares the loaded data instead of copying it
+     * @return nullptr if no data was found
+     */
+    ParametersPtr GetParameters(const std::string& calibrationID,
+                                const TID& eventID,
+                                TID& nextChangePoint) const;
+
     // the following methods are only useful for test cases
     std::list<std::string> GetCalibrationIDs() const;
     std::size_t GetNumberOfCalibrationIDs() const;
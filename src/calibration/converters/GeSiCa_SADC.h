@@ -12,16 +12,16 @@ namespace converter {
 struct GeSiCa_SADC : Calibration::Converter {
 
 
-    virtual std::vector<double> Convert(const std::vector<uint8_t>& rawData) const override
+    virtual void ConvertTo(const std::vector<uint8_t>& rawData, std::vector<double>& values) const override
     {
         if(rawData.size() != 6) // expect three 16bit values
-          return {};
+          return;
 
         const double pedestal = *reinterpret_cast<const uint16_t*>(&rawData[0]);
         const double signal = *reinterpret_cast<const uint16_t*>(&rawData[2]);
 
-        // return vector with size 1 and pedestal subtracted signal
-        return {signal - pedestal};
+        // one value, the pedestal subtracted signal
+        values.push_back(signal - pedestal);
     }
 };
 
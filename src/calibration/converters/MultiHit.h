@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 
 namespace ant {
@@ -14,25 +15,42 @@ template<typename T>
 struct MultiHit : Calibration::Converter {
 
 
-    virtual std::vector<double> Convert(const std::vector<uint8_t>& rawData) const override
+    virtual void ConvertTo(const std::vector<uint8_t>& rawData, std::vector<double>& values) const override
     {
         // just convert T to double
-        return ConvertRaw<double>(rawData);
+        ConvertRaw<double>(rawData, values);
     }
 
 protected:
-    template<typename U = T>
-    static std::vector<U> ConvertRaw(const std::vector<std::uint8_t>& rawData)
+    /**
+     * @brief NWords number of T words in rawData
+     * @return 0 if rawData is not made of complete words
+     */
+    static std::size_t NWords(const std::vector<std::uint8_t>& rawData)
     {
         constexpr std::size_t wordsize = sizeof(T)/sizeof(std::uint8_t);
         if(rawData.size() % wordsize  != 0)
-            return {};
-        std::vector<U> ret(rawData.size()/wordsize);
-        for(size_t i=0;i<ret.size();i++) {
-            const T* rawVal = reinterpret_cast<const T*>(std::addressof(rawData[wordsize*i]));
-            ret[i] = static_cast<U>(*rawVal);
+            return 0;
+        return rawData.size()/wordsize;
+    }
+
+    /**
+     * @brief ConvertRaw appends all T words of rawData as U to values
+     */
+    template<typename U = T>
+    static void ConvertRaw(const std::vector<std::uint8_t>& rawData, std::vector<U>& values)
+    {
+        const auto n = NWords(rawData);
+        const auto offset = values.size();
+        values.resize(offset + n);
+        // memcpy avoids unaligned access, compilers turn it into plain loads
+        U* out = values.data() + offset;
+        const std::uint8_t* in = rawData.data();
+        for(size_t i=0;i<n;i++) {
+            T rawVal;
+            std::memcpy(std::addressof(rawVal), in + sizeof(T)*i, sizeof(T));
+            out[i] = static_cast<U>(rawVal);
         }
-        return ret;
     }
 };
 
@@ -27,17 +27,17 @@ struct MultiHitReference : MultiHit<T>, ReconstructHook::DetectorReadHits {
         Gain(gain)
     {}
 
-    virtual std::vector<double> Convert(const std::vector<uint8_t>& rawData) const override
+    virtual void ConvertTo(const std::vector<uint8_t>& rawData, std::vector<double>& values) const override
     {
         // we can only convert if we have a reference hit timing
         if(ReferenceHits.size() != 1)
-            return {};
-        const auto refHit = ReferenceHits.front();
-        auto hits = MultiHit<T>::template ConvertRaw<double>(rawData);
+            return;
+        const double refHit = ReferenceHits.front();
+        const auto offset = values.size();
+        MultiHit<T>::template ConvertRaw<double>(rawData, values);
         /// \todo think about hit/refHit overflow here?
-        for(auto& hit : hits)
-            hit = (hit - refHit)*Gain;
-        return hits;
+        for(auto i=offset;i<values.size();i++)
+            values[i] = (values[i] - refHit)*Gain;
     }
 
     virtual void ApplyTo(const readhits_t& hits) override {
@@ -53,7 +53,7 @@ struct MultiHitReference : MultiHit<T>, ReconstructHook::DetectorReadHits {
         if(it_refhit == refhits.cend())
             return;
         // use the same converter for the reference hit
-        ReferenceHits = MultiHit<T>::template ConvertRaw<T>(it_refhit->get().RawData);
+        MultiHit<T>::template ConvertRaw<T>(it_refhit->get().RawData, ReferenceHits);
     }
 
 protected:
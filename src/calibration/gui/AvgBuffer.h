@@ -4,6 +4,7 @@
 #include <list>
 #include <queue>
 #include <cassert>
+#include <vector>
 
 #include "AvgBuffer_traits.h"
 
@@ -93,6 +94,7 @@ protected:
         buffer_entry(const std::shared_ptr<AvgBufferItem>& h, const interval<TID>& ID) : hist(h), id(ID) {}
         std::shared_ptr<AvgBufferItem> hist;
         interval<TID> id;
+        std::vector<double> bins; // bin contents, read once on Push
     };
 
 
@@ -125,25 +127,18 @@ protected:
 
         const auto h = std::shared_ptr<AvgBufferItem>(Traits::Clone(*i->hist));
 
-        // to get the number of cells (or total number of all bins)
-        // this cast is necessary, as GetNcells is not there in current ROOT5 branch?!
-        const auto nBins = Traits::GetNBins(*h);;
-
-        // h is the destination of the smoothing
-
         // range is relative to i and inclusive, so take distance-to-end-1
         const interval<int> range(-std::distance(m_buffer.begin(), i),
                                   std::distance(i, m_buffer.end())-1);
 
-        for(auto bin=0;bin<nBins;bin++) {
-            auto getY = [i,bin,normalization] (const int i_) {
-                return Traits::GetBin(*std::next(i, i_)->hist, bin)/normalization;
-            };
-            auto setY = [h,bin] (const double v) {
-                Traits::SetBin(*h, bin, v);
-            };
-            sg.Convolute(getY, setY, range);
-        }
+        // smooth all bins at once, h is the destination of the smoothing
+        std::vector<double> smoothed;
+        sg.ConvoluteRows([i] (const int i_) -> const std::vector<double>& {
+            return std::next(i, i_)->bins;
+        }, range, smoothed);
+
+        for(auto bin=0u;bin<smoothed.size();bin++)
+            Traits::SetBin(*h, bin, smoothed[bin]/normalization);
 
         return h;
     }
@@ -167,6 +162,13 @@ public:
         // add the item to the buffer
         m_buffer.emplace_back(buffer_entry(h, id));
 
+        // to get the number of cells (or total number of all bins)
+        // this cast is necessary, as GetNcells is not there in current ROOT5 branch?!
+        auto& bins = m_buffer.back().bins;
+        bins.resize(Traits::GetNBins(*h));
+        for(auto bin=0u;bin<bins.size();bin++)
+            bins[bin] = Traits::GetBin(*h, bin);
+
 
         // pop elements from buffer
         if(m_buffer.size() > m_sum_length)
@@ -43,7 +43,9 @@ void CB_SourceCalib::ApplyTo(const readhits_t &hits)
         if(dethit.ChannelType != Channel_t::Type_t::Integral)
             continue;
         dethit.Values.resize(0);
-        for(double conv : Converter->Convert(dethit.RawData)){
+        converted.resize(0);
+        Converter->ConvertTo(dethit.RawData, converted);
+        for(double conv : converted){
             dethit.Values.emplace_back(conv);
         }
     }
@@ -84,6 +84,7 @@ protected:
      std::shared_ptr<expconfig::detector::CB> cb_detector;
      std::shared_ptr<DataManager> calibrationManager;
      const Calibration::Converter::ptr_t Converter;
+     std::vector<double> converted; // reused for each hit
 };
 
 }}
@@ -134,10 +134,10 @@ std::list<Updateable_traits::Loader_t> CB_TimeWalk::GetLoaders()
 {
     return {
         [this] (const TID& currPoint, TID& nextChangePoint) {
-            TCalibrationData cdata;
-            if(!calibrationManager->GetData(GetName(), currPoint, cdata, nextChangePoint))
+            auto params = calibrationManager->GetParameters(GetName(), currPoint, nextChangePoint);
+            if(!params)
                 return;
-            for(const TKeyValue<vector<double>>& kv : cdata.FitParameters) {
+            for(const TKeyValue<vector<double>>& kv : params->Data.FitParameters) {
                 if(kv.Key>=timewalks.size()) {
                     LOG(ERROR) << "Ignoring too large key=" << kv.Key;
                     continue;
@@ -53,9 +53,28 @@ void ClusterCorrection::ApplyTo(clusters_t& clusters)
 
         if(entry != clusters.end()) {
 
-            for(auto& cluster : entry->second) {
+            auto& detclusters = entry->second;
+
+            // evaluate the interpolator for all clusters at once,
+            // then apply in cluster order as before.
+            // the buffers are reused for the next events, but not shared between threads
+            thread_local vector<double> points_x;
+            thread_local vector<double> points_y;
+            thread_local vector<double> values;
+            points_x.resize(detclusters.size());
+            points_y.resize(detclusters.size());
+            size_t i = 0;
+            for(const auto& cluster : detclusters) {
+                GetInterpolationPoint(cluster, points_x[i], points_y[i]);
+                i++;
+            }
+
+            interpolator->GetPoints(points_x, points_y, values);
+
+            i = 0;
+            for(auto& cluster : detclusters) {
 
-                ApplyTo(cluster);
+                ApplyInterpolated(cluster, values[i++]);
 
                 if(cluster.Energy < 0.0)
                     cluster.Energy = 0.0;
@@ -64,6 +83,13 @@ void ClusterCorrection::ApplyTo(clusters_t& clusters)
     }
 }
 
+void ClusterCorrection::ApplyTo(TCluster& cluster)
+{
+    double x, y;
+    GetInterpolationPoint(cluster, x, y);
+    ApplyInterpolated(cluster, interpolator->GetPoint(x, y));
+}
+
 
 std::list<Updateable_traits::Loader_t> ClusterCorrection::GetLoaders()
 {
@@ -73,9 +99,7 @@ std::list<Updateable_traits::Loader_t> ClusterCorrection::GetLoaders()
 
             const bool isMC    = currPoint.isSet(TID::Flags_t::MC);
 
-            TCalibrationData cdata;
-
-            const bool loadOK = calibrationManager->GetData(GetName(), currPoint, cdata, nextChangePoint);
+            auto params = calibrationManager->GetParameters(GetName(), currPoint, nextChangePoint);
 
             if((isMC && filter == Filter_t::Data)
                   || (!isMC  && filter == Filter_t::MC)) {
@@ -83,13 +107,13 @@ std::list<Updateable_traits::Loader_t> ClusterCorrection::GetLoaders()
                 return;
             }
 
-            if(!loadOK) {
+            if(!params) {
                 LOG(WARNING) << "No data found for " << GetName();
                 this->interpolator = nullptr;
                 return;
             }
 
-            auto hist = detail::TH2Storage::Decode(cdata);
+            auto hist = detail::TH2Storage::Decode(params->Data);
 
             this->interpolator = std_ext::make_unique<ClippedInterpolatorWrapper>(
                                      ClippedInterpolatorWrapper::makeInterpolator(hist));
@@ -99,16 +123,26 @@ std::list<Updateable_traits::Loader_t> ClusterCorrection::GetLoaders()
     };
 }
 
-void ClusterSmearing::ApplyTo(TCluster& cluster)
+void ClusterSmearing::GetInterpolationPoint(const TCluster& cluster, double& x, double& y) const
 {
-    const auto sigma  = interpolator->GetPoint(cluster.Energy, cos(cluster.Position.Theta()));
-    cluster.Energy    = gRandom->Gaus(cluster.Energy, sigma);
+    x = cluster.Energy;
+    y = cos(cluster.Position.Theta());
+}
+
+void ClusterSmearing::ApplyInterpolated(TCluster& cluster, double sigma) const
+{
+    cluster.Energy = gRandom->Gaus(cluster.Energy, sigma);
 }
 
-void ClusterECorr::ApplyTo(TCluster& cluster)
+void ClusterECorr::GetInterpolationPoint(const TCluster& cluster, double& x, double& y) const
 {
-    const auto factor  = interpolator->GetPoint(cluster.Energy, cluster.Hits.size());
-    cluster.Energy    *= factor;
+    x = cluster.Energy;
+    y = cluster.Hits.size();
+}
+
+void ClusterECorr::ApplyInterpolated(TCluster& cluster, double factor) const
+{
+    cluster.Energy *= factor;
 }
 
 ClusterCorrectionManual::ClusterCorrectionManual(std::shared_ptr<ClusterDetector_t> det,
@@ -143,6 +177,17 @@ std::list<Updateable_traits::Loader_t> ClusterCorrectionManual::GetLoaders()
     return {};
 }
 
+void ClusterCorrectionManual::GetInterpolationPoint(const TCluster&, double& x, double& y) const
+{
+    x = std_ext::NaN;
+    y = std_ext::NaN;
+}
+
+void ClusterCorrectionManual::ApplyInterpolated(TCluster&, double) const
+{
+    throw runtime_error("Manual cluster corrections do not interpolate");
+}
+
 ClusterCorrFactor::ClusterCorrFactor(std::shared_ptr<ClusterDetector_t> det,
                                      const std::string &Name, const Filter_t Filter,
                                      std::shared_ptr<DataManager> calmgr,
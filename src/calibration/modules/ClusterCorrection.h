@@ -8,6 +8,7 @@
 #include "tree/TID.h" // for TKeyValue, TID
 
 #include <memory>
+#include <vector>
 
 
 namespace ant {
@@ -35,7 +36,7 @@ public:
     // ReconstructHook
     virtual void ApplyTo(clusters_t& clusters) override;
 
-    virtual void ApplyTo(TCluster& cluster) =0;
+    virtual void ApplyTo(TCluster& cluster);
 
     // Updateable_traits interface
     virtual std::list<Loader_t> GetLoaders() override;
@@ -55,6 +56,12 @@ protected:
 
     std::unique_ptr<ClippedInterpolatorWrapper> interpolator;
 
+    /// point (x,y) at which the interpolator is evaluated for the given cluster
+    virtual void GetInterpolationPoint(const TCluster& cluster, double& x, double& y) const =0;
+
+    /// apply the value interpolated at the cluster's point to the cluster
+    virtual void ApplyInterpolated(TCluster& cluster, double value) const =0;
+
 };
 
 /**
@@ -64,7 +71,9 @@ class ClusterSmearing : public ClusterCorrection {
 public:
     using ClusterCorrection::ClusterCorrection;
 
-    void ApplyTo(TCluster& cluster);
+protected:
+    virtual void GetInterpolationPoint(const TCluster& cluster, double& x, double& y) const override;
+    virtual void ApplyInterpolated(TCluster& cluster, double value) const override;
 };
 
 /**
@@ -74,7 +83,9 @@ class ClusterECorr : public ClusterCorrection {
 public:
     using ClusterCorrection::ClusterCorrection;
 
-    void ApplyTo(TCluster& cluster);
+protected:
+    virtual void GetInterpolationPoint(const TCluster& cluster, double& x, double& y) const override;
+    virtual void ApplyInterpolated(TCluster& cluster, double value) const override;
 };
 
 class ClusterCorrectionManual : public ClusterCorrection {
@@ -92,6 +103,11 @@ public:
             const Filter_t Filter,
             std::shared_ptr<DataManager> calmgr);
     virtual ~ClusterCorrectionManual() override;
+
+protected:
+    // manual corrections do not use an interpolator
+    virtual void GetInterpolationPoint(const TCluster& cluster, double& x, double& y) const override final;
+    virtual void ApplyInterpolated(TCluster& cluster, double value) const override final;
 };
 
 /**
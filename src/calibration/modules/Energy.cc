@@ -61,8 +61,11 @@ void Energy::ApplyTo(const readhits_t& hits)
             // clear previously read values (if any)
             dethit.Values.resize(0);
 
+            converted.resize(0);
+            Converter->ConvertTo(dethit.RawData, converted);
+
             // apply pedestal/gain to each of the values (might be multihit)
-            for(const double& conv : Converter->Convert(dethit.RawData)) {
+            for(const double& conv : converted) {
                 TDetectorReadHit::Value_t value(conv);
                 value.Calibrated -= Pedestals.Get(dethit.Channel);
 
@@ -110,17 +113,12 @@ std::list<Updateable_traits::Loader_t> Energy::GetLoaders()
         auto loader = [this, calibration]
                 (const TID& currPoint, TID& nextChangePoint)
         {
-            TCalibrationData cdata;
-            if(calibrationManager->GetData(
-                   GetName()+"_"+ calibration->Name,
-                   currPoint, cdata, nextChangePoint))
+            auto params = calibrationManager->GetParameters(
+                              GetName()+"_"+ calibration->Name,
+                              currPoint, nextChangePoint);
+            if(params)
             {
-                auto& values = calibration->Values;
-                for (const auto& val: cdata.Data) {
-                    if(values.size()<val.Key+1)
-                        values.resize(val.Key+1);
-                    values[val.Key] = val.Value;
-                }
+                params->CopyValuesTo(calibration->Values);
 
                 // call notify load if present
                 if(calibration->NotifyLoad)
@@ -50,6 +50,7 @@ protected:
     const std::shared_ptr<DataManager> calibrationManager;
 
     const Calibration::Converter::ptr_t Converter;
+    std::vector<double> converted; // reused for each hit
 
     CalibType Pedestals;
     CalibType Gains;
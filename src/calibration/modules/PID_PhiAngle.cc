@@ -44,12 +44,12 @@ std::list<Updateable_traits::Loader_t> PID_PhiAngle::GetLoaders()
 {
     return {
         [this] (const TID& currPoint, TID& nextChangePoint) {
-            TCalibrationData cdata;
-            if(!calibrationManager->GetData(GetName(), currPoint, cdata, nextChangePoint))
+            auto params = calibrationManager->GetParameters(GetName(), currPoint, nextChangePoint);
+            if(!params)
                 return;
-            if(cdata.Data.size() != 1)
+            if(params->Data.Data.size() != 1)
                 return;
-            const TKeyValue<double>& kv = cdata.Data.front();
+            const TKeyValue<double>& kv = params->Data.Data.front();
             pid_detector->SetPhiOffset(kv.Value);
         }
     };
@@ -33,10 +33,10 @@ std::list<Updateable_traits::Loader_t> TAPS_ToF::GetLoaders()
 {
     return {
       [this] (const TID& currPoint, TID& nextChangePoint) {
-            TCalibrationData cdata;
-            if(calibrationManager->GetData(GetName(), currPoint, cdata, nextChangePoint))
+            auto params = calibrationManager->GetParameters(GetName(), currPoint, nextChangePoint);
+            if(params)
             {
-                for (const auto& val: cdata.Data) {
+                for (const auto& val: params->Data.Data) {
                     Detector->SetToFOffset(val.Key, val.Value);
                 }
             }
@@ -44,19 +44,19 @@ std::list<Updateable_traits::Loader_t> TaggEff::GetLoaders()
 {
     return {
         [this] (const TID& currPoint, TID& nextChangePoint) {
-            TCalibrationData cdata;
-            if(!CalibrationManager->GetData(GetName(), currPoint, cdata, nextChangePoint))
+            auto params = CalibrationManager->GetParameters(GetName(), currPoint, nextChangePoint);
+            if(!params)
                 return;
 
             currentTaggEff.resize(0);
-            for ( const auto& data: cdata.Data )
+            for ( const auto& data: params->Data.Data )
             {
                 const auto channel = data.Key;
                 currentTaggEff.resize(channel+1);
                 currentTaggEff.at(channel).Value = data.Value;
             }
 
-            for ( const auto& data : cdata.FitParameters)
+            for ( const auto& data : params->Data.FitParameters)
             {
                 // expect the currentTaggEff to be resized from previous filling
                 // might throw index-out-of-bound exception if this assumption is not true
@@ -26,7 +26,9 @@ void Tagger_QDC::ApplyTo(const ant::ReconstructHook::Base::readhits_t& hits)
         if(dethit.ChannelType != Channel_t::Type_t::Integral)
             continue;
         dethit.Values.resize(0);
-        for(double conv : Converter->Convert(dethit.RawData)) {
+        converted.resize(0);
+        Converter->ConvertTo(dethit.RawData, converted);
+        for(double conv : converted) {
             dethit.Values.emplace_back(conv);
         }
     }
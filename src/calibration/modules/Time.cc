@@ -49,14 +49,10 @@ std::list<Updateable_traits::Loader_t> Time::GetLoaders()
 {
     return {
       [this] (const TID& currPoint, TID& nextChangePoint) {
-            TCalibrationData cdata;
-            if(calibrationManager->GetData(GetName(), currPoint, cdata, nextChangePoint))
+            auto params = calibrationManager->GetParameters(GetName(), currPoint, nextChangePoint);
+            if(params)
             {
-                for (const auto& val: cdata.Data) {
-                    if(Offsets.size()<val.Key+1)
-                        Offsets.resize(val.Key+1);
-                    Offsets[val.Key] = val.Value;
-                }
+                params->CopyValuesTo(Offsets);
             }
             else {
                 LOG_IF(!Offsets.empty(), WARNING) << "No calibration data found for offsets"
@@ -102,7 +98,8 @@ void Time::ApplyTo(const readhits_t& hits)
 
         // the Converter is smart enough to account for reference times
         // by (possibly) being itself a reconstruction hook and searching for it
-        const auto& converted = Converters[dethit.Channel]->Convert(dethit.RawData);
+        converted.resize(0);
+        Converters[dethit.Channel]->ConvertTo(dethit.RawData, converted);
 
         // apply gain/offset to each of the values (might be multihit)
         for(const double& conv : converted) {
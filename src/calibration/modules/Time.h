@@ -107,6 +107,7 @@ protected:
     std::shared_ptr<DataManager> calibrationManager;
 
     std::vector<Calibration::Converter::ptr_t> Converters;
+    std::vector<double> converted; // reused for each hit
 
     std::vector<interval<double>> TimeWindows;
 
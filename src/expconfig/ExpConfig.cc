@@ -25,10 +25,11 @@ void ExpConfig::Setup::SetByTID(const TID& tid)
         return;
     }
 
-    // go to automatic search mode in all registered setups
+    // go to automatic search mode in all registered setups,
+    // the registry knows the time ranges without creating the setups
 
     std::list<SetupPtr> setups;
-    for(auto setup_name : expconfig::SetupRegistry::GetNames()) {
+    for(auto setup_name : expconfig::SetupRegistry::GetNamesByTimestamp(tid.Timestamp)) {
         setups.emplace_back(expconfig::SetupRegistry::GetSetup(setup_name));
     }
 
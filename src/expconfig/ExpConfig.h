@@ -70,7 +70,8 @@ public:
         static void SetByName(const std::string& setupname);
 
         /**
-         * @brief SetByTID automatically search setup by using their Matches() method
+         * @brief SetByTID automatically search setup by using their Matches() method,
+         * only the setups with a matching registered time range are created, see SetupRegistry::GetNamesByTimestamp
          * @param tid TID for searching (usually provided/generated by unpacker)
          */
         static void SetByTID(const TID& tid);
@@ -188,6 +189,14 @@ public:
     virtual ant::PiecewiseInterval<double> GetPromptWindows() const = 0;
     virtual ant::PiecewiseInterval<double> GetRandomWindows() const = 0;
 
+    /**
+     * @brief GetTaggerHitWindows restricts the tagger hit times kept by the reconstruction
+     * @return time windows in ns, empty if all tagger hits should be kept (default)
+     */
+    virtual ant::PiecewiseInterval<double> GetTaggerHitWindows() const {
+        return {};
+    }
+
     virtual ~Setup_traits() = default;
 
 }; // Setup_traits
@@ -2,6 +2,7 @@
 
 #include "base/Paths.h"
 #include "base/Logger.h"
+#include "base/std_ext/math.h"
 
 #include "calibration/modules/ClusterCorrection.h"
 
@@ -70,11 +71,35 @@ std::string Setup::GetPhysicsFilesDirectory() const
 
 Setup::Setup(const std::string& name, OptionsPtr opts) :
     name_(name),
-    includeIgnoredElements(opts->Get<bool>("IncludeIgnoredElements", false))
+    includeIgnoredElements(opts->Get<bool>("IncludeIgnoredElements", false)),
+    taggerHitWindowMargin(opts->Get<double>("TaggerHitWindowMargin", std_ext::NaN))
 {
     std::string calibrationDataFolder = std::string(ANT_PATH_DATABASE)+"/"+GetName()+"/calibration";
     calibrationDataManager = std::make_shared<calibration::DataManager>(calibrationDataFolder);
     LOG_IF(includeIgnoredElements, WARNING) << "Including ignored detector elements";
+
+    const auto timerange = SetupRegistry::GetTimeRange(name);
+    SetTimeRange(timerange.StartDate, timerange.EndDate);
+}
+
+ant::PiecewiseInterval<double> Setup::GetTaggerHitWindows() const
+{
+    // disabled by default, the prompt/random windows are defined for the
+    // tagger time corrected by the CB reference timing, which is not known during
+    // reconstruction, so the margin should cover its spread
+    if(!std::isfinite(taggerHitWindowMargin))
+        return {};
+
+    PiecewiseInterval<double> windows;
+    for(const auto& w : {prompt, random}) {
+        for(const auto& i : w)
+            windows.emplace_back(i.Start()-taggerHitWindowMargin, i.Stop()+taggerHitWindowMargin);
+    }
+    windows.Compact();
+
+    LOG_IF(windows.empty(), WARNING) << "TaggerHitWindowMargin given, but setup "
+                                      << GetName() << " has no prompt/random windows";
+    return windows;
 }
 
 bool Setup::Matches(const ant::TID& tid) const {
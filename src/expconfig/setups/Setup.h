@@ -35,6 +35,7 @@ class Setup :
 private:
     const std::string name_;
     const bool includeIgnoredElements;
+    const double taggerHitWindowMargin;
 
     std::string startDate;
     std::string endDate;
@@ -80,6 +81,8 @@ public:
         return random;
     }
 
+    virtual ant::PiecewiseInterval<double> GetTaggerHitWindows() const override;
+
     virtual std::string GetStartDate() const override final {
         return startDate;
     }
@@ -133,6 +136,10 @@ protected:
         random.emplace_back(i);
     }
 
+    /**
+     * @brief SetTimeRange for setups not registered with AUTO_REGISTER_SETUP_TIMERANGE,
+     * otherwise the registered time range is already set
+     */
     void SetTimeRange(const std::string& start, const std::string& end) {
         startDate = start;
         endDate = end;
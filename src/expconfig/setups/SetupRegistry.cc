@@ -4,7 +4,9 @@
 
 #include "base/Logger.h"
 #include "base/std_ext/string.h"
+#include "base/std_ext/time.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
@@ -27,18 +29,49 @@ shared_ptr<Setup> SetupRegistry::GetSetup(const string& name)
         if(it_setupcreator == setup_creators.end())
             return nullptr;
         // found creator
-        auto setup = it_setupcreator->second(name, get_instance().options);
+        auto setup = it_setupcreator->second.creator(name, get_instance().options);
         if(setup->GetName() != name)
             throw std::runtime_error(std_ext::formatter()
                                      << "Setup name " << name << " does not match GetName() " << setup->GetName());
+        // the registered time range is used for auto-detection before the setup exists
+        const auto& timerange = it_setupcreator->second.timerange;
+        if(!timerange.empty() &&
+           (setup->GetStartDate() != timerange.StartDate || setup->GetEndDate() != timerange.EndDate))
+            throw std::runtime_error(std_ext::formatter()
+                                     << "Setup " << name << " changed its registered time range "
+                                     << timerange.StartDate << " to " << timerange.EndDate);
         it_setup = setups.emplace_hint(it_setup, name, setup);
     }
     return it_setup->second;
 }
 
-void SetupRegistry::RegisterSetup(Creator creator, string name)
+void SetupRegistry::RegisterSetup(Creator creator, string name, TimeRange_t timerange)
+{
+    setup_creators[name] = {creator, timerange};
+    timerange_index_valid = false;
+}
+
+void SetupRegistry::build_timerange_index()
 {
-    setup_creators[name] = creator;
+    // convert the dates once, same conversion as in std_ext::time_between used by Setup::Matches
+    timerange_index.clear();
+    for(const auto& entry : setup_creators) {
+        const auto& timerange = entry.second.timerange;
+        if(timerange.empty())
+            continue;
+        timerange_index.push_back({std_ext::to_time_t(timerange.StartDate, false),
+                                   std_ext::to_time_t(timerange.EndDate, true),
+                                   0, entry.first});
+    }
+    sort(timerange_index.begin(), timerange_index.end(),
+         [] (const timerange_item_t& a, const timerange_item_t& b) {
+        return a.Start < b.Start;
+    });
+    for(size_t i=0;i<timerange_index.size();i++) {
+        auto& item = timerange_index[i];
+        item.MaxStop = i==0 ? item.Stop : max(item.Stop, timerange_index[i-1].MaxStop);
+    }
+    timerange_index_valid = true;
 }
 
 SetupRegistry::SetupRegistry() : options(make_shared<const OptionsList>())
@@ -65,6 +98,45 @@ list<string> SetupRegistry::GetNames()
     return list;
 }
 
+SetupRegistry::TimeRange_t SetupRegistry::GetTimeRange(const string& name)
+{
+    auto& setup_creators = get_instance().setup_creators;
+    auto it_setupcreator = setup_creators.find(name);
+    if(it_setupcreator == setup_creators.end())
+        return {};
+    return it_setupcreator->second.timerange;
+}
+
+list<string> SetupRegistry::GetNamesByTimestamp(time_t timestamp)
+{
+    auto& instance = get_instance();
+    if(!instance.timerange_index_valid)
+        instance.build_timerange_index();
+    const auto& index = instance.timerange_index;
+
+    // all items before it_start begin before the timestamp,
+    // go back until no earlier item reaches the timestamp anymore
+    auto it_start = lower_bound(index.begin(), index.end(), timestamp,
+                                [] (const timerange_item_t& item, time_t t) {
+        return item.Start < t;
+    });
+
+    list<string> names;
+    for(auto it = it_start; it != index.begin(); ) {
+        --it;
+        if(it->MaxStop <= timestamp)
+            break;
+        if(it->Stop > timestamp)
+            names.emplace_front(it->Name);
+    }
+
+    for(const auto& entry : instance.setup_creators) {
+        if(entry.second.timerange.empty())
+            names.emplace_back(entry.first);
+    }
+    return names;
+}
+
 void SetupRegistry::AddSetup(const string& name, shared_ptr<Setup> setup)
 {
     get_instance().setups[name] = setup;
@@ -77,7 +149,7 @@ void SetupRegistry::SetSetupOptions(OptionsPtr opt)
     get_instance().options = opt;
 }
 
-SetupRegistration::SetupRegistration(SetupRegistry::Creator creator, string name)
+SetupRegistration::SetupRegistration(SetupRegistry::Creator creator, string name, SetupRegistry::TimeRange_t timerange)
 {
-    SetupRegistry::get_instance().RegisterSetup(creator, name);
+    SetupRegistry::get_instance().RegisterSetup(creator, name, timerange);
 }
@@ -2,10 +2,13 @@
 
 #include "base/OptionsList.h"
 
+#include <ctime>
 #include <map>
 #include <list>
 #include <memory>
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace ant {
 namespace expconfig {
@@ -15,22 +18,47 @@ class Setup;
 /**
  * @brief The SetupRegistry class semi-automatically registers Setups
  *
- * \note don't forget to use AUTO_REGISTER_SETUP
+ * \note don't forget to use AUTO_REGISTER_SETUP_TIMERANGE (or AUTO_REGISTER_SETUP for setups not bound to a beamtime)
  * \note linking order is important to get this registry properly working, see CMakeLists.txt
  */
 class SetupRegistry
 {
 friend class SetupRegistration;
 
+public:
+    /**
+     * @brief The TimeRange_t struct is the registered beamtime of a setup, see Setup::Matches
+     */
+    struct TimeRange_t {
+        std::string StartDate;
+        std::string EndDate;
+        bool empty() const { return StartDate.empty() || EndDate.empty(); }
+    };
+
 private:
     using Creator = std::function<std::shared_ptr<Setup>(const std::string& name, OptionsPtr)>;
-    using setup_creators_t = std::map<std::string, Creator>;
+    struct registration_t {
+        Creator creator;
+        TimeRange_t timerange;
+    };
+    using setup_creators_t = std::map<std::string, registration_t>;
     using setups_t = std::map<std::string, std::shared_ptr<Setup> >;
     setup_creators_t setup_creators;
     setups_t setups;
     OptionsPtr options;
 
-    void RegisterSetup(Creator, std::string);
+    // registered time ranges sorted by start, built on first use
+    struct timerange_item_t {
+        std::time_t Start;
+        std::time_t Stop;
+        std::time_t MaxStop; // maximum Stop of all items up to this one
+        std::string Name;
+    };
+    std::vector<timerange_item_t> timerange_index;
+    bool timerange_index_valid = false;
+    void build_timerange_index();
+
+    void RegisterSetup(Creator, std::string, TimeRange_t);
     static SetupRegistry& get_instance();
 
     SetupRegistry();
@@ -38,6 +66,22 @@ private:
 public:
     static std::shared_ptr<Setup> GetSetup(const std::string& name);
     static std::list<std::string> GetNames();
+
+    /**
+     * @brief GetTimeRange returns the time range the setup was registered with
+     * @param name of the setup
+     * @return empty if the setup was registered without time range
+     */
+    static TimeRange_t GetTimeRange(const std::string& name);
+
+    /**
+     * @brief GetNamesByTimestamp finds the setups which may match the given timestamp without creating them,
+     * setups registered without time range are always included, as only their Setup::Matches can tell
+     * @param timestamp unix epoch, usually TID::Timestamp
+     * @return names of candidate setups, check them with Setup::Matches
+     */
+    static std::list<std::string> GetNamesByTimestamp(std::time_t timestamp);
+
     static void AddSetup(const std::string& name, std::shared_ptr<Setup> setup);
     static void SetSetupOptions(OptionsPtr opt);
     static void Cleanup();
@@ -49,7 +93,7 @@ public:
 class SetupRegistration
 {
 public:
-    SetupRegistration(SetupRegistry::Creator, std::string);
+    SetupRegistration(SetupRegistry::Creator, std::string, SetupRegistry::TimeRange_t = {});
 };
 
 template<class T>
@@ -61,4 +105,12 @@ std::shared_ptr<Setup> setup_factory(const std::string& name, OptionsPtr opt)
 #define AUTO_REGISTER_SETUP(setup) \
     SetupRegistration _setup_registration_ ## setup(ant::expconfig::setup_factory<setup>, #setup);
 
+/**
+ * @brief AUTO_REGISTER_SETUP_TIMERANGE registers the setup together with its beamtime,
+ * given as ISO dates like "2014-07-29". Prefer this over calling Setup::SetTimeRange,
+ * as ExpConfig::Setup::SetByTID then only creates the matching setup.
+ */
+#define AUTO_REGISTER_SETUP_TIMERANGE(setup, start, end) \
+    SetupRegistration _setup_registration_ ## setup(ant::expconfig::setup_factory<setup>, #setup, {start, end});
+
 }} // namespace ant::expconfig
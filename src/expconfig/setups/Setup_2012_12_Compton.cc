@@ -17,9 +17,6 @@ public:
 
     Setup_2012_12_Compton(const std::string& name, OptionsPtr opt) : Setup(name, opt)
     {
-        /// \todo refine time range for this setup describing the 2012-12 Compton beamtime?
-        SetTimeRange("2012-12-01", "2012-12-31");
-
         auto cb = make_shared<detector::CB>();
         AddDetector(cb);
 
@@ -44,7 +41,8 @@ public:
     }
 };
 
-AUTO_REGISTER_SETUP(Setup_2012_12_Compton)
+/// \todo refine time range for this setup describing the 2012-12 Compton beamtime?
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2012_12_Compton, "2012-12-01", "2012-12-31")
 
 
 }}} // namespace ant::expconfig::setup
@@ -17,8 +17,6 @@ public:
     Setup_2014_12_EPT_Prod(const std::string& name, OptionsPtr opt)
         : Setup_2014_EPT(name, opt)
     {
-        SetTimeRange("2014-12-01", "2014-12-22");
-
         CB->SetElementFlag(Detector_t::ElementFlag_t::Broken, {265,549,557,565,597,677});
         CB->SetElementFlag(Detector_t::ElementFlag_t::BadTDC, {662,678,17,59,162,265,418,582,586,672,696});
         CB->SetElementFlag(Detector_t::ElementFlag_t::NoCalibFill,{17,678});
@@ -37,6 +35,6 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2014_12_EPT_Prod)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2014_12_EPT_Prod, "2014-12-01", "2014-12-22")
 
 }}} // namespace ant::expconfig::setup
@@ -185,8 +185,6 @@ Setup_2017_03::Setup_2017_03(const string& name, OptionsPtr opt) :
     AddPromptRange({-2.5, 2.5});
     AddRandomRange({ -50,  -5});
     AddRandomRange({  5,   50});
-
-    SetTimeRange("2017-03-14", "2017-03-27");
 }
 
 double Setup_2017_03::GetElectronBeamEnergy() const {
@@ -224,6 +222,6 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2017_03::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2017_03)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2017_03, "2017-03-14", "2017-03-27")
 
 
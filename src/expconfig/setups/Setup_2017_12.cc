@@ -28,8 +28,6 @@ public:
         Setup_2017Plus_NewTagger_Base(name, opt),
         Tagger(make_shared<detector::Tagger_2017_12>())
     {
-        SetTimeRange("2017-11-28", "2017-12-18");
-
         // add the specific Tagger cabling
         AddDetector(Tagger);
 
@@ -96,7 +94,7 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2017_12)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2017_12, "2017-11-28", "2017-12-18")
 
 
 }}} // namespace ant::expconfig::setup
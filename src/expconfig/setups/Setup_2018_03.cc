@@ -28,8 +28,6 @@ public:
         Setup_2017Plus_NewTagger_Base(name, opt),
         Tagger(make_shared<detector::Tagger_2018_03>())
     {
-        SetTimeRange("2018-03-21", "2018-04-07");
-
         // add the specific Tagger cabling
         AddDetector(Tagger);
 
@@ -102,7 +100,7 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2018_03)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2018_03, "2018-03-21", "2018-04-07")
 
 
 }}} // namespace ant::expconfig::setup
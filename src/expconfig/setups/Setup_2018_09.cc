@@ -28,8 +28,6 @@ public:
         Setup_2017Plus_NewTagger_Base(name, opt),
         Tagger(make_shared<detector::Tagger_2018_03>())
     {
-        SetTimeRange("2018-09-11", "2018-10-01");
-
         // add the specific Tagger cabling
         AddDetector(Tagger);
 
@@ -109,7 +107,7 @@ public:
 };
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2018_09)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2018_09, "2018-09-11", "2018-10-01")
 
 
 }}} // namespace ant::expconfig::setup
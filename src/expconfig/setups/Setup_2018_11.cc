@@ -219,8 +219,6 @@ Setup_2018_11::Setup_2018_11(const string& name, OptionsPtr opt) :
     AddPromptRange({-6, 8});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2018-11-19", "2018-12-03");
 }
 
 double Setup_2018_11::GetElectronBeamEnergy() const {
@@ -278,4 +276,4 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2018_11::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2018_11)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2018_11, "2018-11-19", "2018-12-03")
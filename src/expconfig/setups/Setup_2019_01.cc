@@ -219,8 +219,6 @@ Setup_2019_01::Setup_2019_01(const string& name, OptionsPtr opt) :
     AddPromptRange({-6, 8});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2019-01-14", "2019-01-25");
 }
 
 double Setup_2019_01::GetElectronBeamEnergy() const {
@@ -278,5 +276,5 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2019_01::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2019_01)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2019_01, "2019-01-14", "2019-01-25")
 
@@ -223,8 +223,6 @@ Setup_2019_06::Setup_2019_06(const string& name, OptionsPtr opt) :
     AddPromptRange({-6, 8});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2019-06-18", "2019-07-01");
 }
 
 double Setup_2019_06::GetElectronBeamEnergy() const {
@@ -282,5 +280,5 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2019_06::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2019_06)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2019_06, "2019-06-18", "2019-07-01")
 
@@ -230,8 +230,6 @@ Setup_2019_07::Setup_2019_07(const string& name, OptionsPtr opt) :
     AddPromptRange({-6, 8});
     AddRandomRange({ -100,  -50});
     AddRandomRange({  50,   100});
-
-    SetTimeRange("2019-07-16", "2019-08-05");
 }
 
 double Setup_2019_07::GetElectronBeamEnergy() const {
@@ -289,5 +287,5 @@ ant::UnpackerA2GeantConfig::promptrandom_config_t Setup_2019_07::GetPromptRandom
 }
 
 // don't forget registration
-AUTO_REGISTER_SETUP(Setup_2019_07)
+AUTO_REGISTER_SETUP_TIMERANGE(Setup_2019_07, "2019-07-16", "2019-08-05")
 
@@ -25,6 +25,56 @@ CandidateBuilder::CandidateBuilder() :
     tapsveto(ExpConfig::Setup::GetDetector<det_type<decltype(tapsveto)>::type>()),
     config(ExpConfig::Setup::Get().GetCandidateBuilderConfig())
 {
+    if(cb && pid) {
+        double dphi_max = 0;
+        for(unsigned ch=0;ch<pid->GetNChannels();ch++)
+            dphi_max = max(dphi_max, pid->dPhi(ch) + config.PID_Phi_Epsilon);
+        // make the bins slightly wider to be safe against rounding
+        if(dphi_max > 0)
+            pid_phi_bins = max(1u, unsigned(floor(2*M_PI/(1.01*dphi_max))));
+    }
+
+    if(taps && tapsveto) {
+        const auto nTAPSChannels = taps->GetNChannels();
+        nVetoChannels = tapsveto->GetNChannels();
+        taps_veto_channel.resize(nTAPSChannels);
+        taps_veto_neighbours.assign(nTAPSChannels*nVetoChannels, false);
+        for(unsigned ch=0;ch<nTAPSChannels;ch++) {
+            taps_veto_channel[ch] = taps->GetHexChannel(ch);
+            // convert neighbouring baf2/pbwo4 channel ids to channel identifiers
+            // which could be matched with Veto channels
+            for(auto neighbour : taps->GetClusterElement(ch)->Neighbours) {
+                const auto veto_channel = taps->GetHexChannel(neighbour);
+                if(veto_channel < nVetoChannels)
+                    taps_veto_neighbours[ch*nVetoChannels + veto_channel] = true;
+            }
+        }
+    }
+}
+
+unsigned CandidateBuilder::GetPhiBin(double phi) const
+{
+    if(!isfinite(phi))
+        return 0;
+    // phi is within [-pi, pi], pi is the same as -pi
+    const auto bin = unsigned(floor((vec2::Phi_mpi_pi(phi) + M_PI)/(2*M_PI)*pid_phi_bins));
+    return bin % pid_phi_bins;
+}
+
+namespace {
+
+// removes the flagged clusters, keeping the order of the others
+void remove_matched(TClusterList& clusters, const vector<bool>& matched)
+{
+    TClusterList remaining;
+    auto it_matched = matched.begin();
+    for(auto it_cluster = clusters.begin(); it_cluster != clusters.end(); ++it_cluster, ++it_matched) {
+        if(!*it_matched)
+            remaining.push_back(it_cluster);
+    }
+    clusters = move(remaining);
+}
+
 }
 
 void CandidateBuilder::Build_PID_CB(sorted_clusters_t& sorted_clusters,
@@ -44,54 +94,78 @@ void CandidateBuilder::Build_PID_CB(sorted_clusters_t& sorted_clusters,
     if(pid_clusters.empty())
         return;
 
-    auto it_pid_cluster = pid_clusters.begin();
+    // sort the CB clusters into phi bins,
+    // keep their index to create the candidates in the order of the CB clusters
+    vector<TClusterList::iterator> cb_its;
+    vector<pair<unsigned, unsigned>> cb_bins; // phi bin, index in cb_its
+    for(auto it_cb_cluster = cb_clusters.begin(); it_cb_cluster != cb_clusters.end(); ++it_cb_cluster) {
+        cb_bins.emplace_back(GetPhiBin(it_cb_cluster->Position.Phi()), cb_its.size());
+        cb_its.emplace_back(it_cb_cluster);
+    }
+    sort(cb_bins.begin(), cb_bins.end());
+
+    vector<bool> cb_matched(cb_its.size(), false);
+    vector<bool> pid_matched;
+    vector<unsigned> matches;
 
-    while(it_pid_cluster != pid_clusters.end()) {
+    for(auto it_pid_cluster = pid_clusters.begin(); it_pid_cluster != pid_clusters.end(); ++it_pid_cluster) {
 
         auto& pid_cluster = *it_pid_cluster;
         const auto pid_phi = pid_cluster.Position.Phi();
         const auto dphi_max = (pid->dPhi(pid_cluster.CentralElement) + config.PID_Phi_Epsilon);
 
-        bool matched = false;
+        matches.clear();
 
-        auto it_cb_cluster = cb_clusters.begin();
+        // the bin of the PID cluster and its neighbours, less if there are only few bins
+        const auto pid_bin = GetPhiBin(pid_phi);
+        const auto n_bins = min(pid_phi_bins, 3u);
+        for(unsigned d=0;d<n_bins;d++) {
+            const auto bin = (pid_bin + pid_phi_bins - 1 + d) % pid_phi_bins;
+            auto range = equal_range(cb_bins.begin(), cb_bins.end(), make_pair(bin, 0u),
+                                     [] (const pair<unsigned, unsigned>& a, const pair<unsigned, unsigned>& b) {
+                return a.first < b.first;
+            });
+            for(auto it = range.first; it != range.second; ++it) {
+                const auto i = it->second;
+                if(cb_matched[i])
+                    continue;
+                const auto cb_phi = cb_its[i]->Position.Phi();
+
+                // calculate phi angle difference.
+                // Phi_mpi_pi() takes care of wrap-arounds at 180/-180 deg
+                const auto dphi = fabs(vec2::Phi_mpi_pi(cb_phi - pid_phi));
+                if(dphi < dphi_max ) // match!
+                    matches.push_back(i);
+            }
+        }
+        sort(matches.begin(), matches.end());
 
-        while(it_cb_cluster != cb_clusters.end()) {
+        for(auto i : matches) {
+            const auto& it_cb_cluster = cb_its[i];
             auto& cb_cluster = *it_cb_cluster;
-            const auto cb_phi = cb_cluster.Position.Phi();
-
-            // calculate phi angle difference.
-            // Phi_mpi_pi() takes care of wrap-arounds at 180/-180 deg
-            const auto dphi = fabs(vec2::Phi_mpi_pi(cb_phi - pid_phi));
-            if(dphi < dphi_max ) { // match!
-
-                candidates.emplace_back(
-                            Detector_t::Type_t::CB | Detector_t::Type_t::PID,
-                            cb_cluster.Energy,
-                            cb_cluster.Position.Theta(),
-                            cb_cluster.Position.Phi(),
-                            cb_cluster.Time,
-                            cb_cluster.Hits.size(),
-                            pid_cluster.Energy,
-                            numeric_limits<double>::quiet_NaN(), // no tracker information
-                            TClusterList{it_cb_cluster, it_pid_cluster}
-                            );
-                all_clusters.push_back(it_cb_cluster);
-                it_cb_cluster = cb_clusters.erase(it_cb_cluster);
-                matched = true;
-            }
-            else {
-                ++it_cb_cluster;
-            }
+            candidates.emplace_back(
+                        Detector_t::Type_t::CB | Detector_t::Type_t::PID,
+                        cb_cluster.Energy,
+                        cb_cluster.Position.Theta(),
+                        cb_cluster.Position.Phi(),
+                        cb_cluster.Time,
+                        cb_cluster.Hits.size(),
+                        pid_cluster.Energy,
+                        numeric_limits<double>::quiet_NaN(), // no tracker information
+                        TClusterList{it_cb_cluster, it_pid_cluster}
+                        );
+            all_clusters.push_back(it_cb_cluster);
+            cb_matched[i] = true;
         }
 
-        if(matched) {
+        const bool matched = !matches.empty();
+        if(matched)
             all_clusters.push_back(it_pid_cluster);
-            it_pid_cluster = pid_clusters.erase(it_pid_cluster);
-        } else {
-            ++it_pid_cluster;
-        }
+        pid_matched.push_back(matched);
     }
+
+    remove_matched(cb_clusters, cb_matched);
+    remove_matched(pid_clusters, pid_matched);
 }
 
 void CandidateBuilder::Build_TAPS_Veto(sorted_clusters_t& sorted_clusters,
@@ -112,51 +186,49 @@ void CandidateBuilder::Build_TAPS_Veto(sorted_clusters_t& sorted_clusters,
         return;
 
 
-    auto it_taps_cluster = taps_clusters.begin();
-    vector<unsigned> neighbours;
-
-    while (it_taps_cluster != taps_clusters.end()) {
+    vector<TClusterList::iterator> veto_its;
+    for(auto it_veto_cluster = veto_clusters.begin(); it_veto_cluster != veto_clusters.end(); ++it_veto_cluster)
+        veto_its.emplace_back(it_veto_cluster);
 
-        const auto& taps_cluster = *it_taps_cluster;
-        auto center = taps->GetHexChannel(taps_cluster.CentralElement);
+    vector<bool> veto_matched(veto_its.size(), false);
+    vector<bool> taps_matched;
 
-        auto it_veto_cluster = veto_clusters.begin();
+    for(auto it_taps_cluster = taps_clusters.begin(); it_taps_cluster != taps_clusters.end(); ++it_taps_cluster) {
 
-        auto matched_veto = veto_clusters.end();
-        neighbours.clear();
+        const auto& taps_cluster = *it_taps_cluster;
+        const auto center = taps_veto_channel.at(taps_cluster.CentralElement);
 
         // only check neighbouring Veto elements for clusters with at least 2 crystals
-        if (taps_cluster.Hits.size() > 1) {
-            neighbours = taps->GetClusterElement(taps_cluster.CentralElement)->Neighbours;
-            // convert neighbouring baf2/pbwo4 channel ids to channel identifiers
-            // which could be matched with Veto channels
-            transform(neighbours.begin(), neighbours.end(),
-                      neighbours.begin(), [=] (const unsigned channel) {
-                return taps->GetHexChannel(channel);
-            });
-        }
+        const bool check_neighbours = taps_cluster.Hits.size() > 1;
+        const auto neighbours = taps_veto_neighbours.begin() + taps_cluster.CentralElement*nVetoChannels;
 
-        while (it_veto_cluster != veto_clusters.end()) {
+        // index in veto_its
+        auto matched_veto = veto_its.size();
 
-            auto& veto_cluster = *it_veto_cluster;
+        for(unsigned i=0;i<veto_its.size();i++) {
+            if(veto_matched[i])
+                continue;
+
+            auto& veto_cluster = *veto_its[i];
 
             // does the hit veto channel match the TAPS central cluster element?
             if (veto_cluster.CentralElement == center)
-                matched_veto = it_veto_cluster;
+                matched_veto = i;
 
             // check the neighbouring Vetos
-            if (find(neighbours.begin(), neighbours.end(),
-                     veto_cluster.CentralElement) != neighbours.end()) {
+            if (check_neighbours && veto_cluster.CentralElement < nVetoChannels
+                && neighbours[veto_cluster.CentralElement]) {
                 // in case the currently checked Veto is one of the central elements neighbours,
                 // check if the deposited energy is higher than in the stored matched Veto element (if existent)
-                if (matched_veto == veto_clusters.end() || veto_cluster.Energy > matched_veto->Energy)
-                    matched_veto = it_veto_cluster;
+                if (matched_veto == veto_its.size() || veto_cluster.Energy > veto_its[matched_veto]->Energy)
+                    matched_veto = i;
             }
-            ++it_veto_cluster;
         }
 
         // match found?
-        if (matched_veto != veto_clusters.end()) {
+        const bool matched = matched_veto != veto_its.size();
+        if (matched) {
+            const auto& it_veto_cluster = veto_its[matched_veto];
             candidates.emplace_back(
                         Detector_t::Type_t::TAPS | Detector_t::Type_t::TAPSVeto,
                         taps_cluster.Energy,
@@ -164,18 +236,19 @@ void CandidateBuilder::Build_TAPS_Veto(sorted_clusters_t& sorted_clusters,
                         taps_cluster.Position.Phi(),
                         taps_cluster.Time,
                         taps_cluster.Hits.size(),
-                        matched_veto->Energy,
+                        it_veto_cluster->Energy,
                         numeric_limits<double>::quiet_NaN(), // no tracker information
-                        TClusterList{it_taps_cluster, matched_veto}
+                        TClusterList{it_taps_cluster, it_veto_cluster}
                         );
             all_clusters.push_back(it_taps_cluster);
-            it_taps_cluster = taps_clusters.erase(it_taps_cluster);
-            all_clusters.push_back(matched_veto);
-            veto_clusters.erase(matched_veto);
-        } else {
-            ++it_taps_cluster;
+            all_clusters.push_back(it_veto_cluster);
+            veto_matched[matched_veto] = true;
         }
+        taps_matched.push_back(matched);
     }
+
+    remove_matched(taps_clusters, taps_matched);
+    remove_matched(veto_clusters, veto_matched);
 }
 
 void CandidateBuilder::Catchall(sorted_clusters_t& sorted_clusters,
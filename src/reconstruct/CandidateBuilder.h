@@ -10,6 +10,7 @@
 #include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace ant {
 
@@ -43,6 +44,19 @@ protected:
 
     const expconfig::Setup_traits::candidatebuilder_config_t config;
 
+    // lookup tables for the current setup, filled in the constructor
+
+    // PID/CB: CB clusters are sorted into phi bins at least as wide as the largest phi difference
+    // accepted for a match, so only the bin of a PID cluster and its neighbours need to be checked
+    unsigned pid_phi_bins = 1;
+    unsigned GetPhiBin(double phi) const;
+
+    // TAPS/Veto: veto channel in front of each TAPS channel,
+    // and bitmap of veto channels in front of the neighbours (row per TAPS channel)
+    std::vector<unsigned> taps_veto_channel;
+    std::vector<bool>     taps_veto_neighbours;
+    unsigned nVetoChannels = 0;
+
     void Build_PID_CB(
             sorted_clusters_t& sorted_clusters,
             candidates_t& candidates, clusters_t& all_clusters
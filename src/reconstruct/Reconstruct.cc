@@ -9,6 +9,7 @@
 #include "tree/TEventData.h"
 
 #include "base/std_ext/container.h"
+#include "base/std_ext/math.h"
 #include "base/Logger.h"
 
 #include <algorithm>
@@ -65,6 +66,7 @@ Reconstruct::sorted_detectors_t Reconstruct::sorted_detectors_t::Build()
 
 Reconstruct::Reconstruct(clustering_t clustering_, candidatebuilder_t candidatebuilder_) :
     includeIgnoredElements(ExpConfig::Setup::Get().GetIncludeIgnoredElements()),
+    taggerHitWindows(ExpConfig::Setup::Get().GetTaggerHitWindows()),
     sorted_detectors(sorted_detectors_t::Build()),
     hooks_readhits(getSortedHooks<decltype(hooks_readhits)>()),
     hooks_clusterhits(getSortedHooks<decltype(hooks_clusterhits)>()),
@@ -237,14 +239,10 @@ void Reconstruct::HandleTagger(const shared_ptr<TaggerDetector_t>& taggerdetecto
                                std::vector<TTaggerHit>& taggerhits
                                ) const
 {
+    if(taggerchannels.size() < taggerdetector->GetNChannels())
+        taggerchannels.resize(taggerdetector->GetNChannels());
 
     // gather electron hits by channel
-    struct taggerhit_t {
-        std::vector<TDetectorReadHit::Value_t> Timings;
-        std::vector<TDetectorReadHit::Value_t> Energies;
-    };
-    map<unsigned, taggerhit_t > hits;
-
     for(const TDetectorReadHit& readhit : readhits) {
         if(!includeIgnoredElements && taggerdetector->IsIgnored(readhit.Channel))
             continue;
@@ -253,30 +251,49 @@ void Reconstruct::HandleTagger(const shared_ptr<TaggerDetector_t>& taggerdetecto
         if(readhit.Values.empty())
             continue;
 
-        auto& item = hits[readhit.Channel];
+        if(readhit.Channel >= taggerchannels.size())
+            taggerchannels.resize(readhit.Channel+1);
+
+        auto& item = taggerchannels[readhit.Channel];
+        if(!item.Touched) {
+            item.Touched = true;
+            taggerchannels_touched.push_back(readhit.Channel);
+        }
+
         if(readhit.ChannelType == Channel_t::Type_t::Timing) {
-            std_ext::concatenate(item.Timings, readhit.Values);
+            item.Timings.push_back(addressof(readhit));
         }
-        else if(readhit.ChannelType == Channel_t::Type_t::Integral) {
-            std_ext::concatenate(item.Energies, readhit.Values);
+        else if(readhit.ChannelType == Channel_t::Type_t::Integral && item.Energy == nullptr) {
+            item.Energy = addressof(readhit);
         }
     }
 
-    for(const auto& hit : hits) {
-        const auto channel = hit.first;
-        const auto& item = hit.second;
+    // emit the hits ordered by channel
+    std::sort(taggerchannels_touched.begin(), taggerchannels_touched.end());
+
+    for(const auto channel : taggerchannels_touched) {
+        auto& item = taggerchannels[channel];
+        const auto qdc_energy = item.Energy == nullptr ? std_ext::NaN : item.Energy->Values.front().Calibrated;
         // create a taggerhit from each timing for now
         /// \todo handle double hits here?
         /// \todo handle energies here better? (actually test with appropiate QDC run)
-        const auto qdc_energy = item.Energies.empty() ? std_ext::NaN : item.Energies.front().Calibrated;
-        for(const auto& timing : item.Timings) {
-            taggerhits.emplace_back(channel,
-                                    taggerdetector->GetPhotonEnergy(channel),
-                                    timing.Calibrated,
-                                    qdc_energy
-                                    );
+        for(const auto readhit : item.Timings) {
+            for(const auto& timing : readhit->Values) {
+                if(!taggerHitWindows.empty() && !taggerHitWindows.Contains(timing.Calibrated))
+                    continue;
+                taggerhits.emplace_back(channel,
+                                        taggerdetector->GetPhotonEnergy(channel),
+                                        timing.Calibrated,
+                                        qdc_energy
+                                        );
+            }
         }
+        // keep the allocated memory for the next event
+        item.Touched = false;
+        item.Timings.clear();
+        item.Energy = nullptr;
     }
+    taggerchannels_touched.clear();
 }
 
 void Reconstruct::BuildClusters(
@@ -5,6 +5,8 @@
 
 #include "Reconstruct_traits.h"
 
+#include "base/piecewise_interval.h"
+
 namespace ant {
 
 struct TTaggerHit;
@@ -39,6 +41,9 @@ protected:
 
     const bool includeIgnoredElements = false;
 
+    // tagger hits with timings outside are dropped early, empty means keep all
+    const PiecewiseInterval<double> taggerHitWindows;
+
     // sorted_readhits is mutable in order to
     using sorted_readhits_t = ReconstructHook::Base::readhits_t;
     mutable sorted_readhits_t sorted_readhits;
@@ -56,6 +61,15 @@ protected:
             const std::vector<std::reference_wrapper<TDetectorReadHit>>& readhits,
             std::vector<TTaggerHit>& taggerhits) const;
 
+    // scratch table indexed by tagger channel, only touched channels are reset after each event
+    struct taggerchannel_t {
+        bool Touched = false;
+        std::vector<const TDetectorReadHit*> Timings;
+        const TDetectorReadHit* Energy = nullptr;
+    };
+    mutable std::vector<taggerchannel_t> taggerchannels;
+    mutable std::vector<unsigned> taggerchannels_touched;
+
     using sorted_clusterhits_t = ReconstructHook::Base::clusterhits_t;
     using sorted_clusters_t = ReconstructHook::Base::clusters_t;
     void BuildClusters(const sorted_clusterhits_t& sorted_clusterhits,
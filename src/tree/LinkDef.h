@@ -15,7 +15,7 @@
 
 #pragma link C++ class ant::TID+;
 
-#pragma link C++ class ant::TEvent-; // has its own Streamer implementation with cereal
+#pragma link C++ class ant::TEvent-; // has its own Streamer implementation with TEventCodec/cereal
 
 #pragma link C++ class ant::TCalibrationData+;
 
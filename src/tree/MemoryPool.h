@@ -3,11 +3,18 @@
 #include "base/std_ext/memory.h" // for make_unique
 
 #include <memory>
-#include <forward_list>
+#include <mutex>
+#include <vector>
 
 
 namespace ant {
 
+/**
+ * @brief The MemoryPool struct recycles instances of T, which must provide a Clear() method
+ *
+ * Returned instances are cleared when they are handed out again, so T::Clear() should keep
+ * the capacity of its containers. The pool is thread-safe and holds at most MaxItems instances.
+ */
 template<class T>
 struct MemoryPool {
 
@@ -26,25 +33,57 @@ struct MemoryPool {
         ~Item() {
             if(ptr == nullptr || pool == nullptr)
                return;
-            pool->ReturnToPool(std::move(ptr));
+            pool->Release(std::move(ptr));
         }
         Item(Item&&) = default;
         Item& operator=(Item&&) = default;
     };
 
     static Item Get() {
-        static MemoryPool m;
-        if(m.items.empty()) {
-            return Item(std::addressof(m), std_ext::make_unique<T>());
-        }
-        else {
-            m.items.front()->Clear();
-            Item item(std::addressof(m), std::move(m.items.front()));
-            m.items.pop_front();
-            return item;
+        auto& m = Instance();
+        return Item(std::addressof(m), m.Acquire());
+    }
+
+    /**
+     * @brief Instance returns the pool for T, it is never destroyed,
+     * so instances can be released even during static destruction
+     */
+    static MemoryPool& Instance() {
+        static MemoryPool* m = new MemoryPool();
+        return *m;
+    }
+
+    /**
+     * @brief Acquire a cleared instance from the pool, or a new one if the pool is empty
+     */
+    std::unique_ptr<T> Acquire() {
+        std::unique_ptr<T> ptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!items.empty()) {
+                ptr = std::move(items.back());
+                items.pop_back();
+            }
         }
+        if(!ptr)
+            return std_ext::make_unique<T>();
+        ptr->Clear();
+        return ptr;
+    }
+
+    /**
+     * @brief Release gives an instance back to the pool, it's deleted if the pool is full
+     */
+    void Release(std::unique_ptr<T> ptr) {
+        if(!ptr)
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if(items.size() < MaxItems)
+            items.emplace_back(std::move(ptr));
     }
 
+    std::size_t MaxItems = 1024;
+
     MemoryPool() = default;
     MemoryPool(const MemoryPool&) = delete;
     MemoryPool& operator=(const MemoryPool&) = delete;
@@ -52,10 +91,8 @@ struct MemoryPool {
     MemoryPool& operator=(MemoryPool&&) = delete;
 
 private:
-    std::forward_list<std::unique_ptr<T>> items;
-    void ReturnToPool(std::unique_ptr<T> ptr) {
-        items.push_front(std::move(ptr));
-    }
+    std::mutex mutex;
+    std::vector<std::unique_ptr<T>> items;
 };
 
 }
@@ -1,6 +1,8 @@
 #include "TEvent.h"
 #include "TEventData.h"
 #include "stream_TBuffer.h"
+#include "MemoryPool.h"
+#include "TEventCodec.h"
 
 #include "base/std_ext/memory.h"
 #include "base/Logger.h"
@@ -23,9 +25,68 @@ namespace cereal
   struct specialize<Archive, TParticle, cereal::specialization::member_load_save> {};
 }
 
+// loads like cereal's std::unique_ptr (same layout),
+// but into existing or recycled TEventData instances
+struct TEvent::eventdata_loader_t {
+    std::unique_ptr<TEventData>& eventdata;
+
+    template<class Archive>
+    void load(Archive& archive) {
+        uint8_t valid;
+        archive(cereal::make_nvp("valid", valid));
+        if(!valid) {
+            RecycleEventData(eventdata);
+            return;
+        }
+        if(eventdata)
+            eventdata->Clear();
+        else
+            eventdata = MakeEventData(TID());
+        archive(cereal::make_nvp("data", *eventdata));
+    }
+};
+
+template<class Archive>
+void TEvent::save(Archive& archive, const std::uint32_t version) const
+{
+    if(version != ANT_TEVENT_VERSION)
+        throw std::runtime_error("TEvent version mismatch");
+    archive(reconstructed, mctrue, SavedForSlowControls);
+}
+
+template<class Archive>
+void TEvent::load(Archive& archive, const std::uint32_t version)
+{
+    if(version != ANT_TEVENT_VERSION)
+        throw std::runtime_error("TEvent version mismatch");
+    eventdata_loader_t loader_reconstructed{reconstructed};
+    eventdata_loader_t loader_mctrue{mctrue};
+    archive(cereal::make_nvp("ptr_wrapper", loader_reconstructed),
+            cereal::make_nvp("ptr_wrapper", loader_mctrue),
+            SavedForSlowControls);
+}
+
 // create some TBuffer to std::streambuf interface
+// the compact TEventCodec is preferred, cereal is used for older files
+// and for events the codec cannot represent
 void TEvent::Streamer(TBuffer& R__b)
 {
+    if(R__b.IsReading()) {
+        const auto begin = R__b.Buffer()+R__b.Length();
+        const auto end = R__b.Buffer()+R__b.BufferSize();
+        if(TEventCodec::IsEncoded(begin, end)) {
+            const auto consumed = TEventCodec::Decode(begin, end, *this);
+            R__b.SetBufferOffset(R__b.Length()+static_cast<int>(consumed));
+            return;
+        }
+    }
+    else if(TEventCodec::WriteFormat == TEventCodec::Format_t::Fast) {
+        thread_local vector<char> buffer;
+        if(TEventCodec::Encode(*this, buffer)) {
+            R__b.WriteFastArray(buffer.data(), buffer.size());
+            return;
+        }
+    }
     stream_TBuffer::DoBinary(R__b, *this);
 }
 
@@ -33,21 +94,47 @@ void TEvent::Streamer(TBuffer& R__b)
 // other stuff
 
 TEvent::TEvent() : reconstructed(), mctrue() {}
-TEvent::~TEvent() = default;
+
+TEvent::~TEvent()
+{
+    RecycleEventData(reconstructed);
+    RecycleEventData(mctrue);
+}
 
 TEvent::TEvent(TEvent&&) = default;
-TEvent& TEvent::operator=(TEvent&&) = default;
 
+TEvent& TEvent::operator=(TEvent&& other)
+{
+    if(this == addressof(other))
+        return *this;
+    RecycleEventData(reconstructed);
+    RecycleEventData(mctrue);
+    reconstructed = move(other.reconstructed);
+    mctrue = move(other.mctrue);
+    SavedForSlowControls = other.SavedForSlowControls;
+    ShardOverlap = other.ShardOverlap;
+    return *this;
+}
+
+TEvent::TEvent(const TID& id_reconstructed) :
+    reconstructed(MakeEventData(id_reconstructed))
+{}
+
+TEvent::TEvent(const TID& id_reconstructed, const TID& id_mctrue) :
+    reconstructed(MakeEventData(id_reconstructed)),
+    mctrue(MakeEventData(id_mctrue))
+{}
 
-TEvent::TEvent(const TID& id_reconstructed)
+unique_ptr<TEventData> TEvent::MakeEventData(const TID& id)
 {
-    reconstructed = std_ext::make_unique<TEventData>(id_reconstructed);
+    auto eventdata = MemoryPool<TEventData>::Instance().Acquire();
+    eventdata->ID = id;
+    return eventdata;
 }
 
-TEvent::TEvent(const TID& id_reconstructed, const TID& id_mctrue)
+void TEvent::RecycleEventData(unique_ptr<TEventData>& eventdata)
 {
-    reconstructed = std_ext::make_unique<TEventData>(id_reconstructed);
-    mctrue = std_ext::make_unique<TEventData>(id_mctrue);
+    MemoryPool<TEventData>::Instance().Release(move(eventdata));
 }
 
 namespace ant {
@@ -3,6 +3,8 @@
 #include "Rtypes.h"
 
 #ifndef __CINT__
+#include "base/Shard.h"
+
 #include <memory>
 #include <stdexcept>
 #endif
@@ -34,12 +36,15 @@ struct TEvent
     // indicates that this event was only saved for SlowControl processing
     bool SavedForSlowControls = false;
 
+    // indicates that this event was only read to complete slowcontrol information
+    // at the edges of a shard, not serialized
+    Shard::Overlap_t ShardOverlap = Shard::Overlap_t::None;
+
+    // only instantiated in TEvent.cc
     template<class Archive>
-    void serialize(Archive& archive, const std::uint32_t version) {
-        if(version != ANT_TEVENT_VERSION)
-            throw std::runtime_error("TEvent version mismatch");
-        archive(reconstructed, mctrue, SavedForSlowControls);
-    }
+    void save(Archive& archive, const std::uint32_t version) const;
+    template<class Archive>
+    void load(Archive& archive, const std::uint32_t version);
 
     friend std::ostream& operator<<( std::ostream& s, const TEvent& o);
 
@@ -56,6 +61,13 @@ protected:
     std::unique_ptr<TEventData> reconstructed;  //! reconstructed detector information, either Geant or raw data
     std::unique_ptr<TEventData> mctrue;  //! MC true information from event generator
 
+    // the TEventData instances are recycled via a MemoryPool,
+    // which avoids most allocations in the event loop
+    static std::unique_ptr<TEventData> MakeEventData(const TID& id);
+    static void RecycleEventData(std::unique_ptr<TEventData>& eventdata);
+    struct eventdata_loader_t;
+    friend struct TEventCodec;
+
 #endif
 
 public:
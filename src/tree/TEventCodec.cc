@@ -0,0 +1,574 @@
+#include "TEventCodec.h"
+
+#include "TEvent.h"
+#include "TEventData.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+using namespace ant;
+
+TEventCodec::Format_t TEventCodec::WriteFormat = TEventCodec::Format_t::Fast;
+
+namespace {
+
+// cereal writes the TEvent version first, which is small,
+// so the magic can never be confused with it
+constexpr uint32_t Magic = 0x45544e41; // "ANTE"
+constexpr uint8_t Version = 1;
+
+enum event_flags_t : uint8_t {
+    HasReconstructed = 1 << 0,
+    HasMCTrue = 1 << 1,
+    SavedForSlowControls = 1 << 2
+};
+
+static_assert(is_trivially_copyable<TDetectorReadHit::Value_t>::value &&
+              sizeof(TDetectorReadHit::Value_t) == 2*sizeof(double),
+              "Value_t cannot be copied in bulk");
+
+struct writer_t {
+    vector<char>& b;
+
+    void bytes(const void* data, size_t n) {
+        const auto pos = b.size();
+        b.resize(pos + n);
+        if(n>0)
+            memcpy(addressof(b[pos]), data, n);
+    }
+
+    template<typename T>
+    void pod(const T& v) {
+        static_assert(is_trivially_copyable<T>::value, "Can only write trivially copyable types");
+        bytes(addressof(v), sizeof(T));
+    }
+
+    void varint(uint64_t v) {
+        while(v >= 0x80) {
+            b.push_back(static_cast<char>(v | 0x80));
+            v >>= 7;
+        }
+        b.push_back(static_cast<char>(v));
+    }
+
+    void svarint(int64_t v) {
+        // zigzag encoding
+        varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    }
+
+    template<typename T>
+    void pods(const vector<T>& v) {
+        static_assert(is_trivially_copyable<T>::value, "Can only write trivially copyable types");
+        varint(v.size());
+        bytes(v.data(), v.size()*sizeof(T));
+    }
+
+    void bits(const vector<bool>& v) {
+        varint(v.size());
+        for(size_t i=0;i<v.size();i+=8) {
+            uint8_t byte = 0;
+            for(size_t j=0;j<8 && i+j<v.size();j++)
+                byte |= v[i+j] << j;
+            pod(byte);
+        }
+    }
+
+    void str(const string& s) {
+        varint(s.size());
+        bytes(s.data(), s.size());
+    }
+};
+
+struct reader_t {
+    const char* it;
+    const char* const end;
+
+    void need(size_t n) const {
+        if(static_cast<size_t>(end - it) < n)
+            throw TEventCodec::Exception("Unexpected end of encoded TEvent");
+    }
+
+    void bytes(void* data, size_t n) {
+        need(n);
+        if(n>0)
+            memcpy(data, it, n);
+        it += n;
+    }
+
+    template<typename T>
+    T pod() {
+        T v;
+        bytes(addressof(v), sizeof(T));
+        return v;
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for(unsigned shift=0;shift<64;shift+=7) {
+            need(1);
+            const auto byte = static_cast<uint8_t>(*it++);
+            v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if(!(byte & 0x80))
+                return v;
+        }
+        throw TEventCodec::Exception("Malformed varint in encoded TEvent");
+    }
+
+    int64_t svarint() {
+        const auto v = varint();
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    // every item takes at least one byte, which protects against huge allocations
+    size_t size() {
+        const auto n = varint();
+        need(n);
+        return n;
+    }
+
+    template<typename T>
+    void pods(vector<T>& v) {
+        const auto n = varint();
+        need(n*sizeof(T));
+        v.resize(n);
+        bytes(v.data(), n*sizeof(T));
+    }
+
+    void bits(vector<bool>& v) {
+        const auto n = varint();
+        need((n+7)/8);
+        v.resize(n);
+        for(size_t i=0;i<n;i+=8) {
+            const auto byte = pod<uint8_t>();
+            for(size_t j=0;j<8 && i+j<n;j++)
+                v[i+j] = (byte >> j) & 1;
+        }
+    }
+
+    void str(string& s) {
+        const auto n = size();
+        s.assign(it, n);
+        it += n;
+    }
+};
+
+// Detector_t::Any_t keeps its bits protected
+uint32_t to_mask(const Detector_t::Any_t& detector) {
+    uint32_t mask = 0;
+    for(unsigned i=0;i<32;i++) {
+        if(detector.test(static_cast<Detector_t::Type_t>(i)))
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
+Detector_t::Any_t from_mask(uint32_t mask) {
+    Detector_t::Any_t detector = Detector_t::Any_t::None;
+    for(unsigned i=0;i<32;i++) {
+        if(mask & (1u << i))
+            detector |= static_cast<Detector_t::Type_t>(i);
+    }
+    return detector;
+}
+
+template<typename List>
+long long find_index(const List& list, const void* item) {
+    long long i = 0;
+    for(const auto& entry : list) {
+        if(addressof(entry) == item)
+            return i;
+        i++;
+    }
+    return -1;
+}
+
+void write(writer_t& w, const TID& id) {
+    w.pod(id.Flags);
+    w.pod(id.Timestamp);
+    w.pod(id.Lower);
+    w.pod(id.Reserved);
+}
+
+void read(reader_t& r, TID& id) {
+    id.Flags = r.pod<uint32_t>();
+    id.Timestamp = r.pod<uint32_t>();
+    id.Lower = r.pod<uint32_t>();
+    id.Reserved = r.pod<uint32_t>();
+}
+
+template<typename T>
+void write(writer_t& w, const vector<TKeyValue<T>>& payload) {
+    w.varint(payload.size());
+    for(const auto& kv : payload) {
+        w.varint(kv.Key);
+        w.pod(kv.Value);
+    }
+}
+
+void write(writer_t& w, const vector<TKeyValue<string>>& payload) {
+    w.varint(payload.size());
+    for(const auto& kv : payload) {
+        w.varint(kv.Key);
+        w.str(kv.Value);
+    }
+}
+
+template<typename T>
+void read(reader_t& r, vector<TKeyValue<T>>& payload) {
+    payload.resize(r.size());
+    for(auto& kv : payload) {
+        kv.Key = r.varint();
+        kv.Value = r.pod<T>();
+    }
+}
+
+void read(reader_t& r, vector<TKeyValue<string>>& payload) {
+    payload.resize(r.size());
+    for(auto& kv : payload) {
+        kv.Key = r.varint();
+        r.str(kv.Value);
+    }
+}
+
+void write(writer_t& w, const TClusterHit& hit) {
+    w.varint(hit.Channel);
+    w.pod(hit.Energy);
+    w.pod(hit.Time);
+    w.varint(hit.Data.size());
+    for(const auto& datum : hit.Data) {
+        w.pod(datum.Type);
+        w.pod(datum.Value);
+    }
+}
+
+void read(reader_t& r, TClusterHit& hit) {
+    hit.Channel = r.varint();
+    hit.Energy = r.pod<double>();
+    hit.Time = r.pod<double>();
+    hit.Data.resize(r.size());
+    for(auto& datum : hit.Data) {
+        datum.Type = r.pod<Channel_t::Type_t>();
+        datum.Value = r.pod<TDetectorReadHit::Value_t>();
+    }
+}
+
+struct particles_t {
+    vector<const TParticle*> seen;
+};
+
+bool write(writer_t& w, const TParticleTree_t& node, const TCandidateList& candidates, particles_t& particles) {
+    const auto& particle = node->Get();
+    w.pod(static_cast<uint8_t>(particle ? 1 : 0));
+    if(particle) {
+        // shared particles are only restored by cereal
+        const auto ptr = addressof(*particle);
+        if(find(particles.seen.begin(), particles.seen.end(), ptr) != particles.seen.end())
+            return false;
+        particles.seen.push_back(ptr);
+
+        w.varint(particle->TypeUID());
+        w.pod(static_cast<const LorentzVec&>(*particle));
+        long long candidate_index = -1;
+        if(particle->Candidate) {
+            candidate_index = find_index(candidates, addressof(*particle->Candidate));
+            if(candidate_index < 0)
+                return false;
+        }
+        w.varint(candidate_index+1);
+    }
+    w.varint(node->Daughters().size());
+    for(const auto& daughter : node->Daughters()) {
+        if(!write(w, daughter, candidates, particles))
+            return false;
+    }
+    return true;
+}
+
+TParticleTree_t read_particletree(reader_t& r, const TCandidateList& candidates) {
+    TParticlePtr particle;
+    if(r.pod<uint8_t>()) {
+        const auto uid = static_cast<unsigned>(r.varint());
+        const auto lv = r.pod<LorentzVec>();
+        auto p = make_shared<TParticle>(TParticle::TypeFromUID(uid), lv);
+        const auto candidate_index = r.varint();
+        if(candidate_index > candidates.size())
+            throw TEventCodec::Exception("Invalid candidate index in encoded TEvent");
+        if(candidate_index > 0)
+            p->Candidate = candidates.get_ptr_at(candidate_index-1);
+        particle = p;
+    }
+    auto node = Tree<TParticlePtr>::MakeNode(particle);
+    const auto nDaughters = r.size();
+    for(size_t i=0;i<nDaughters;i++)
+        node->AddDaughter(read_particletree(r, candidates));
+    return node;
+}
+
+bool write(writer_t& w, const TEventData& d) {
+    write(w, d.ID);
+
+    w.varint(d.DetectorReadHits.size());
+    for(const auto& hit : d.DetectorReadHits) {
+        w.pod(hit.DetectorType);
+        w.pod(hit.ChannelType);
+        w.varint(hit.Channel);
+        w.pods(hit.RawData);
+        w.pods(hit.Values);
+        w.bits(hit.ValueBits);
+    }
+
+    w.varint(d.SlowControls.size());
+    for(const auto& sc : d.SlowControls) {
+        w.pod(sc.Type);
+        w.pod(sc.Validity);
+        w.svarint(sc.Timestamp);
+        w.str(sc.Name);
+        w.str(sc.Description);
+        write(w, sc.Payload_Int);
+        write(w, sc.Payload_Float);
+        write(w, sc.Payload_String);
+    }
+
+    w.varint(d.UnpackerMessages.size());
+    for(const auto& msg : d.UnpackerMessages) {
+        w.pod(msg.Level);
+        w.str(msg.Message);
+        w.pods(msg.Payload);
+    }
+
+    w.varint(d.TaggerHits.size());
+    for(const auto& taggerhit : d.TaggerHits) {
+        w.varint(taggerhit.Channel);
+        w.pod(taggerhit.PhotonEnergy);
+        w.pod(taggerhit.Time);
+        w.varint(taggerhit.Electrons.size());
+        for(const auto& electron : taggerhit.Electrons) {
+            w.varint(electron.Channel);
+            w.pod(electron.Timing);
+            w.pod(electron.QDCEnergy);
+        }
+    }
+
+    w.pod(d.Trigger.CBEnergySum);
+    w.varint(d.Trigger.ClusterMultiplicity);
+    w.pod(d.Trigger.CBTiming);
+    w.varint(d.Trigger.DAQEventID);
+    w.varint(d.Trigger.DAQErrors.size());
+    for(const auto& error : d.Trigger.DAQErrors) {
+        w.varint(error.ModuleID);
+        w.varint(error.ModuleIndex);
+        w.svarint(error.ErrorCode);
+        w.str(error.ModuleName);
+    }
+
+    w.pod(d.Target.Vertex);
+
+    w.varint(d.Clusters.size());
+    for(const auto& cluster : d.Clusters) {
+        w.pod(cluster.Energy);
+        w.pod(cluster.Time);
+        w.pod(cluster.Position);
+        w.pod(cluster.DetectorType);
+        w.varint(cluster.CentralElement);
+        w.varint(cluster.Flags);
+        w.pod(cluster.ShortEnergy);
+        w.varint(cluster.Hits.size());
+        for(const auto& hit : cluster.Hits)
+            write(w, hit);
+    }
+
+    w.varint(d.Candidates.size());
+    for(const auto& candidate : d.Candidates) {
+        w.varint(to_mask(candidate.Detector));
+        w.pod(candidate.CaloEnergy);
+        w.pod(candidate.Theta);
+        w.pod(candidate.Phi);
+        w.pod(candidate.Time);
+        w.varint(candidate.ClusterSize);
+        w.pod(candidate.VetoEnergy);
+        w.pod(candidate.TrackerEnergy);
+        w.varint(candidate.Clusters.size());
+        for(const auto& cluster : candidate.Clusters) {
+            // clusters must be part of this event
+            const auto index = find_index(d.Clusters, addressof(cluster));
+            if(index < 0)
+                return false;
+            w.varint(index);
+        }
+    }
+
+    w.pod(static_cast<uint8_t>(d.ParticleTree ? 1 : 0));
+    if(d.ParticleTree) {
+        particles_t particles;
+        if(!write(w, d.ParticleTree, d.Candidates, particles))
+            return false;
+    }
+
+    return true;
+}
+
+void read(reader_t& r, TEventData& d) {
+    read(r, d.ID);
+
+    d.DetectorReadHits.resize(r.size());
+    for(auto& hit : d.DetectorReadHits) {
+        hit.DetectorType = r.pod<Detector_t::Type_t>();
+        hit.ChannelType = r.pod<Channel_t::Type_t>();
+        hit.Channel = r.varint();
+        r.pods(hit.RawData);
+        r.pods(hit.Values);
+        r.bits(hit.ValueBits);
+    }
+
+    d.SlowControls.resize(r.size());
+    for(auto& sc : d.SlowControls) {
+        sc.Type = r.pod<TSlowControl::Type_t>();
+        sc.Validity = r.pod<TSlowControl::Validity_t>();
+        sc.Timestamp = r.svarint();
+        r.str(sc.Name);
+        r.str(sc.Description);
+        read(r, sc.Payload_Int);
+        read(r, sc.Payload_Float);
+        read(r, sc.Payload_String);
+    }
+
+    d.UnpackerMessages.resize(r.size());
+    for(auto& msg : d.UnpackerMessages) {
+        msg.Level = r.pod<TUnpackerMessage::Level_t>();
+        r.str(msg.Message);
+        r.pods(msg.Payload);
+    }
+
+    d.TaggerHits.resize(r.size());
+    for(auto& taggerhit : d.TaggerHits) {
+        taggerhit.Channel = r.varint();
+        taggerhit.PhotonEnergy = r.pod<double>();
+        taggerhit.Time = r.pod<double>();
+        taggerhit.Electrons.resize(r.size());
+        for(auto& electron : taggerhit.Electrons) {
+            electron.Channel = r.varint();
+            electron.Timing = r.pod<double>();
+            electron.QDCEnergy = r.pod<double>();
+        }
+    }
+
+    d.Trigger.CBEnergySum = r.pod<double>();
+    d.Trigger.ClusterMultiplicity = r.varint();
+    d.Trigger.CBTiming = r.pod<double>();
+    d.Trigger.DAQEventID = r.varint();
+    d.Trigger.DAQErrors.resize(r.size());
+    for(auto& error : d.Trigger.DAQErrors) {
+        error.ModuleID = r.varint();
+        error.ModuleIndex = r.varint();
+        error.ErrorCode = r.svarint();
+        r.str(error.ModuleName);
+    }
+
+    d.Target.Vertex = r.pod<vec3>();
+
+    const auto nClusters = r.size();
+    d.Clusters.clear();
+    for(size_t i=0;i<nClusters;i++) {
+        d.Clusters.emplace_back();
+        auto& cluster = d.Clusters.back();
+        cluster.Energy = r.pod<double>();
+        cluster.Time = r.pod<double>();
+        cluster.Position = r.pod<vec3>();
+        cluster.DetectorType = r.pod<Detector_t::Type_t>();
+        cluster.CentralElement = r.varint();
+        cluster.Flags = r.varint();
+        cluster.ShortEnergy = r.pod<double>();
+        cluster.Hits.resize(r.size());
+        for(auto& hit : cluster.Hits)
+            read(r, hit);
+    }
+
+    const auto nCandidates = r.size();
+    d.Candidates.clear();
+    for(size_t i=0;i<nCandidates;i++) {
+        d.Candidates.emplace_back();
+        auto& candidate = d.Candidates.back();
+        candidate.Detector = from_mask(r.varint());
+        candidate.CaloEnergy = r.pod<double>();
+        candidate.Theta = r.pod<double>();
+        candidate.Phi = r.pod<double>();
+        candidate.Time = r.pod<double>();
+        candidate.ClusterSize = r.varint();
+        candidate.VetoEnergy = r.pod<double>();
+        candidate.TrackerEnergy = r.pod<double>();
+        const auto nLinks = r.size();
+        for(size_t j=0;j<nLinks;j++) {
+            const auto index = r.varint();
+            if(index >= d.Clusters.size())
+                throw TEventCodec::Exception("Invalid cluster index in encoded TEvent");
+            candidate.Clusters.push_back(next(d.Clusters.begin(), index));
+        }
+    }
+
+    d.ParticleTree = r.pod<uint8_t>() ? read_particletree(r, d.Candidates) : nullptr;
+}
+
+} // anonymous namespace
+
+bool TEventCodec::Encode(const TEvent& event, vector<char>& buffer)
+{
+    buffer.clear();
+    writer_t w{buffer};
+    w.pod(Magic);
+    w.pod(Version);
+
+    uint8_t flags = 0;
+    if(event.reconstructed)
+        flags |= HasReconstructed;
+    if(event.mctrue)
+        flags |= HasMCTrue;
+    if(event.SavedForSlowControls)
+        flags |= SavedForSlowControls;
+    w.pod(flags);
+
+    if(event.reconstructed && !write(w, *event.reconstructed))
+        return false;
+    if(event.mctrue && !write(w, *event.mctrue))
+        return false;
+    return true;
+}
+
+bool TEventCodec::IsEncoded(const char* begin, const char* end)
+{
+    if(end - begin < static_cast<ptrdiff_t>(sizeof(Magic)))
+        return false;
+    uint32_t magic;
+    memcpy(addressof(magic), begin, sizeof(magic));
+    return magic == Magic;
+}
+
+size_t TEventCodec::Decode(const char* begin, const char* end, TEvent& event)
+{
+    reader_t r{begin, end};
+    if(r.pod<uint32_t>() != Magic)
+        throw Exception("Data does not contain encoded TEvent");
+    const auto version = r.pod<uint8_t>();
+    if(version != Version)
+        throw Exception("TEvent codec version mismatch");
+    const auto flags = r.pod<uint8_t>();
+
+    auto read_eventdata = [&r] (bool present, unique_ptr<TEventData>& eventdata) {
+        if(!present) {
+            TEvent::RecycleEventData(eventdata);
+            return;
+        }
+        if(eventdata)
+            eventdata->Clear();
+        else
+            eventdata = TEvent::MakeEventData(TID());
+        read(r, *eventdata);
+    };
+
+    read_eventdata(flags & HasReconstructed, event.reconstructed);
+    read_eventdata(flags & HasMCTrue, event.mctrue);
+    event.SavedForSlowControls = flags & SavedForSlowControls;
+
+    return static_cast<size_t>(r.it - begin);
+}
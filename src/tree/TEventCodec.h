@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ant {
+
+struct TEvent;
+
+/**
+ * @brief The TEventCodec struct implements the compact binary format of TEvent
+ *
+ * Compared to the generic cereal serialization, arrays of numbers are copied in bulk,
+ * channels and sizes are varint-encoded, and the links from candidates to clusters
+ * and from particles to candidates are stored as indices into the event's lists.
+ * Events which cannot be expressed like this, for example with links to objects outside
+ * the event, are written with cereal as before. Reading detects the format automatically,
+ * so files written with cereal stay readable.
+ */
+struct TEventCodec {
+
+    enum class Format_t {
+        Cereal, Fast
+    };
+
+    /**
+     * @brief WriteFormat used by TEvent::Streamer, choose Cereal for files read by older versions
+     */
+    static Format_t WriteFormat;
+
+    /**
+     * @brief Encode the event into buffer
+     * @param event
+     * @param buffer is cleared first, but keeps its capacity
+     * @return false if the event cannot be encoded, for example due to links to other events
+     */
+    static bool Encode(const TEvent& event, std::vector<char>& buffer);
+
+    /**
+     * @brief IsEncoded checks if the data starts with an encoded event
+     */
+    static bool IsEncoded(const char* begin, const char* end);
+
+    /**
+     * @brief Decode the event, reusing its TEventData instances if present
+     * @param begin
+     * @param end
+     * @param event
+     * @return number of bytes consumed
+     */
+    static std::size_t Decode(const char* begin, const char* end, TEvent& event);
+
+    class Exception : public std::runtime_error {
+        using std::runtime_error::runtime_error; // use base class constructor
+    };
+};
+
+}
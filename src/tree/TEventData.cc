@@ -82,3 +82,22 @@ void TEventData::ClearDetectorReadHits()
 {
     DetectorReadHits.resize(0);
 }
+
+void TEventData::Clear()
+{
+    ID = TID();
+    DetectorReadHits.clear();
+    SlowControls.clear();
+    UnpackerMessages.clear();
+    TaggerHits.clear();
+
+    auto daqerrors = move(Trigger.DAQErrors);
+    daqerrors.clear();
+    Trigger = TTrigger();
+    Trigger.DAQErrors = move(daqerrors);
+    Target = TTarget();
+
+    Clusters.clear();
+    Candidates.clear();
+    ParticleTree = nullptr;
+}
@@ -45,6 +45,12 @@ struct TEventData
 
     void ClearDetectorReadHits();
 
+    /**
+     * @brief Clear resets to an empty event, but keeps the capacity of the containers,
+     * used when recycling instances, see TEvent
+     */
+    void Clear();
+
 };
 
 }
\ No newline at end of file
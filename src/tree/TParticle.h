@@ -5,6 +5,7 @@
 #include "base/types.h"
 #include "base/ParticleType.h"
 #include "base/Tree.h"
+#include "base/FlatTree.h"
 
 #include "base/vec/LorentzVec.h"
 
@@ -20,6 +21,7 @@ struct TParticle;
 using TParticlePtr  = std_ext::cc_shared_ptr<TParticle>;
 using TParticleList = std::vector<TParticlePtr>;
 using TParticleTree_t = Tree<TParticlePtr>::node_t;
+using TParticleFlatTree_t = FlatTree<TParticlePtr>;
 
 
 /**
@@ -68,6 +70,12 @@ struct TParticle : LorentzVec {
         type = std::addressof(ParticleTypeDatabase::types.at(uid));
     }
 
+    // for compact serialization, see TEventCodec
+    unsigned TypeUID() const { return type->UID; }
+    static const ParticleTypeDatabase::Type& TypeFromUID(unsigned uid) {
+        return ParticleTypeDatabase::types.at(uid);
+    }
+
     TParticle(const TParticle&) = delete;
     TParticle& operator= (const TParticle&) = delete;
     TParticle(TParticle&&) = default;
@@ -2,11 +2,15 @@
 
 #include "base/Logger.h"
 #include "base/std_ext/memory.h"
+#include "base/std_ext/string.h"
 
 #include <cstdio> // for BUFSIZ
 #include <cstring> // for strerror
 #include <limits>
 #include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <list>
 
 extern "C" {
 #include <lzma.h>
@@ -43,9 +47,49 @@ void RawFileReader::open(const string& filename, const size_t inbufsize) {
         p = std_ext::make_unique<PlainBase>(filename);
     }
 
+    this->filename = filename;
+    position = 0;
     progress = MakeProgressCounter();
 }
 
+streamsize RawFileReader::GetUncompressedSize() const
+{
+    const auto size = p->filesize_uncompressed();
+    if(size >= 0)
+        return size;
+
+    // the compression format does not tell us,
+    // so count by decompressing it with a second reader
+    LOG(INFO) << "Decompressing " << filename << " once to determine its size";
+    RawFileReader counter;
+    counter.open(filename);
+    vector<char> buffer(1 << 20);
+    streamsize total = 0;
+    do {
+        counter.read(buffer.data(), buffer.size());
+        total += counter.gcount();
+    }
+    while(counter.gcount() == streamsize(buffer.size()));
+    return total;
+}
+
+void RawFileReader::seek(streamsize offset, const seekpoints_t& seekpoints)
+{
+    streamsize reached = p->seek(offset, seekpoints);
+
+    // skip the remaining bytes by reading them
+    vector<char> buffer(min<streamsize>(offset - reached, 1 << 20));
+    while(reached < offset) {
+        const streamsize n = min<streamsize>(offset - reached, buffer.size());
+        p->read(buffer.data(), n);
+        if(p->gcount() != n)
+            throw Exception(std_ext::formatter() << "Cannot seek to offset " << offset
+                            << " beyond end of file " << filename);
+        reached += n;
+    }
+    position = offset;
+}
+
 RawFileReader::progress_t RawFileReader::MakeProgressCounter()
 {
     // in future, there might be more than one compressed reader
@@ -139,6 +183,176 @@ void RawFileReader::XZ::init_decoder()
     }
 }
 
+namespace {
+
+// walk backwards through the (possibly concatenated) streams of an xz file,
+// each stream footer tells us the size of its index, see also xz's list.c
+// visit is called with the index, the start of the stream in the file and its check type
+bool visit_xz_indices(const string& filename,
+                      const function<void(const lzma_index*, streamsize, lzma_check)>& visit)
+{
+    ifstream file(filename.c_str(), ios::binary);
+    file.seekg(0, ios::end);
+    streamsize pos = file.tellg();
+
+    while(pos > 0) {
+        // skip stream padding, which consists of null words
+        uint8_t footer[LZMA_STREAM_HEADER_SIZE];
+        uint32_t word = 0;
+        file.seekg(pos-sizeof(word));
+        file.read(reinterpret_cast<char*>(&word), sizeof(word));
+        if(!file)
+            return false;
+        if(word == 0) {
+            pos -= sizeof(word);
+            continue;
+        }
+
+        if(pos < 2*LZMA_STREAM_HEADER_SIZE)
+            return false;
+        file.seekg(pos-LZMA_STREAM_HEADER_SIZE);
+        file.read(reinterpret_cast<char*>(footer), sizeof(footer));
+        lzma_stream_flags flags;
+        if(!file || lzma_stream_footer_decode(&flags, footer) != LZMA_OK)
+            return false;
+
+        const streamsize index_size = flags.backward_size;
+        if(pos < LZMA_STREAM_HEADER_SIZE + index_size)
+            return false;
+        vector<uint8_t> index_buf(index_size);
+        file.seekg(pos-LZMA_STREAM_HEADER_SIZE-index_size);
+        file.read(reinterpret_cast<char*>(index_buf.data()), index_buf.size());
+        if(!file)
+            return false;
+
+        lzma_index* index = nullptr;
+        uint64_t memlimit = UINT64_MAX;
+        size_t in_pos = 0;
+        if(lzma_index_buffer_decode(&index, &memlimit, nullptr,
+                                    index_buf.data(), &in_pos, index_buf.size()) != LZMA_OK)
+            return false;
+
+        pos -= lzma_index_stream_size(index);
+        if(pos < 0) {
+            lzma_index_end(index, nullptr);
+            return false;
+        }
+        visit(index, pos, flags.check);
+        lzma_index_end(index, nullptr);
+    }
+    return pos == 0;
+}
+
+} // namespace
+
+streamsize RawFileReader::XZ::filesize_uncompressed() const
+{
+    streamsize total = 0;
+    const bool ok = visit_xz_indices(filename, [&total] (const lzma_index* index, streamsize, lzma_check) {
+        total += lzma_index_uncompressed_size(index);
+    });
+    return ok ? total : -1;
+}
+
+RawFileReader::seekpoints_t RawFileReader::XZ::seekpoints() const
+{
+    // the streams are visited from the back, so remember
+    // their blocks and sizes before fixing the uncompressed offsets
+    list<pair<seekpoints_t, uint64_t>> streams;
+    const bool ok = visit_xz_indices(filename, [&streams] (const lzma_index* index, streamsize start, lzma_check check) {
+        seekpoints_t blocks;
+        lzma_index_iter iter;
+        lzma_index_iter_init(&iter, index);
+        while(!lzma_index_iter_next(&iter, LZMA_INDEX_ITER_NONEMPTY_BLOCK)) {
+            blocks.push_back({start + iter.block.compressed_stream_offset,
+                              iter.block.uncompressed_stream_offset,
+                              check});
+        }
+        streams.emplace_front(move(blocks), lzma_index_uncompressed_size(index));
+    });
+
+    seekpoints_t seekpoints;
+    if(!ok)
+        return seekpoints;
+
+    uint64_t uncompressed = 0;
+    for(auto& stream : streams) {
+        for(auto& block : stream.first) {
+            block.Uncompressed += uncompressed;
+            seekpoints.push_back(block);
+        }
+        uncompressed += stream.second;
+    }
+    return seekpoints;
+}
+
+streamsize RawFileReader::XZ::seek(streamsize offset, const seekpoints_t& seekpoints)
+{
+    // find the last block starting before offset
+    auto it_block = upper_bound(seekpoints.begin(), seekpoints.end(), offset,
+                                [] (streamsize offset, const SeekPoint_t& p) {
+        return offset < streamsize(p.Uncompressed);
+    });
+
+    if(it_block == seekpoints.begin()) {
+        reset();
+        return 0;
+    }
+    --it_block;
+
+    // continue block-wise from there
+    gcount_ = 0;
+    gcount_compressed_ = 0;
+    eof_ = false;
+    blocks = seekpoints;
+    current_block = distance(seekpoints.begin(), it_block);
+    PlainBase::reset(it_block->Compressed);
+    init_block_decoder();
+    return it_block->Uncompressed;
+}
+
+void RawFileReader::XZ::init_block_decoder()
+{
+    // the first byte of the block header encodes its size
+    uint8_t header[LZMA_BLOCK_HEADER_SIZE_MAX];
+    PlainBase::read(reinterpret_cast<char*>(header), 1);
+    if(PlainBase::gcount() != 1 || header[0] == 0x00)
+        throw Exception("No xz block header found at seekpoint");
+
+    lzma_filter filters[LZMA_FILTERS_MAX + 1];
+    lzma_block block{};
+    block.version = 0;
+    block.check = static_cast<lzma_check>(blocks[current_block].Check);
+    block.filters = filters;
+    block.header_size = lzma_block_header_size_decode(header[0]);
+
+    PlainBase::read(reinterpret_cast<char*>(header+1), block.header_size-1);
+    if(PlainBase::gcount() != block.header_size-1 ||
+       lzma_block_header_decode(addressof(block), nullptr, header) != LZMA_OK)
+        throw Exception("Corrupt xz block header found at seekpoint");
+
+    strm->next_in = nullptr;
+    strm->avail_in = 0;
+    const lzma_ret ret = lzma_block_decoder(strm.get(), addressof(block));
+
+    // the decoder has copied the filter options
+    for(size_t i=0; filters[i].id != LZMA_VLI_UNKNOWN; ++i)
+        free(filters[i].options);
+
+    if(ret != LZMA_OK)
+        throw Exception("Cannot initialize xz block decoder");
+}
+
+bool RawFileReader::XZ::next_block()
+{
+    if(current_block+1 >= blocks.size())
+        return false;
+    ++current_block;
+    PlainBase::reset(blocks[current_block].Compressed);
+    init_block_decoder();
+    return true;
+}
+
 void RawFileReader::XZ::read(char* s, streamsize n) {
 
     lzma_action action = PlainBase::eof() ? LZMA_FINISH : LZMA_RUN;
@@ -168,6 +382,16 @@ void RawFileReader::XZ::read(char* s, streamsize n) {
 
         lzma_ret ret = lzma_code(strm.get(), action);
 
+        // when decoding block-wise, continue with the next block
+        if(ret == LZMA_STREAM_END && !blocks.empty() && next_block()) {
+            action = LZMA_RUN;
+            if(strm->avail_out == 0) {
+                gcount_ = n;
+                return;
+            }
+            continue;
+        }
+
         if(ret == LZMA_STREAM_END) {
             gcount_ = n - strm->avail_out; // number of decompressed bytes
             if(strm->avail_out > 0)
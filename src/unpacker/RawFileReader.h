@@ -49,6 +49,7 @@ public:
     void read(char* s, std::streamsize n) {
         p->read(s,n);
         // track how much has been read in total so far
+        position += gcount();
         totalBytesRead += gcount();
         totalBytesRead_compressed += p->gcount_compressed();
     }
@@ -94,6 +95,64 @@ public:
      */
     void reset() {
         p->reset();
+        position = 0;
+    }
+
+    /**
+     * @brief tell the current position in the (uncompressed) byte stream
+     * @return number of bytes read since open or last reset
+     */
+    std::streamsize tell() const {
+        return position;
+    }
+
+    /**
+     * @brief GetUncompressedSize returns the total size of the uncompressed byte stream
+     * @return size in bytes
+     *
+     * For compressed files without size information, this decompresses the whole file once.
+     */
+    std::streamsize GetUncompressedSize() const;
+
+    /**
+     * @brief The SeekPoint_t struct marks a position in a compressed file,
+     * where decompression can start without reading everything before
+     */
+    struct SeekPoint_t {
+        std::uint64_t Compressed;   // byte offset in the file, such as the start of an xz block
+        std::uint64_t Uncompressed; // corresponding offset in the decompressed byte stream
+        std::uint32_t Check;        // integrity check type of the xz stream containing the block
+
+        template<class Archive>
+        void serialize(Archive& archive) {
+            archive(Compressed, Uncompressed, Check);
+        }
+    };
+    using seekpoints_t = std::vector<SeekPoint_t>;
+
+    /**
+     * @brief GetSeekPoints lists the positions in the file where reading can start
+     * @return empty if the file is not compressed or the compression format cannot provide them
+     *
+     * The seekpoints of xz files are the blocks as stored in the stream indices,
+     * note that single-threaded xz creates only one block per file
+     */
+    seekpoints_t GetSeekPoints() const {
+        return p->seekpoints();
+    }
+
+    /**
+     * @brief seek to the given position in the uncompressed byte stream
+     * @param offset in bytes from the beginning of the (uncompressed) file
+     * @param seekpoints as obtained from GetSeekPoints, for example stored in some index file
+     *
+     * Compressed files are decompressed from the closest seekpoint before offset,
+     * or from the beginning if there is none
+     */
+    void seek(std::streamsize offset, const seekpoints_t& seekpoints = {});
+
+    const std::string& GetFilename() const {
+        return filename;
     }
 
     class Exception : public std::runtime_error {
@@ -113,8 +172,9 @@ private:
      */
     class PlainBase {
     public:
-        explicit PlainBase(const std::string& filename)
-            : file(filename.c_str(), std::ios::binary),
+        explicit PlainBase(const std::string& filename_)
+            : filename(filename_),
+              file(filename.c_str(), std::ios::binary),
               gcount_total(0)
         {
             const std::streampos begin = file.tellg();
@@ -168,8 +228,27 @@ private:
             return filesize;
         }
 
+        // negative if unknown without decompressing everything
+        virtual std::streamsize filesize_uncompressed() const {
+            return filesize;
+        }
+
         virtual std::streamsize pos() const { return gcount_total; }
 
+        virtual seekpoints_t seekpoints() const {
+            return {};
+        }
+
+        // seek as close as possible to the given offset,
+        // returns the reached offset in the (uncompressed) byte stream
+        virtual std::streamsize seek(std::streamsize offset, const seekpoints_t&) {
+            reset(offset);
+            return offset;
+        }
+
+    protected:
+        const std::string filename;
+
     private:
         std::ifstream file;
         std::streamsize filesize;
@@ -203,6 +282,7 @@ private:
             gcount_ = 0;
             gcount_compressed_ = 0;
             eof_ = false;
+            blocks.clear();
             init_decoder();
         }
 
@@ -218,6 +298,14 @@ private:
             return eof_;
         }
 
+        // xz files store the uncompressed size in their stream index
+        virtual std::streamsize filesize_uncompressed() const override;
+
+        // ...as well as the positions of their blocks
+        virtual seekpoints_t seekpoints() const override;
+
+        virtual std::streamsize seek(std::streamsize offset, const seekpoints_t& seekpoints) override;
+
     private:
         std::vector<uint8_t> inbuf;
         bool decompressFailed;
@@ -232,6 +320,12 @@ private:
         deleted_unique_ptr<lzma_stream> strm;
         void init_decoder();
 
+        // after seeking, the file is decoded block by block
+        seekpoints_t blocks;
+        size_t current_block = 0;
+        void init_block_decoder();
+        bool next_block();
+
     }; // class RawFileReader::XZ
 
 
@@ -270,6 +364,19 @@ private:
             return eof_;
         }
 
+        // the gzip trailer only stores the size modulo 2^32,
+        // which is not reliable for our large files
+        virtual std::streamsize filesize_uncompressed() const override {
+            return -1;
+        }
+
+        // gzip does not provide any seekpoints,
+        // so decompress from the beginning
+        virtual std::streamsize seek(std::streamsize, const seekpoints_t&) override {
+            reset();
+            return 0;
+        }
+
     private:
         std::vector<uint8_t> inbuf;
         bool decompressFailed;
@@ -289,6 +396,8 @@ private:
 
     // private stuff for RawFileReader
     std::unique_ptr<PlainBase> p;
+    std::string filename;
+    std::streamsize position = 0;
 
     using progress_t = std::unique_ptr<ProgressCounter>;
 
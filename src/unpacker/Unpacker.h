@@ -28,6 +28,7 @@
 namespace ant {
 
 struct TEvent;
+struct Shard;
 
 /**
  * @brief The Unpacker class encapsulates the interface for unpacking raw data
@@ -48,6 +49,16 @@ public:
         virtual TEvent NextEvent() = 0;
         virtual double PercentDone() const = 0;
         virtual bool   ProvidesSlowControl() const = 0;
+
+        /**
+         * @brief SetShard restricts the module to the given part of its input
+         * @param shard the part to be unpacked
+         * @return false if the module does not support sharding
+         *
+         * Events outside the shard may still be emitted to complete slowcontrol information,
+         * they are flagged by TEvent::ShardOverlap accordingly.
+         */
+        virtual bool   SetShard(const Shard&) { return false; }
     protected:
         friend class Unpacker;
         virtual bool OpenFile(const std::string& filename) = 0;
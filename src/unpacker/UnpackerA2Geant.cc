@@ -117,6 +117,7 @@ bool UnpackerA2Geant::OpenFile(const string& filename)
     if(geantTree.Tree->GetEntries() >= numeric_limits<std::uint32_t>::max()) {
         throw Exception("Tree file contains too many entries for building proper unique ID");
     }
+    stop_entry = geantTree.Tree->GetEntries();
 
     // heuristically detect some older format, flag is used in unpacking
     {
@@ -181,7 +182,7 @@ TEvent UnpackerA2Geant::NextEvent()
     // shortcut, as geantTree is used very often here
     auto& t = geantTree;
 
-    if(current_entry>=t.Tree->GetEntriesFast()-1)
+    if(current_entry>=stop_entry-1)
         return {};
 
     t.Tree->GetEntry(++current_entry);
@@ -328,7 +329,21 @@ TEvent UnpackerA2Geant::NextEvent()
 
 double UnpackerA2Geant::PercentDone() const
 {
-    return double(current_entry) / double(geantTree.Tree->GetEntries());
+    return double(current_entry-first_entry) / double(stop_entry-first_entry);
+}
+
+bool UnpackerA2Geant::SetShard(const Shard& shard)
+{
+    // MC does not have slowcontrol, so no overlap needed
+    const auto range = shard.GetRange(geantTree.Tree->GetEntries());
+    first_entry = range.Start();
+    stop_entry  = range.Stop();
+    current_entry = first_entry-1;
+    // keep the ad-hoc IDs in sync with the unsharded run
+    if(!tidTree)
+        tidTree.tid().Lower += first_entry;
+    LOG(INFO) << "Unpacking shard " << shard << " with entries " << first_entry << " to " << stop_entry;
+    return true;
 }
 
 
@@ -37,6 +37,7 @@ public:
     virtual bool OpenFile(const std::string& filename) override;
     virtual TEvent NextEvent() override;
     virtual bool ProvidesSlowControl() const override { return false; }
+    virtual bool SetShard(const Shard& shard) override;
 
     class Exception : public Unpacker::Exception {
         using Unpacker::Exception::Exception; // use base class constructor
@@ -57,6 +58,8 @@ private:
     std::unique_ptr<unpacker::geant::promptrandom_t> promptrandom;
 
     long long current_entry = -1;
+    long long first_entry = 0;
+    long long stop_entry = 0;
 
     struct TIDTree_t : WrapTTree {
         ADD_BRANCH_T(TID, tid)
@@ -9,6 +9,14 @@
 using namespace std;
 using namespace ant;
 
+bool UnpackerAcqu::ScalersOnly::Enabled = false;
+Detector_t::Any_t UnpackerAcqu::ScalersOnly::KeepHits =
+        Detector_t::Type_t::Tagger | Detector_t::Type_t::TaggerMicro | Detector_t::Type_t::EPT |
+        Detector_t::Type_t::Trigger; // reference timings of the tagger TDCs
+unsigned UnpackerAcqu::Parallel::Threads = 0;
+unsigned UnpackerAcqu::Parallel::BuffersPerThread = 16;
+unsigned UnpackerAcqu::MaxLeadIn = 50000; // usually, there are several scaler blocks within that many events
+
 UnpackerAcqu::UnpackerAcqu() {}
 UnpackerAcqu::~UnpackerAcqu() {}
 
@@ -30,6 +38,20 @@ bool UnpackerAcqu::OpenFile(const std::string &filename)
     return true;
 }
 
+bool UnpackerAcqu::SetShard(const Shard& shard)
+{
+    file->SetShard(shard);
+    return true;
+}
+
+bool UnpackerAcqu::SeekTo(const TID& tid)
+{
+    if(!file->SeekTo(tid))
+        return false;
+    queue.clear();
+    return true;
+}
+
 TEvent UnpackerAcqu::NextEvent()
 {
     // check if we need to replenish the queue
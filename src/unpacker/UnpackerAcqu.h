@@ -23,6 +23,46 @@ public:
     virtual bool OpenFile(const std::string& filename) override;
     virtual TEvent NextEvent() override;
     virtual bool ProvidesSlowControl() const override { return true; }
+    virtual bool SetShard(const Shard& shard) override;
+
+    /**
+     * @brief SeekTo continues unpacking at the data buffer containing the given event
+     * @param tid the event to seek to, earlier events of the same data buffer are unpacked as well
+     * @return false if no index for the file is available, or tid was not found in it
+     */
+    bool SeekTo(const TID& tid);
+
+    /**
+     * @brief The ScalersOnly struct enables a fast path for scaler analyses, such as tagging efficiencies or livetimes
+     *
+     * Scaler and EPICS blocks are unpacked as usual, but hits are only decoded for the detectors in KeepHits,
+     * by default the taggers for their TDC counts, and the trigger with the reference timings the tagger
+     * times are calculated with. All events are still emitted, as physics classes
+     * count the events between scaler reads. Must be set before opening the file.
+     */
+    struct ScalersOnly {
+        static bool Enabled;
+        static Detector_t::Any_t KeepHits;
+    };
+
+    /**
+     * @brief The Parallel struct enables unpacking the data buffers of Acqu files with worker threads
+     *
+     * The reading thread only reads batches of Threads*BuffersPerThread data buffers, which are then
+     * unpacked by Threads workers. The events are emitted in the same order, with the same IDs and
+     * unpacker messages as when unpacked on the reading thread (Threads=0, the default).
+     * Must be set before opening the file.
+     */
+    struct Parallel {
+        static unsigned Threads;
+        static unsigned BuffersPerThread;
+    };
+
+    /**
+     * @brief MaxLeadIn limits the events emitted before the shard start, see SetShard,
+     * if no slowcontrol information is found within them
+     */
+    static unsigned MaxLeadIn;
 
     class Exception : public Unpacker::Exception {
         using Unpacker::Exception::Exception; // use base class constructor
@@ -10,6 +10,7 @@
 #include "tree/TEventData.h"
 
 #include "base/Logger.h"
+#include "base/std_ext/memory.h"
 
 #include <numeric>
 
@@ -155,6 +156,14 @@ void acqu::FileFormatMk1::FillFirstDataBuffer(reader_t& reader, buffer_t& buffer
     throw UnpackerAcqu::Exception("Did not find first data buffer with Mk1 signature");
 }
 
+unique_ptr<acqu::FileFormatBase> acqu::FileFormatMk1::MakeDecoder() const
+{
+    auto decoder = std_ext::make_unique<FileFormatMk1>();
+    InitDecoder(*decoder);
+    decoder->ScalerBlockSizes = ScalerBlockSizes;
+    return unique_ptr<FileFormatBase>(move(decoder));
+}
+
 void acqu::FileFormatMk1::UnpackEvent(TEventData& eventdata, it_t& it, const it_t& it_endbuffer, bool& good) noexcept
 {
     assert(std::distance(it, it_endbuffer)>0);
@@ -190,7 +199,8 @@ void acqu::FileFormatMk1::UnpackEvent(TEventData& eventdata, it_t& it, const it_
             auto acqu_hit = reinterpret_cast<const acqu::AcquBlock_t*>(addressof(*it));
             // during a buffer, hits can come in any order,
             // and multiple hits with the same ID can happen
-            hit_storage.add_item(acqu_hit->id, acqu_hit->adc);
+            if(IsMappedRawChannel(acqu_hit->id))
+                hit_storage.add_item(acqu_hit->id, acqu_hit->adc);
             // decoding hits always works
             good = true;
             it++;
@@ -10,6 +10,7 @@
 #include "RawFileReader.h"
 
 #include "base/Logger.h"
+#include "base/std_ext/memory.h"
 
 using namespace std;
 using namespace ant;
@@ -131,6 +132,13 @@ void acqu::FileFormatMk2::FillFirstDataBuffer(reader_t& reader, buffer_t& buffer
 
 
 
+unique_ptr<acqu::FileFormatBase> acqu::FileFormatMk2::MakeDecoder() const
+{
+    auto decoder = std_ext::make_unique<FileFormatMk2>();
+    InitDecoder(*decoder);
+    return unique_ptr<FileFormatBase>(move(decoder));
+}
+
 void acqu::FileFormatMk2::UnpackEvent(
         TEventData& eventdata,
         it_t& it, const it_t& it_endbuffer,
@@ -202,7 +210,8 @@ void acqu::FileFormatMk2::UnpackEvent(
             auto acqu_hit = reinterpret_cast<const acqu::AcquBlock_t*>(addressof(*it));
             // during a buffer, hits can come in any order,
             // and multiple hits with the same ID can happen
-            hit_storage.add_item(acqu_hit->id, acqu_hit->adc);
+            if(IsMappedRawChannel(acqu_hit->id))
+                hit_storage.add_item(acqu_hit->id, acqu_hit->adc);
             // decoding hits always works
             good = true;
             it++;
@@ -23,6 +23,7 @@ protected:
     virtual void FillFirstDataBuffer(reader_t& reader, buffer_t& buffer) const override;
 
     virtual void UnpackEvent(TEventData& eventdata, it_t& it, const it_t& it_endbuffer, bool& good) noexcept override;
+    virtual std::unique_ptr<FileFormatBase> MakeDecoder() const override;
     void HandleScalerBuffer(scalers_t& scalers,
                             it_t& it, const it_t& it_end, bool& good,
                             std::vector<TDAQError>& errors) const noexcept;
@@ -21,6 +21,7 @@
 #include <ctime>
 #include <iterator> // for std::next
 #include <cstdlib>
+#include <future>
 
 using namespace std;
 using namespace ant;
@@ -119,9 +120,25 @@ void acqu::FileFormatBase::Setup(reader_t &&reader_, buffer_t &&buffer_) {
     // remember the record length size
     trueRecordLength = buffer.size();
 
+    if(!buffer.empty())
+        LoadIndex();
+
     // get the mappings once
     setup.BuildMappings(hit_mappings, scaler_mappings);
 
+    // in scaler mode, forget about the hits of all other detectors
+    scalersOnly = UnpackerAcqu::ScalersOnly::Enabled;
+    if(scalersOnly) {
+        const auto& keepHits = UnpackerAcqu::ScalersOnly::KeepHits;
+        hit_mappings.erase(remove_if(hit_mappings.begin(), hit_mappings.end(),
+                                     [&keepHits] (const UnpackerAcquConfig::hit_mapping_t& m) {
+            return !keepHits.test(m.LogicalChannel.DetectorType);
+        }), hit_mappings.end());
+        LogMessage(TUnpackerMessage::Level_t::Info,
+                   std_ext::formatter()
+                   << "Unpacking scalers only, keeping hits of " << keepHits);
+    }
+
     // and prepare the member variables for fast unpacking of hits
     for(const UnpackerAcquConfig::hit_mapping_t& hit_mapping : hit_mappings) {
         for(const UnpackerAcquConfig::RawChannel_t<uint16_t>& rawChannel : hit_mapping.RawChannels) {
@@ -132,6 +149,23 @@ void acqu::FileFormatBase::Setup(reader_t &&reader_, buffer_t &&buffer_) {
         }
     }
 
+    // the decoders for parallel unpacking refer to the mappings above
+    for(unsigned i=0;i<UnpackerAcqu::Parallel::Threads;i++)
+        decoders.emplace_back(MakeDecoder());
+    if(!decoders.empty()) {
+        LogMessage(TUnpackerMessage::Level_t::Info,
+                   std_ext::formatter()
+                   << "Unpacking data buffers with " << decoders.size() << " threads");
+    }
+}
+
+void acqu::FileFormatBase::InitDecoder(FileFormatBase& decoder) const
+{
+    decoder.info = info;
+    decoder.id = id;
+    decoder.hit_mappings_ptr = hit_mappings_ptr;
+    decoder.scalersOnly = scalersOnly;
+    decoder.scaler_mappings = scaler_mappings;
 }
 
 acqu::FileFormatBase::~FileFormatBase()
@@ -141,7 +175,107 @@ acqu::FileFormatBase::~FileFormatBase()
 
 double acqu::FileFormatBase::PercentDone() const
 {
-    return reader->PercentDone();
+    if(shardBuffers.Stop() == std::numeric_limits<long long>::max()) {
+        if(indexLoaded && !index.Buffers.empty())
+            return std::min(double(nUnpackedBuffers)/index.Buffers.size(), 1.0);
+        return reader->PercentDone();
+    }
+    if(shardBuffers.Length() == 0)
+        return 1.0;
+    const double percent = double(nUnpackedBuffers - shardBuffers.Start())/shardBuffers.Length();
+    return std::min(std::max(percent, 0.0), 1.0);
+}
+
+void acqu::FileFormatBase::SetShard(const Shard& shard)
+{
+    // all data buffers have the same record length, so their number follows
+    // from the uncompressed file size (note that the first buffer has already been read)
+    long long nBuffers = 0;
+    if(indexLoaded) {
+        nBuffers = index.Buffers.size();
+    }
+    else if(!buffer.empty()) {
+        const long long recordBytes = sizeof(uint32_t)*trueRecordLength;
+        const long long firstBufferOffset = reader->tell() - recordBytes;
+        nBuffers = (reader->GetUncompressedSize() - firstBufferOffset)/recordBytes;
+    }
+    shardBuffers = shard.GetRange(nBuffers);
+    LOG(INFO) << "Unpacking shard " << shard << " with data buffers "
+              << shardBuffers.Start() << " to " << shardBuffers.Stop()
+              << " of " << nBuffers;
+
+    // the index tells us where to start, that is the last buffer
+    // before the shard with slowcontrol information for the lead-in
+    if(indexLoaded && shardBuffers.Start() > nUnpackedBuffers) {
+        long long start = shardBuffers.Start();
+        for(long long n = start-1; n >= nUnpackedBuffers; --n) {
+            if(index.Buffers[n].HasSlowControl) {
+                start = n;
+                break;
+            }
+        }
+        SeekToBuffer(start);
+    }
+}
+
+bool acqu::FileFormatBase::SeekTo(const TID& tid)
+{
+    if(!indexLoaded || tid.Timestamp != id.Timestamp)
+        return false;
+    const auto n = index.FindBuffer(tid.Lower);
+    if(n < 0)
+        return false;
+    SeekToBuffer(n);
+    return true;
+}
+
+void acqu::FileFormatBase::LoadIndex()
+{
+    const auto& filename = reader->GetFilename();
+    const long long firstBufferOffset = reader->tell() - sizeof(uint32_t)*trueRecordLength;
+    indexLoaded = index.Load(filename);
+    if(indexLoaded && (index.RecordLength != unsigned(trueRecordLength) ||
+                       index.Buffers.empty() ||
+                       index.Buffers.front().Offset != uint64_t(firstBufferOffset))) {
+        LOG(WARNING) << "Ignoring index of " << filename << ", which does not match the file's data buffers";
+        indexLoaded = false;
+    }
+
+    if(indexLoaded)
+        return;
+
+    // prepare building it while reading
+    index = Index();
+    index.RecordLength = trueRecordLength;
+    index.SeekPoints = reader->GetSeekPoints();
+    indexBuilding = Index::CreateOnFirstPass;
+}
+
+void acqu::FileFormatBase::SeekToBuffer(long long n)
+{
+    // the index is only complete if built from the beginning
+    indexBuilding = false;
+
+    if(n == nUnpackedBuffers && !buffer.empty())
+        return;
+
+    const Index::Buffer_t& b = index.Buffers.at(n);
+    VLOG(5) << "Seeking to data buffer " << n << " at offset " << b.Offset;
+    try {
+        reader->seek(b.Offset, index.SeekPoints);
+    }
+    catch(RawFileReader::Exception& e) {
+        LogMessage(TUnpackerMessage::Level_t::DataError,
+                   std_ext::formatter()
+                   << "Error while seeking in input: " << e.what());
+        buffer.clear();
+        return;
+    }
+    buffer.resize(trueRecordLength);
+    nUnpackedBuffers = n;
+    id.Lower = b.FirstEvent;
+    AcquID_last = b.AcquIDLast;
+    RefillBuffer();
 }
 
 time_t acqu::FileFormatBase::GetTimeStamp()
@@ -262,11 +396,47 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
         return;
     }
 
+    // buffers before the shard are unpacked anyway (without hits) to keep the event IDs consistent,
+    // but only the events since the last slowcontrol information are emitted
+    if(nUnpackedBuffers < shardBuffers.Start()) {
+        while(!buffer.empty() && nUnpackedBuffers < shardBuffers.Start())
+            SkipDataBuffer();
+        for(TEvent& event : leadin)
+            event.ShardOverlap = Shard::Overlap_t::LeadIn;
+        queue.splice(queue.end(), move(leadin));
+        if(buffer.empty())
+            return;
+    }
+
+    if(!decoders.empty()) {
+        FillEventsParallel(queue);
+        return;
+    }
+
+    const auto overlap = nUnpackedBuffers < shardBuffers.Stop() ?
+                             Shard::Overlap_t::None : Shard::Overlap_t::LeadOut;
+
     // start parsing the filled buffer
     // however, we fill a temporary queue first
-    auto it = buffer.cbegin();
     queue_t queue_buffer;
-    if(!UnpackDataBuffer(queue_buffer, it, buffer.cend())) {
+    const bool good = UnpackCurrentBuffer(queue_buffer);
+    EmitBuffer(queue, queue_buffer, good, overlap);
+
+    nUnpackedBuffers++;
+
+    RefillBuffer();
+
+    // the above refill might have created messages,
+    // and to suppress empty events with messages only,
+    // we simply append them to the last event if any present
+    if(!queue.empty())
+        AppendMessagesToEvent(queue.back());
+}
+
+void acqu::FileFormatBase::EmitBuffer(queue_t& queue, queue_t& queue_buffer,
+                                      bool good, Shard::Overlap_t overlap) noexcept
+{
+    if(!good) {
         // handle errors on buffer scale
         LOG(WARNING) << "Error while unpacking buffer n=" << nUnpackedBuffers
                      << ", discarding all unpacked data from buffer.";
@@ -279,20 +449,238 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
         messages.back().Payload.push_back(nUnpackedBuffers);
 
         queue.emplace_back(id);
+        queue.back().ShardOverlap = overlap;
         AppendMessagesToEvent(queue.back());
     }
     else {
         // successful, so add all to output
+        for(TEvent& event : queue_buffer)
+            event.ShardOverlap = overlap;
+        queue.splice(queue.end(), move(queue_buffer));
+    }
+}
+
+void acqu::FileFormatBase::FillEventsParallel(queue_t& queue) noexcept
+{
+    const auto overlap = [this] (long long n) {
+        return n < shardBuffers.Stop() ? Shard::Overlap_t::None : Shard::Overlap_t::LeadOut;
+    };
+    const auto batchOverlap = overlap(nUnpackedBuffers);
+
+    // the reading thread only slices the data buffers, the end of file might be
+    // reached before all slices are merged, so the index is completed afterwards
+    const bool buildingIndex = indexBuilding;
+    indexBuilding = false;
+
+    // the messages so far belong to the first event of the first slice
+    auto pending = move(messages);
+    messages.clear();
+
+    const size_t maxSlices = decoders.size()*max(UnpackerAcqu::Parallel::BuffersPerThread, 1u);
+    if(slices.size() < maxSlices)
+        slices.resize(maxSlices);
+    size_t nSlices = 0;
+    while(nSlices < maxSlices) {
+        slice_t& slice = slices[nSlices];
+        slice.nBuffer = nUnpackedBuffers + nSlices;
+        slice.IndexEntry.Offset = reader->tell() - sizeof(uint32_t)*trueRecordLength;
+        // hand over the buffer, and read the next one into the previous storage of the slice
+        swap(slice.Buffer, buffer);
+        buffer.resize(trueRecordLength);
+        RefillBuffer();
+        slice.RefillMessages = move(messages);
+        messages.clear();
+        nSlices++;
+        // keep the lead-out buffers in batches of their own
+        if(buffer.empty() || overlap(slice.nBuffer+1) != batchOverlap)
+            break;
+    }
+
+    indexBuilding = buildingIndex;
+    messages = move(pending);
+
+    // decoder i unpacks every decoders.size()-th slice,
+    // the noexcept decoding does not need to handle exceptions
+    vector<future<void>> workers;
+    for(size_t i=0;i<decoders.size() && i<nSlices;i++) {
+        workers.emplace_back(async(launch::async, [this, i, nSlices] (const TID firstID) {
+            for(size_t k=i;k<nSlices;k+=decoders.size())
+                decoders[i]->DecodeSlice(slices[k], firstID);
+        }, id));
+    }
+    for(auto& w : workers)
+        w.wait();
+
+    for(size_t k=0;k<nSlices;k++)
+        MergeSlice(queue, slices[k], batchOverlap);
+
+    if(buffer.empty() && reader->gcount() == 0 && reader->eof())
+        CompleteIndex();
+}
+
+void acqu::FileFormatBase::DecodeSlice(slice_t& slice, const TID& firstID) noexcept
+{
+    // unpack as if it were the very first buffer,
+    // MergeSlice then continues the IDs and checks the first AcquID
+    id = firstID;
+    id.Lower = 0;
+    AcquID_last = 0;
+    nUnpackedBuffers = slice.nBuffer;
+    messages.clear();
+
+    slice.Events.clear();
+    auto it = slice.Buffer.cbegin();
+    slice.Good = UnpackDataBuffer(slice.Events, it, slice.Buffer.cend());
+    if(slice.Good) {
+        const int unpackedWords = distance(slice.Buffer.cbegin(), it);
+        VLOG(7) << "Successfully unpacked " << unpackedWords << " words ("
+                << 100.0*unpackedWords/slice.Buffer.size() << " %) from buffer ";
+    }
+
+    slice.nEvents = id.Lower;
+    slice.AcquIDLast = AcquID_last;
+    slice.Messages = move(messages);
+    messages.clear();
+}
+
+void acqu::FileFormatBase::MergeSlice(queue_t& queue, slice_t& slice, Shard::Overlap_t overlap) noexcept
+{
+    Index::Buffer_t entry = slice.IndexEntry;
+    entry.FirstEvent = id.Lower;
+    entry.AcquIDLast = AcquID_last;
+
+    // the same check as in UnpackDataBuffer, which the decoder
+    // could not do for the first event in the slice
+    nEventsInBuffer = 0;
+    if(!slice.Events.empty()) {
+        const unsigned acquID = slice.Events.front().Reconstructed().Trigger.DAQEventID;
+        if(AcquID_last>acquID) {
+            VLOG(8) << "Overflow of Acqu EventId detected from "
+                    << AcquID_last << " to " << acquID;
+        }
+        if(id.Lower>0 && acquID != AcquID_last+1) {
+            LogMessage(TUnpackerMessage::Level_t::DataError,
+                       std_ext::formatter()
+                       << "AcquID=" << acquID << " not consecutive from last AcquID=" << AcquID_last,
+                       true // emit warning
+                       );
+        }
+        AcquID_last = slice.AcquIDLast;
+    }
+
+    // the pending messages come first, either in the first completed event
+    // or in the messages left over by the decoder
+    auto& firstMessages = slice.nEvents > 0 ?
+                              slice.Events.front().Reconstructed().UnpackerMessages :
+                              slice.Messages;
+    firstMessages.insert(firstMessages.begin(),
+                         make_move_iterator(messages.begin()), make_move_iterator(messages.end()));
+    messages = move(slice.Messages);
+    slice.Messages.clear();
+
+    // continue the official unique event ID
+    auto it_event = slice.Events.begin();
+    for(unsigned i=0;i<slice.nEvents;i++) {
+        it_event->Reconstructed().ID = id;
+        ++it_event;
+        ++id;
+    }
+
+    AddToIndex(entry, slice.nBuffer, slice.Good, slice.Events);
+    EmitBuffer(queue, slice.Events, slice.Good, overlap);
+    slice.Events.clear();
+
+    nUnpackedBuffers++;
+
+    // as in FillEvents, after RefillBuffer
+    messages.insert(messages.end(), slice.RefillMessages.begin(), slice.RefillMessages.end());
+    if(!queue.empty())
+        AppendMessagesToEvent(queue.back());
+}
+
+void acqu::FileFormatBase::SkipDataBuffer() noexcept
+{
+    // events outside the shard are not reconstructed,
+    // so as in UnpackerAcqu::ScalersOnly mode, no hits are decoded
+    hit_mappings_ptr_t no_hit_mappings;
+    swap(hit_mappings_ptr, no_hit_mappings);
+    const bool wasScalersOnly = scalersOnly;
+    scalersOnly = true;
+
+    // errors while unpacking are reported by the shard the buffer belongs to
+    queue_t queue_buffer;
+    const bool good = UnpackCurrentBuffer(queue_buffer);
+
+    swap(hit_mappings_ptr, no_hit_mappings);
+    scalersOnly = wasScalersOnly;
+
+    if(good) {
+        auto it_sc = find_if(queue_buffer.rbegin(), queue_buffer.rend(), [] (const TEvent& event) {
+            return !event.Reconstructed().SlowControls.empty();
+        });
+        if(it_sc != queue_buffer.rend()) {
+            leadin.clear();
+            queue_buffer.erase(queue_buffer.begin(), prev(it_sc.base()));
+        }
+        leadin.splice(leadin.end(), move(queue_buffer));
+
+        const size_t maxLeadIn = UnpackerAcqu::MaxLeadIn;
+        if(leadin.size() > maxLeadIn) {
+            LOG_N_TIMES(1, WARNING) << "No slowcontrol information found within " << maxLeadIn
+                                    << " events before shard start";
+            leadin.erase(leadin.begin(), next(leadin.begin(), leadin.size() - maxLeadIn));
+        }
+    }
+    messages.clear();
+
+    nUnpackedBuffers++;
+
+    RefillBuffer();
+    messages.clear();
+}
+
+bool acqu::FileFormatBase::UnpackCurrentBuffer(queue_t& queue) noexcept
+{
+    Index::Buffer_t entry;
+    entry.Offset = reader->tell() - sizeof(uint32_t)*trueRecordLength;
+    entry.FirstEvent = id.Lower;
+    entry.AcquIDLast = AcquID_last;
+
+    auto it = buffer.cbegin();
+    const bool good = UnpackDataBuffer(queue, it, buffer.cend());
+    if(good) {
         const int unpackedWords = distance(buffer.cbegin(), it);
         VLOG(7) << "Successfully unpacked " << unpackedWords << " words ("
                 << 100.0*unpackedWords/buffer.size() << " %) from buffer ";
-        queue.splice(queue.end(), move(queue_buffer));
     }
 
-    nUnpackedBuffers++;
+    AddToIndex(entry, nUnpackedBuffers, good, queue);
 
+    return good;
+}
 
-    // refill the buffer
+void acqu::FileFormatBase::AddToIndex(Index::Buffer_t entry, unsigned nBuffer,
+                                      bool good, const queue_t& queue) noexcept
+{
+    if(!indexBuilding || index.Buffers.size() != nBuffer)
+        return;
+    // the event counter advances even for discarded buffers
+    entry.nEvents = id.Lower - entry.FirstEvent;
+    entry.HasSlowControl = good && any_of(queue.begin(), queue.end(), [] (const TEvent& event) {
+        return !event.Reconstructed().SlowControls.empty();
+    });
+    index.Buffers.push_back(entry);
+}
+
+void acqu::FileFormatBase::CompleteIndex() noexcept
+{
+    if(indexBuilding && !index.Save(reader->GetFilename()))
+        VLOG(3) << "Could not save index for " << reader->GetFilename();
+    indexBuilding = false;
+}
+
+void acqu::FileFormatBase::RefillBuffer() noexcept
+{
     try {
         reader->read(buffer.data(), trueRecordLength);
     }
@@ -311,6 +699,8 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
             LogMessage(TUnpackerMessage::Level_t::Info,
                        std_ext::formatter()
                        << "Found proper end of file");
+            // now the index is complete
+            CompleteIndex();
         }
         else {
             LogMessage(TUnpackerMessage::Level_t::DataError,
@@ -320,12 +710,6 @@ void acqu::FileFormatBase::FillEvents(queue_t& queue) noexcept
         }
         buffer.clear();
     }
-
-    // the above refill might have created messages,
-    // and to suppress empty events with messages only,
-    // we simply append them to the last event if any present
-    if(!queue.empty())
-        AppendMessagesToEvent(queue.back());
 }
 
 uint32_t acqu::FileFormatBase::GetDataBufferMarker() const
@@ -586,7 +970,7 @@ bool acqu::FileFormatBase::UnpackDataBuffer(UnpackerAcquFileFormat::queue_t& que
                 return false;
         }
 
-        if(eventdata.DetectorReadHits.empty()) {
+        if(eventdata.DetectorReadHits.empty() && !scalersOnly) {
             LogMessage(TUnpackerMessage::Level_t::Info,
                        "Unpacked event with completely empty DetectorReadHits",
                        true // emit warning
@@ -2,8 +2,11 @@
 
 #include "tree/TUnpackerMessage.h"
 #include "UnpackerAcqu.h" // UnpackerAcquConfig
+#include "UnpackerAcqu_index.h"
 
 #include "base/std_ext/mapped_vectors.h"
+#include "base/Shard.h"
+#include "base/interval.h"
 
 #include <cstdint>
 #include <ctime>
@@ -48,6 +51,24 @@ public:
 
     virtual double PercentDone() const =0;
 
+    /**
+      * @brief SetShard restricts FillEvents to the data buffers belonging to the shard
+      * @param shard
+      *
+      * Events before the shard needed for slowcontrol are emitted flagged as lead-in,
+      * all events after the shard are emitted flagged as lead-out.
+      * Without an index, all data buffers before the shard are read,
+      * but their hits are not decoded.
+      */
+    virtual void SetShard(const Shard& shard) = 0;
+
+    /**
+      * @brief SeekTo continues FillEvents at the data buffer containing the given event
+      * @param tid
+      * @return false if the file has no index, or tid was not found
+      */
+    virtual bool SeekTo(const TID& tid) = 0;
+
 protected:
     virtual size_t SizeOfHeader() const = 0;
     virtual bool InspectHeader(const std::vector<uint32_t>& buffer) const = 0;
@@ -67,6 +88,10 @@ public:
 
     virtual double PercentDone() const override;
 
+    virtual void SetShard(const Shard& shard) override;
+
+    virtual bool SeekTo(const TID& tid) override;
+
 private:
     std::unique_ptr<RawFileReader> reader;
     std::vector<std::uint32_t>     buffer;
@@ -78,6 +103,49 @@ private:
     unsigned nUnpackedBuffers;
     unsigned nEventsInBuffer;
     time_t GetTimeStamp();
+
+    // the data buffers belonging to the current shard,
+    // and the events needed for slowcontrol at the shard start
+    interval<long long> shardBuffers{0, std::numeric_limits<long long>::max()};
+    std::list<TEvent> leadin;
+
+    void RefillBuffer() noexcept;
+    void SkipDataBuffer() noexcept;
+
+    // the index is either loaded, or built while reading
+    // the file from the beginning (if enabled)
+    Index index;
+    bool indexLoaded = false;
+    bool indexBuilding = false;
+
+    void LoadIndex();
+    void SeekToBuffer(long long n);
+    void CompleteIndex() noexcept;
+    void AddToIndex(Index::Buffer_t entry, unsigned nBuffer, bool good, const queue_t& queue) noexcept;
+    bool UnpackCurrentBuffer(queue_t& queue) noexcept;
+    void EmitBuffer(queue_t& queue, queue_t& queue_buffer, bool good, Shard::Overlap_t overlap) noexcept;
+
+    // parallel unpacking, see UnpackerAcqu::Parallel
+    // the reading thread slices data buffers, which are unpacked by the decoders
+    // and merged in order, as the event IDs depend on all previous buffers
+    struct slice_t {
+        std::vector<std::uint32_t> Buffer;
+        unsigned nBuffer = 0;
+        Index::Buffer_t IndexEntry; // only Offset is known when slicing
+        std::vector<TUnpackerMessage> RefillMessages;
+
+        // filled by the decoder
+        queue_t Events;
+        bool Good = false;
+        unsigned nEvents = 0; // completed events, even if not Good
+        unsigned AcquIDLast = 0;
+        std::vector<TUnpackerMessage> Messages; // not appended to any event
+    };
+    std::vector<std::unique_ptr<FileFormatBase>> decoders;
+    std::vector<slice_t> slices; // reused for the buffer storage
+    void FillEventsParallel(queue_t& queue) noexcept;
+    void DecodeSlice(slice_t& slice, const TID& firstID) noexcept;
+    void MergeSlice(queue_t& queue, slice_t& slice, Shard::Overlap_t overlap) noexcept;
 protected:
 
     using reader_t = decltype(reader);
@@ -123,6 +191,12 @@ protected:
     std::vector<UnpackerAcquConfig::hit_mapping_t> hit_mappings;
     using hit_mappings_ptr_t = std::vector< std::vector< const UnpackerAcquConfig::hit_mapping_t* > >;
     hit_mappings_ptr_t hit_mappings_ptr;
+    // hits of unmapped raw channels are skipped early,
+    // in particular all hits not kept in UnpackerAcqu::ScalersOnly mode
+    bool IsMappedRawChannel(std::uint16_t ch) const noexcept {
+        return ch < hit_mappings_ptr.size() && !hit_mappings_ptr[ch].empty();
+    }
+    bool scalersOnly = false;
     using hit_storage_t = std_ext::mapped_vectors<std::uint16_t, std::uint16_t>;
     hit_storage_t hit_storage;
 
@@ -143,6 +217,9 @@ protected:
     virtual void FillInfo(reader_t& reader, buffer_t& buffer, Info& info) = 0;
     virtual void FillFirstDataBuffer(reader_t& reader, buffer_t& buffer) const = 0;
     virtual void UnpackEvent(TEventData& eventdata, it_t& it, const it_t& it_endbuffer, bool& good) noexcept = 0;
+    // a decoder only needs to unpack data buffers, see InitDecoder
+    virtual std::unique_ptr<FileFormatBase> MakeDecoder() const = 0;
+    void InitDecoder(FileFormatBase& decoder) const;
 
     // things shared by Mk1/Mk2
     bool UnpackDataBuffer(queue_t& queue, it_t& it, const it_t& it_endbuffer) noexcept;
@@ -0,0 +1,128 @@
+#include "UnpackerAcqu_index.h"
+
+#include "base/Logger.h"
+
+#include "cereal/cereal.hpp"
+#include "cereal/types/vector.hpp"
+#include "cereal/archives/binary.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <cstdlib> // for mkstemp
+
+#include <sys/stat.h> // for fchmod
+#include <unistd.h> // for close
+
+using namespace std;
+using namespace ant;
+using namespace ant::unpacker::acqu;
+
+bool Index::CreateOnFirstPass = false;
+
+namespace {
+
+// bump the version if the layout of Index changes
+const string magic = "antidx";
+constexpr uint32_t version = 1;
+
+uint64_t get_filesize(const string& filename) {
+    ifstream file(filename, ios::binary | ios::ate);
+    return file ? uint64_t(file.tellg()) : 0;
+}
+
+} // namespace
+
+string Index::GetFilename(const string& rawfile)
+{
+    return rawfile + ".antidx";
+}
+
+bool Index::Load(const string& rawfile)
+{
+    const auto& filename = GetFilename(rawfile);
+    ifstream file(filename, ios::binary);
+    if(!file)
+        return false;
+
+    string magic_(magic.size(), '\0');
+    uint32_t version_ = 0;
+    file.read(&magic_[0], magic_.size());
+    file.read(reinterpret_cast<char*>(addressof(version_)), sizeof(version_));
+    if(!file || magic_ != magic || version_ != version) {
+        LOG(WARNING) << "Ignoring index " << filename << " with unknown format";
+        return false;
+    }
+
+    try {
+        cereal::BinaryInputArchive ar(file);
+        ar(*this);
+    }
+    catch(const cereal::Exception& e) {
+        LOG(WARNING) << "Ignoring corrupt index " << filename << ": " << e.what();
+        return false;
+    }
+
+    if(FileSize != get_filesize(rawfile)) {
+        LOG(WARNING) << "Ignoring index " << filename << ", which does not match its raw file";
+        return false;
+    }
+
+    VLOG(5) << "Loaded index " << filename << " with " << Buffers.size() << " data buffers";
+    return true;
+}
+
+bool Index::Save(const string& rawfile)
+{
+    const auto& filename = GetFilename(rawfile);
+    FileSize = get_filesize(rawfile);
+
+    // write to some temporary file first,
+    // concurrent readers should never see a partial index,
+    // and concurrent writers need their own temporary file
+    string tmpfilename = filename + ".XXXXXX";
+    {
+        const int fd = mkstemp(&tmpfilename[0]);
+        if(fd == -1)
+            return false;
+        // mkstemp only allows the owner to read the file
+        fchmod(fd, 0644);
+        close(fd);
+    }
+    {
+        ofstream file(tmpfilename, ios::binary);
+        if(!file) {
+            remove(tmpfilename.c_str());
+            return false;
+        }
+        file.write(magic.data(), magic.size());
+        file.write(reinterpret_cast<const char*>(addressof(version)), sizeof(version));
+        cereal::BinaryOutputArchive ar(file);
+        ar(*this);
+        if(!file) {
+            remove(tmpfilename.c_str());
+            return false;
+        }
+    }
+    if(rename(tmpfilename.c_str(), filename.c_str()) != 0) {
+        remove(tmpfilename.c_str());
+        return false;
+    }
+
+    LOG(INFO) << "Saved index " << filename << " with " << Buffers.size() << " data buffers";
+    return true;
+}
+
+long long Index::FindBuffer(uint32_t lower) const
+{
+    // find the last buffer starting not after lower
+    auto it = upper_bound(Buffers.begin(), Buffers.end(), lower,
+                          [] (uint32_t lower, const Buffer_t& b) { return lower < b.FirstEvent; });
+    if(it == Buffers.begin())
+        return -1;
+    --it;
+    if(lower >= it->FirstEvent + it->nEvents)
+        return -1;
+    return distance(Buffers.begin(), it);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "unpacker/RawFileReader.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ant {
+namespace unpacker {
+namespace acqu {
+
+/**
+ * @brief The Index struct describes the data buffers of an Acqu file
+ *
+ * It is stored as sidecar file next to the raw file, see GetFilename(),
+ * and allows to seek to data buffers without unpacking everything before.
+ * For compressed files, the seekpoints of the RawFileReader are stored as well.
+ */
+struct Index {
+
+    struct Buffer_t {
+        std::uint64_t Offset;      // byte offset of the buffer in the uncompressed file
+        std::uint32_t FirstEvent;  // TID::Lower of the first event in buffer
+        std::uint32_t nEvents;
+        std::uint32_t AcquIDLast;  // Acqu event ID before the buffer
+        bool HasSlowControl;       // some event in buffer carries slowcontrol items
+
+        template<class Archive>
+        void serialize(Archive& archive) {
+            archive(Offset, FirstEvent, nEvents, AcquIDLast, HasSlowControl);
+        }
+    };
+
+    std::uint64_t FileSize = 0;     // of the raw (possibly compressed) file, detects outdated indices
+    std::uint32_t RecordLength = 0; // true record length in words
+    std::vector<Buffer_t> Buffers;
+    RawFileReader::seekpoints_t SeekPoints;
+
+    static std::string GetFilename(const std::string& rawfile);
+
+    /**
+     * @brief Load the index belonging to the given raw file
+     * @param rawfile
+     * @return false if there is no index, or if it does not match the raw file
+     */
+    bool Load(const std::string& rawfile);
+
+    /**
+     * @brief Save the index next to the given raw file
+     * @param rawfile
+     * @return false if the index could not be written, for example in read-only directories
+     */
+    bool Save(const std::string& rawfile);
+
+    /**
+     * @brief FindBuffer searches for the data buffer containing the given event
+     * @param lower the event counter as in TID::Lower
+     * @return index of the buffer, or negative if not found
+     */
+    long long FindBuffer(std::uint32_t lower) const;
+
+    template<class Archive>
+    void serialize(Archive& archive) {
+        archive(FileSize, RecordLength, Buffers, SeekPoints);
+    }
+
+    /**
+     * @brief If CreateOnFirstPass, the index is saved once a raw file without index was read completely
+     */
+    static bool CreateOnFirstPass;
+};
+
+}}} // namespace ant::unpacker::acqu
@@ -0,0 +1,90 @@
+#include "UnpackerAcqu_writer.h"
+
+#include "UnpackerAcqu_legacy.h"
+#include "RawFileReader.h"
+
+#include <memory>
+
+using namespace std;
+using namespace ant;
+using namespace ant::unpacker::acqu;
+
+constexpr size_t Mk2Writer::BufferWords;
+
+Mk2Writer::Mk2Writer(const string& filename) :
+    file(filename, ios::binary)
+{
+    if(!file)
+        throw Exception("Cannot open "+filename+" for writing");
+    // ensure first databuffer has Mk2 data marker
+    databuffer.reserve(BufferWords);
+    databuffer.emplace_back(EMk2DataBuff);
+}
+
+Mk2Writer::~Mk2Writer()
+{
+    if(file.is_open())
+        Close();
+}
+
+void Mk2Writer::WriteHeader(const string& headerfile)
+{
+    std::vector<uint32_t> buffer;
+    RawFileReader r;
+    r.open(headerfile);
+    if(!r)
+        throw Exception("Cannot open headerfile "+headerfile+" for reading");
+    // header is usually contained within the first 32k bytes
+    r.expand_buffer(buffer, 0x8000/sizeof(uint32_t));
+    buffer.resize(BufferWords);
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               buffer.size()*sizeof(uint32_t));
+}
+
+uint32_t Mk2Writer::MakeHit(uint16_t rawchannel, uint16_t value)
+{
+    uint32_t word = 0;
+    auto acquhit = reinterpret_cast<AcquBlock_t*>(addressof(word));
+    acquhit->id = rawchannel;
+    acquhit->adc = value;
+    return word;
+}
+
+void Mk2Writer::AddEvent(const vector<uint32_t>& hits)
+{
+    // each event is filled into the buffer with its eventID, eventlength (in bytes),
+    // the end-of-event marker and some possible end-of-databuffer marker, in total 4 extra words maximum
+    if(databuffer.size()+hits.size()+4 > BufferWords) {
+        writeBuffer();
+        databuffer.emplace_back(EMk2DataBuff);
+    }
+
+    // the event length includes the end-of-event marker
+    databuffer.emplace_back(nEvents);
+    databuffer.emplace_back((hits.size()+1)*sizeof(uint32_t));
+    databuffer.insert(databuffer.end(), hits.begin(), hits.end());
+    databuffer.emplace_back(EEndEvent);
+
+    nEvents++;
+}
+
+void Mk2Writer::Close()
+{
+    // dump last databuffer
+    writeBuffer();
+
+    // write EEndBuffer
+    databuffer.emplace_back(EEndBuff);
+    writeBuffer();
+
+    file.close();
+}
+
+void Mk2Writer::writeBuffer()
+{
+    databuffer.emplace_back(EBufferEnd);
+    databuffer.resize(BufferWords);
+    file.write(reinterpret_cast<const char*>(databuffer.data()),
+               databuffer.size()*sizeof(uint32_t));
+    databuffer.clear();
+}
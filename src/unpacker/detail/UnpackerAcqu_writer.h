@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ant {
+namespace unpacker {
+namespace acqu {
+
+/**
+ * @brief The Mk2Writer class writes events into an Acqu Mk2 raw file
+ *
+ * The header is copied from an existing Mk2 file, the events are filled into
+ * data buffers of the usual size. Used by Ant-fakeRaw and for synthesizing
+ * large raw files in benchmarks.
+ */
+class Mk2Writer {
+public:
+    explicit Mk2Writer(const std::string& filename);
+    ~Mk2Writer();
+
+    /**
+     * @brief WriteHeader copies the header buffer, must be called before any event is added
+     * @param headerfile existing Acqu Mk2 file, may be compressed
+     */
+    void WriteHeader(const std::string& headerfile);
+
+    /**
+     * @brief MakeHit encodes a raw hit as data word
+     * @param rawchannel
+     * @param value
+     * @return word to be used in AddEvent
+     */
+    static std::uint32_t MakeHit(std::uint16_t rawchannel, std::uint16_t value);
+
+    /**
+     * @brief AddEvent appends an event, a new data buffer is started if necessary
+     * @param hits data words of the event, without end-of-event marker
+     */
+    void AddEvent(const std::vector<std::uint32_t>& hits);
+
+    /**
+     * @brief Close writes the last data buffer and the end buffer, also done on destruction
+     */
+    void Close();
+
+    unsigned GetEvents() const { return nEvents; }
+
+    static constexpr std::size_t BufferWords = 10*0x8000/sizeof(std::uint32_t);
+
+    class Exception : public std::runtime_error {
+        using std::runtime_error::runtime_error; // use base class constructor
+    };
+
+protected:
+    std::ofstream file;
+    std::vector<std::uint32_t> databuffer;
+    unsigned nEvents = 0;
+
+    void writeBuffer();
+};
+
+}}} // namespace ant::unpacker::acqu
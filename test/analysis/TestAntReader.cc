@@ -3,6 +3,7 @@
 #include "expconfig_helpers.h"
 
 #include "analysis/input/ant/AntReader.h"
+#include "analysis/input/treeEvents_t.h"
 
 #include "tree/TEvent.h"
 #include "tree/TEventData.h"
@@ -12,11 +13,13 @@
 
 #include "base/WrapTFile.h"
 #include "base/tmpfile_t.h"
+#include "base/Shard.h"
 
 #include "TTree.h"
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 using namespace ant;
@@ -24,12 +27,23 @@ using namespace ant::analysis;
 using namespace ant::analysis::input;
 
 void dotest_read_unpacker();
+void dotest_shards(bool withFlags);
 
 TEST_CASE("AntReader: Read from unpacker", "[analysis]") {
     test::EnsureSetup();
     dotest_read_unpacker();
 }
 
+TEST_CASE("AntReader: Shards of tree", "[analysis]") {
+    test::EnsureSetup();
+    dotest_shards(true);
+}
+
+TEST_CASE("AntReader: Shards of tree without slowcontrol flags", "[analysis]") {
+    test::EnsureSetup();
+    dotest_shards(false);
+}
+
 
 void dotest_read_unpacker() {
     auto unpacker = Unpacker::Get(string(TEST_BLOBS_DIRECTORY)+"/Acqu_oneevent-big.dat.xz");
@@ -58,3 +72,68 @@ void dotest_read_unpacker() {
     REQUIRE(nCandidates == 864);
 
 }
+
+struct shard_t {
+    vector<TID> IDs;
+    unsigned nLeadIn = 0;
+    bool LeadInStartsWithSlowControl = true;
+};
+
+shard_t read_shard(const string& filename, const Shard& shard) {
+    auto inputfiles = make_shared<WrapTFileInput>(filename);
+    AntReader reader(inputfiles, nullptr, nullptr);
+    if(!shard.IsTrivial())
+        REQUIRE(reader.SetShard(shard));
+
+    shard_t s;
+    event_t event;
+    while(reader.ReadNextEvent(event)) {
+        if(event.ShardOverlap == Shard::Overlap_t::None) {
+            s.IDs.push_back(event.Reconstructed().ID);
+        }
+        else if(event.ShardOverlap == Shard::Overlap_t::LeadIn) {
+            // lead-in events start with the needed slowcontrol items
+            if(s.nLeadIn == 0)
+                s.LeadInStartsWithSlowControl = treeEvents_t::GetSlowControlFlags(event) != 0;
+            s.nLeadIn++;
+        }
+    }
+    return s;
+}
+
+void dotest_shards(bool withFlags) {
+    tmpfile_t tmpfile;
+
+    // write all events of some raw file with scalers into a tree
+    {
+        WrapTFileOutput outfile(tmpfile.filename, true);
+        treeEvents_t treeEvents;
+        treeEvents.CreateBranches(new TTree("treeEvents","TEvent data"), !withFlags);
+        auto unpacker = Unpacker::Get(string(TEST_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz");
+        while(auto event = unpacker->NextEvent()) {
+            event_t e(move(event));
+            treeEvents.slowcontrols = treeEvents_t::GetSlowControlFlags(e);
+            treeEvents.data = move(e);
+            treeEvents.Tree->Fill();
+        }
+        treeEvents.Tree->Write();
+    }
+
+    const auto all = read_shard(tmpfile.filename, {});
+    REQUIRE(all.IDs.size() == 211);
+    REQUIRE(all.nLeadIn == 0);
+
+    // the shards read consecutively give exactly the unsharded events
+    constexpr unsigned nShards = 4;
+    vector<TID> merged;
+    unsigned nLeadIn = 0;
+    for(unsigned i=0;i<nShards;i++) {
+        const auto s = read_shard(tmpfile.filename, Shard(i, nShards));
+        merged.insert(merged.end(), s.IDs.begin(), s.IDs.end());
+        REQUIRE(s.LeadInStartsWithSlowControl);
+        nLeadIn += s.nLeadIn;
+    }
+    REQUIRE(merged == all.IDs);
+    // the scalers are spread over the file, so later shards need some lead-in
+    REQUIRE(nLeadIn > 0);
+}
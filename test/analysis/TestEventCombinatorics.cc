@@ -0,0 +1,82 @@
+#include "catch.hpp"
+
+#include "analysis/utils/EventCombinatorics.h"
+#include "analysis/utils/ParticleID.h"
+#include "analysis/physics/manager_t.h"
+
+#include "tree/TEventData.h"
+
+#include "base/std_ext/memory.h"
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+using namespace ant::analysis::utils;
+
+void dotest_combinations();
+void dotest_manager();
+
+TEST_CASE("EventCombinatorics: Photon combinations", "[analysis]") {
+    utils::ParticleID::SetDefault(std_ext::make_unique<utils::SimpleParticleID>());
+    dotest_combinations();
+    dotest_manager();
+}
+
+TEventData make_eventdata(unsigned nPhotons) {
+    TEventData eventdata;
+    // one proton in between
+    for(unsigned i=0;i<=nPhotons;i++) {
+        const double vetoE = i == 1 ? 1.0 : 0.0;
+        eventdata.Candidates.emplace_back(Detector_t::Type_t::CB, 100.0+20*i, 0.3*(i+1), 0.5*i, 0, 1, vetoE, 0,
+                                          TClusterList{});
+    }
+    return eventdata;
+}
+
+void dotest_combinations() {
+    const auto eventdata = make_eventdata(5);
+    EventCombinatorics combinatorics(eventdata);
+
+    const auto& photons = combinatorics.Photons();
+    REQUIRE(photons.size() == 5);
+    REQUIRE(combinatorics.Particles().Get(ParticleTypeDatabase::Proton).size() == 1);
+    // built only once
+    REQUIRE(addressof(combinatorics.Particles()) == addressof(combinatorics.Particles()));
+
+    for(unsigned n=1;n<=6;n++) {
+        const auto& combs = combinatorics.PhotonCombinations(n);
+        REQUIRE(combs.N == n);
+        REQUIRE(addressof(combinatorics.PhotonCombinations(n)) == addressof(combs));
+
+        // compare with plain combinations
+        size_t i = 0;
+        for(auto comb = makeCombination(photons, n); !comb.done(); ++comb, ++i) {
+            REQUIRE(i < combs.size());
+            LorentzVec sum;
+            for(unsigned j=0;j<n;j++) {
+                REQUIRE(photons[combs.IndicesOf(i)[j]] == comb.at(j));
+                sum += *comb.at(j);
+            }
+            REQUIRE(combs.Sums[i].M() == Approx(sum.M()));
+            REQUIRE(combs.IMs[i] == Approx(sum.M()));
+        }
+        REQUIRE(combs.size() == i);
+        REQUIRE(combs.Indices.size() == i*n);
+    }
+    REQUIRE(combinatorics.PhotonCombinations(2).size() == 10);
+    REQUIRE(combinatorics.PhotonCombinations(6).size() == 0);
+}
+
+void dotest_manager() {
+    const auto reconstructed = make_eventdata(3);
+    const auto mctrue = make_eventdata(2);
+
+    physics::manager_t manager;
+    auto& c1 = manager.Combinatorics(reconstructed);
+    auto& c2 = manager.Combinatorics(mctrue);
+    REQUIRE(addressof(c1) != addressof(c2));
+    REQUIRE(addressof(manager.Combinatorics(reconstructed)) == addressof(c1));
+    REQUIRE(addressof(c1.EventData()) == addressof(reconstructed));
+    REQUIRE(c1.Photons().size() == 3);
+    REQUIRE(c2.Photons().size() == 2);
+}
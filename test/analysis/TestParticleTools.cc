@@ -37,3 +37,71 @@ TEST_CASE("ParticleTools: GetPlutoProduction", "[analysis]") {
 
 
 
+
+TEST_CASE("ParticleTools: TryFindParticleDatabaseChannel", "[analysis]") {
+
+    using Ch_t = ParticleTypeTreeDatabase::Channel;
+
+    auto make_particle = [] (const ParticleTypeDatabase::Type& type) {
+        return make_shared<TParticle>(type, LorentzVec());
+    };
+
+    for(auto ch : ParticleTypeTreeDatabase()) {
+        auto typetree = ParticleTypeTreeDatabase::Get(ch);
+        auto ptree = typetree->DeepCopy<TParticlePtr>([make_particle] (const ParticleTypeTree& n) {
+            return make_particle(n->Get());
+        });
+        CHECK(ParticleTools::GetTypeSignature(ptree) == ParticleTypeTreeDatabase::GetSignature(typetree));
+        CHECK(ParticleTools::GetTypeSignature(TParticleFlatTree_t::FromTree(ptree)) == ParticleTools::GetTypeSignature(ptree));
+
+        Ch_t found;
+        REQUIRE(ParticleTools::TryFindParticleDatabaseChannel(ptree, found));
+        // identical trees might be registered as different channels
+        CHECK(ParticleTools::GetDecayString(ParticleTypeTreeDatabase::Get(found)) == ParticleTools::GetDecayString(typetree));
+    }
+
+    // daughters not sorted
+    auto ptree = Tree<TParticlePtr>::MakeNode(make_particle(ParticleTypeDatabase::BeamProton));
+    ptree->CreateDaughter(make_particle(ParticleTypeDatabase::Proton));
+    auto pi0 = ptree->CreateDaughter(make_particle(ParticleTypeDatabase::Pi0));
+    pi0->CreateDaughter(make_particle(ParticleTypeDatabase::Photon));
+    pi0->CreateDaughter(make_particle(ParticleTypeDatabase::Photon));
+    Ch_t found;
+    REQUIRE(ParticleTools::TryFindParticleDatabaseChannel(ptree, found));
+    CHECK(found == Ch_t::Pi0_2g);
+
+    // not in database
+    pi0->CreateDaughter(make_particle(ParticleTypeDatabase::Photon));
+    CHECK_FALSE(ParticleTools::TryFindParticleDatabaseChannel(ptree, found));
+    CHECK_FALSE(ParticleTools::TryFindParticleDatabaseChannel(nullptr, found));
+}
+
+TEST_CASE("ParticleTools: TypeTreeMatcher", "[analysis]") {
+
+    using Ch_t = ParticleTypeTreeDatabase::Channel;
+
+    auto make_particle = [] (const ParticleTypeDatabase::Type& type) {
+        return make_shared<TParticle>(type, LorentzVec());
+    };
+
+    // daughters not sorted
+    auto ptree = Tree<TParticlePtr>::MakeNode(make_particle(ParticleTypeDatabase::BeamProton));
+    ptree->CreateDaughter(make_particle(ParticleTypeDatabase::Proton));
+    auto pi0 = ptree->CreateDaughter(make_particle(ParticleTypeDatabase::Pi0));
+    pi0->CreateDaughter(make_particle(ParticleTypeDatabase::Photon));
+    pi0->CreateDaughter(make_particle(ParticleTypeDatabase::Photon));
+
+    const auto pi0_2g = ParticleTypeTreeDatabase::Get(Ch_t::Pi0_2g);
+    const auto eta_2g = ParticleTypeTreeDatabase::Get(Ch_t::Eta_2g);
+
+    ParticleTools::TypeTreeMatcher matcher(ptree);
+    CHECK(matcher.Signature == ParticleTypeTreeDatabase::GetSignature(pi0_2g));
+    CHECK(matcher.Matches(pi0_2g, ParticleTypeTreeDatabase::GetSignature(pi0_2g)));
+    CHECK_FALSE(matcher.Matches(eta_2g, ParticleTypeTreeDatabase::GetSignature(eta_2g)));
+    // a colliding signature is caught by comparing the trees
+    CHECK_FALSE(matcher.Matches(eta_2g, ParticleTypeTreeDatabase::GetSignature(pi0_2g)));
+    CHECK_FALSE(matcher.Matches(pi0_2g, ParticleTypeTreeDatabase::GetSignature(eta_2g)));
+
+    ParticleTools::TypeTreeMatcher nomatcher(nullptr);
+    CHECK_FALSE(nomatcher.Matches(pi0_2g, nomatcher.Signature));
+}
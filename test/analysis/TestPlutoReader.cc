@@ -0,0 +1,88 @@
+#include "catch.hpp"
+#include "catch_config.h"
+#include "expconfig_helpers.h"
+
+#include "analysis/input/pluto/PlutoReader.h"
+#include "analysis/utils/ParticleTools.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "base/WrapTFile.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+using namespace ant::analysis::input;
+
+void dotest_blocks();
+
+TEST_CASE("PlutoReader: Read in blocks", "[analysis]") {
+    test::EnsureSetup();
+    dotest_blocks();
+}
+
+struct mctrue_t {
+    uint32_t Lower; // timestamp differs if file has no TID tree
+    string DecayString;
+    double CBEnergySum;
+    unsigned ClusterMultiplicity;
+    size_t nTaggerHits;
+};
+
+vector<mctrue_t> read(unsigned blocksize, const Shard& shard = {}) {
+    PlutoReader::BlockSize = blocksize;
+    auto rootfile = make_shared<WrapTFileInput>(string(TEST_BLOBS_DIRECTORY)+"/Pluto_Etap2g.root");
+    PlutoReader reader(rootfile);
+    if(!shard.IsTrivial())
+        REQUIRE(reader.SetShard(shard));
+
+    vector<mctrue_t> events;
+    while(true) {
+        event_t event;
+        if(!reader.ReadNextEvent(event))
+            break;
+        auto& mctrue = event.MCTrue();
+        REQUIRE(mctrue.ParticleTree);
+        events.push_back({mctrue.ID.Lower, utils::ParticleTools::GetDecayString(mctrue.ParticleTree),
+                          mctrue.Trigger.CBEnergySum, mctrue.Trigger.ClusterMultiplicity,
+                          mctrue.TaggerHits.size()});
+    }
+    return events;
+}
+
+void require_equal(const vector<mctrue_t>& a, const vector<mctrue_t>& b) {
+    REQUIRE(a.size() == b.size());
+    for(size_t i=0;i<a.size();i++) {
+        REQUIRE(a[i].Lower == b[i].Lower);
+        REQUIRE(a[i].DecayString == b[i].DecayString);
+        REQUIRE(a[i].CBEnergySum == Approx(b[i].CBEnergySum));
+        REQUIRE(a[i].ClusterMultiplicity == b[i].ClusterMultiplicity);
+        REQUIRE(a[i].nTaggerHits == b[i].nTaggerHits);
+    }
+}
+
+void dotest_blocks() {
+    const auto blocksize = PlutoReader::BlockSize;
+
+    const auto all = read(1);
+    REQUIRE(!all.empty());
+
+    // events must not depend on how they're split into blocks
+    require_equal(all, read(7));
+    require_equal(all, read(blocksize));
+
+    // shards continue the blocks at the shard start
+    vector<mctrue_t> merged;
+    for(unsigned i=0;i<3;i++) {
+        auto shard = read(7, Shard(i, 3));
+        merged.insert(merged.end(), shard.begin(), shard.end());
+    }
+    require_equal(all, merged);
+
+    PlutoReader::BlockSize = blocksize;
+}
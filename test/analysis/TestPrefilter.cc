@@ -0,0 +1,153 @@
+#include "catch.hpp"
+#include "catch_config.h"
+
+#include "detail/Prefilter.h"
+
+#include "base/WrapTFile.h"
+#include "base/tmpfile_t.h"
+#include "base/std_ext/math.h"
+
+#include "TTree.h"
+#include "TClonesArray.h"
+#include "TRandom3.h"
+#include "PParticle.h"
+
+#include <string>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace ant;
+using namespace ant::progs::prefilter;
+
+void dotest_serial();
+void dotest_threads();
+
+TEST_CASE("Prefilter: Same as serial rejection", "[analysis]") {
+    dotest_serial();
+}
+
+TEST_CASE("Prefilter: Independent of threads", "[analysis]") {
+    dotest_threads();
+}
+
+const string inputfile = string(TEST_BLOBS_DIRECTORY)+"/Pluto_Etap2g.root";
+constexpr unsigned seed = 1234;
+
+// accept by the direction of the first particle,
+// entries without particles are invalid
+double weight(const TClonesArray& particles) {
+    if(particles.GetEntries() == 0)
+        return std_ext::NaN;
+    const auto p = dynamic_cast<const PParticle*>(particles.At(0));
+    if(!p)
+        return std_ext::NaN;
+    return (p->CosTheta() + 1.0)/2.0;
+}
+
+// identifies an entry by its particles
+struct entry_t {
+    int nParticles;
+    double E;
+    double Theta;
+};
+
+vector<entry_t> read_entries(TTree& tree) {
+    TClonesArray* buffer = nullptr;
+    tree.SetBranchAddress("Particles", &buffer);
+    vector<entry_t> entries;
+    for(long long i=0;i<tree.GetEntries();i++) {
+        tree.GetEntry(i);
+        const auto p = buffer->GetEntries()>0 ? dynamic_cast<const PParticle*>(buffer->At(0)) : nullptr;
+        entries.push_back({buffer->GetEntries(), p ? p->E() : 0.0, p ? p->Theta() : 0.0});
+    }
+    tree.ResetBranchAddresses();
+    return entries;
+}
+
+// the former loop of Ant-mc-prefilter, with the generator
+// seeded again at the start of each range
+vector<entry_t> run_serial(long long rangesize, long long& nRead) {
+    WrapTFileInput input(inputfile);
+    TTree* tree = nullptr;
+    REQUIRE(input.GetObject("data", tree));
+
+    const auto all = read_entries(*tree);
+    nRead = all.size();
+
+    vector<entry_t> accepted;
+    TRandom3 rng;
+    TClonesArray* buffer = nullptr;
+    tree->SetBranchAddress("Particles", &buffer);
+    for(long long i=0;i<tree->GetEntries();i++) {
+        if(i % rangesize == 0)
+            rng.SetSeed(seed + unsigned(i/rangesize));
+        tree->GetEntry(i);
+        const auto w = weight(*buffer);
+        if(!isfinite(w))
+            continue;
+        if(w >= 1.0 || rng.Uniform(0.0, 1.0) <= w)
+            accepted.push_back(all[i]);
+    }
+    return accepted;
+}
+
+vector<entry_t> run_prefilter(long long rangesize, unsigned threads, Prefilter::result_t& result) {
+    tmpfolder_t tmpfolder;
+    const string outputfile = tmpfolder.foldername+"/prefiltered.root";
+
+    Prefilter prefilter(inputfile, weight);
+    prefilter.Threads = threads;
+    prefilter.RangeSize = rangesize;
+    prefilter.Seed = seed;
+    {
+        WrapTFileOutput output(outputfile);
+        result = prefilter.Run(output, outputfile);
+    }
+
+    WrapTFileInput input(outputfile);
+    TTree* tree = nullptr;
+    REQUIRE(input.GetObject("data", tree));
+    return read_entries(*tree);
+}
+
+void require_equal(const vector<entry_t>& a, const vector<entry_t>& b) {
+    REQUIRE(a.size() == b.size());
+    for(size_t i=0;i<a.size();i++) {
+        REQUIRE(a[i].nParticles == b[i].nParticles);
+        REQUIRE(a[i].E == b[i].E);
+        REQUIRE(a[i].Theta == b[i].Theta);
+    }
+}
+
+void dotest_serial() {
+    // one range over the whole file is the same as the former single generator
+    for(long long rangesize : {1000000ll, 7ll}) {
+        long long nRead = 0;
+        const auto expected = run_serial(rangesize, nRead);
+        REQUIRE(nRead > 0);
+        REQUIRE(!expected.empty());
+        REQUIRE(expected.size() < size_t(nRead));
+
+        Prefilter::result_t result;
+        const auto accepted = run_prefilter(rangesize, 1, result);
+        CHECK(result.Read == nRead);
+        CHECK(result.Accepted == (long long)expected.size());
+        require_equal(accepted, expected);
+    }
+}
+
+void dotest_threads() {
+    Prefilter::result_t result1;
+    const auto accepted1 = run_prefilter(7, 1, result1);
+    REQUIRE(!accepted1.empty());
+
+    for(unsigned threads : {2u, 3u, 16u}) {
+        Prefilter::result_t result;
+        const auto accepted = run_prefilter(7, threads, result);
+        CHECK(result.Read == result1.Read);
+        CHECK(result.Accepted == result1.Accepted);
+        CHECK(result.Invalid == result1.Invalid);
+        require_equal(accepted, accepted1);
+    }
+}
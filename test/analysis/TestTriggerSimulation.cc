@@ -0,0 +1,96 @@
+#include "catch.hpp"
+#include "expconfig_helpers.h"
+
+#include "analysis/utils/TriggerSimulation.h"
+#include "analysis/physics/manager_t.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+using namespace std;
+using namespace ant;
+using namespace ant::analysis;
+
+void dotest_simulation();
+void dotest_shared();
+
+TEST_CASE("TriggerSimulation: Simulation", "[analysis]") {
+    test::EnsureSetup();
+    dotest_simulation();
+}
+
+TEST_CASE("TriggerSimulation: Shared by manager", "[analysis]") {
+    test::EnsureSetup();
+    dotest_shared();
+}
+
+TEvent make_event() {
+    TEvent event(TID(10, 20));
+    auto& recon = event.Reconstructed();
+
+    recon.Clusters.emplace_back(vec3(1,0,0), 100, 2.0, Detector_t::Type_t::CB, 1);
+    recon.Clusters.emplace_back(vec3(0,1,0), 300, 6.0, Detector_t::Type_t::CB, 2);
+    // ignored: TAPS and insane CB cluster
+    recon.Clusters.emplace_back(vec3(0,0,1), 500, 100.0, Detector_t::Type_t::TAPS, 3);
+    recon.Clusters.emplace_back(vec3(0,0,1), 500, std_ext::NaN, Detector_t::Type_t::CB, 4);
+
+    const LogicalChannel_t cb_integral{Detector_t::Type_t::CB, Channel_t::Type_t::Integral, 1};
+    const LogicalChannel_t cb_timing{Detector_t::Type_t::CB, Channel_t::Type_t::Timing, 1};
+    recon.DetectorReadHits.emplace_back(cb_integral, TDetectorReadHit::Value_t(100.0));
+    recon.DetectorReadHits.emplace_back(cb_integral, TDetectorReadHit::Value_t(250.0));
+    recon.DetectorReadHits.emplace_back(cb_timing, TDetectorReadHit::Value_t(1000.0));
+
+    recon.TaggerHits.emplace_back(1, 1400.0, 10.0);
+    recon.TaggerHits.emplace_back(2, 1300.0, -7.0);
+    recon.TaggerHits.emplace_back(3, 1200.0, 0.0);
+    return event;
+}
+
+void dotest_simulation() {
+    const auto event = make_event();
+    const auto& taggerhits = event.Reconstructed().TaggerHits;
+
+    utils::TriggerSimulation triggersimu;
+    REQUIRE(triggersimu.ProcessEvent(event));
+    REQUIRE(triggersimu.IsSane());
+    REQUIRE(triggersimu.HasTriggered());
+    REQUIRE(triggersimu.GetCBEnergySum() == Approx(350.0));
+    REQUIRE(triggersimu.GetRefTiming() == Approx((100.0*2.0+300.0*6.0)/400.0));
+
+    const auto& times = triggersimu.GetCorrectedTaggerTimes();
+    REQUIRE(times.size() == taggerhits.size());
+    for(size_t i=0;i<taggerhits.size();i++)
+        REQUIRE(times[i] == triggersimu.GetCorrectedTaggerTime(taggerhits[i]));
+
+    vector<double> batch{1.0, 2.0, 3.0, 4.0, 5.0};
+    triggersimu.GetCorrectedTaggerTimes(taggerhits, batch);
+    REQUIRE(batch == times);
+
+    // no CB clusters, timing not available
+    TEvent empty(TID(10, 21));
+    empty.Reconstructed().TaggerHits.emplace_back(1, 1400.0, 10.0);
+    REQUIRE_FALSE(triggersimu.ProcessEvent(empty));
+    REQUIRE_FALSE(triggersimu.IsSane());
+    REQUIRE(triggersimu.GetCorrectedTaggerTimes().size() == 1);
+    REQUIRE(std::isnan(triggersimu.GetCorrectedTaggerTimes().front()));
+}
+
+void dotest_shared() {
+    const auto event = make_event();
+
+    physics::manager_t manager;
+    auto& triggersimu = manager.TriggerSimu(event);
+    REQUIRE(triggersimu.IsSane());
+    REQUIRE(addressof(manager.TriggerSimu(event)) == addressof(triggersimu));
+
+    utils::TriggerSimulation expected;
+    expected.ProcessEvent(event);
+    REQUIRE(triggersimu.GetCBEnergySum() == expected.GetCBEnergySum());
+    REQUIRE(triggersimu.GetRefTiming() == expected.GetRefTiming());
+    REQUIRE(triggersimu.GetCorrectedTaggerTimes() == expected.GetCorrectedTaggerTimes());
+
+    // another event is processed again
+    TEvent empty(TID(10, 21));
+    REQUIRE_FALSE(manager.TriggerSimu(empty).IsSane());
+    REQUIRE(manager.TriggerSimu(event).IsSane());
+}
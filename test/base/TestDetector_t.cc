@@ -1,8 +1,11 @@
 #include "catch.hpp"
 
 #include "base/Detector_t.h"
+#include "base/interval.h"
 
+#include <cmath>
 #include <sstream>
+#include <vector>
 
 using namespace ant;
 using namespace std;
@@ -130,3 +133,88 @@ TEST_CASE("Detector_t: Detector interface", "[base]") {
     CHECK(det.IsIgnored(8));
 }
 
+
+struct TestTagger_t : TaggerDetector_t {
+    std::vector<double> Energies;
+    double Width = std_ext::NaN; // use default width from neighbours if NaN
+    ElementFlags_t Flags;
+
+    TestTagger_t(const std::vector<double>& energies) :
+        TaggerDetector_t(Detector_t::Type_t::EPT, 1000.0),
+        Energies(energies)
+    {}
+
+    virtual double GetPhotonEnergy(unsigned channel) const override {
+        return Energies.at(channel);
+    }
+    virtual double GetPhotonEnergyWidth(unsigned channel) const override {
+        return std::isfinite(Width) ? Width : TaggerDetector_t::GetPhotonEnergyWidth(channel);
+    }
+    virtual unsigned GetNChannels() const override {
+        return unsigned(Energies.size());
+    }
+    virtual void SetElementFlags(unsigned, const ElementFlags_t&) override {}
+    virtual const ElementFlags_t& GetElementFlags(unsigned) const override {
+        return Flags;
+    }
+
+    // the simple linear search
+    unsigned FindChannel(double photonEnergy) const {
+        for(unsigned ch=0;ch<GetNChannels();++ch) {
+            if(interval<double>::CenterWidth(GetPhotonEnergy(ch), GetPhotonEnergyWidth(ch)).Contains(photonEnergy))
+                return ch;
+        }
+        return NoChannel;
+    }
+};
+
+void check_tagger_lookup(const TestTagger_t& tagger) {
+    std::vector<double> photonEnergies;
+    for(double E = 0; E < 1100; E += 0.37)
+        photonEnergies.emplace_back(E);
+    // exactly at boundaries and centers
+    for(unsigned ch=0;ch<tagger.GetNChannels();ch++) {
+        const auto i = interval<double>::CenterWidth(tagger.GetPhotonEnergy(ch), tagger.GetPhotonEnergyWidth(ch));
+        photonEnergies.emplace_back(i.Start());
+        photonEnergies.emplace_back(i.Center());
+        photonEnergies.emplace_back(i.Stop());
+    }
+    photonEnergies.emplace_back(std_ext::NaN);
+
+    std::vector<unsigned> channels;
+    tagger.GetChannelsFromPhotons(photonEnergies, channels);
+    REQUIRE(channels.size() == photonEnergies.size());
+
+    for(size_t i=0;i<photonEnergies.size();i++) {
+        const auto expected = tagger.FindChannel(photonEnergies[i]);
+        unsigned ch;
+        REQUIRE(tagger.TryGetChannelFromPhoton(photonEnergies[i], ch) == (expected != TaggerDetector_t::NoChannel));
+        REQUIRE(ch == expected);
+        REQUIRE(channels[i] == expected);
+    }
+}
+
+TEST_CASE("Detector_t: Tagger channel lookup", "[base]") {
+    // descending energies, unequal spacing
+    std::vector<double> energies;
+    for(unsigned ch=0;ch<300;ch++)
+        energies.emplace_back(1000.0 - 3.0*ch - 0.002*ch*ch);
+
+    SECTION("Widths from neighbours") {
+        TestTagger_t tagger(energies);
+        check_tagger_lookup(tagger);
+    }
+
+    SECTION("Overlapping fixed widths") {
+        TestTagger_t tagger(energies);
+        tagger.Width = 7.5;
+        check_tagger_lookup(tagger);
+    }
+
+    SECTION("Gaps and unsorted channels") {
+        std::swap(energies[10], energies[200]);
+        TestTagger_t tagger(energies);
+        tagger.Width = 1.0;
+        check_tagger_lookup(tagger);
+    }
+}
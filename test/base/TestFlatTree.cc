@@ -0,0 +1,97 @@
+#include "catch.hpp"
+#include "base/FlatTree.h"
+#include "base/ParticleTypeTree.h"
+
+using namespace std;
+using namespace ant;
+
+TEST_CASE("FlatTree: Empty", "[base]") {
+    FlatTree<int> flat;
+    REQUIRE(flat.Empty());
+    REQUIRE(flat.Signature([] (int i) { return i; }) == 0);
+    REQUIRE(flat.ToTree() == nullptr);
+    REQUIRE(FlatTree<int>::FromTree(nullptr).Empty());
+}
+
+TEST_CASE("FlatTree: Convert from/to Tree", "[base]") {
+    auto a = Tree<int>::MakeNode(10);
+    auto b = a->CreateDaughter(20);
+    b->CreateDaughter(30);
+    b->CreateDaughter(35);
+    a->CreateDaughter(40);
+
+    auto flat = FlatTree<int>::FromTree(a);
+    REQUIRE(flat.Size() == 5);
+
+    // depth-first order
+    vector<int> values;
+    flat.Map([&values] (int i) { values.push_back(i); });
+    REQUIRE((values == vector<int>{10, 20, 30, 35, 40}));
+
+    REQUIRE(flat.IsRoot(0));
+    REQUIRE(flat.NumDaughters(0) == 2);
+    REQUIRE(flat.FirstDaughter(0) == 1);
+    REQUIRE(flat.NextSibling(1) == 4);
+    REQUIRE(flat.NextSibling(4) == FlatTree<int>::None);
+    REQUIRE(flat.Parent(3) == 1);
+    REQUIRE(flat.IsLeaf(2));
+    REQUIRE_FALSE(flat.IsLeaf(1));
+
+    int sum = 0;
+    flat.Map_daughters(1, [&sum] (int i) { sum += i; });
+    REQUIRE(sum == 65);
+
+    auto t = flat.ToTree();
+    REQUIRE(t->Size() == a->Size());
+    REQUIRE(t->Depth() == a->Depth());
+    vector<int> tree_values;
+    t->Map([&tree_values] (int i) { tree_values.push_back(i); });
+    REQUIRE(tree_values == values);
+    REQUIRE(t->Daughters().front()->Daughters().back()->Get() == 35);
+}
+
+TEST_CASE("FlatTree: Signature", "[base]") {
+    auto key = [] (int i) { return i; };
+
+    auto a = Tree<int>::MakeNode(1);
+    auto a0 = a->CreateDaughter(2);
+    a0->CreateDaughter(3);
+    a0->CreateDaughter(4);
+    a->CreateDaughter(5);
+
+    // same tree, different order of daughters
+    auto b = Tree<int>::MakeNode(1);
+    b->CreateDaughter(5);
+    auto b1 = b->CreateDaughter(2);
+    b1->CreateDaughter(4);
+    b1->CreateDaughter(3);
+
+    // same nodes, different structure
+    auto c = Tree<int>::MakeNode(1);
+    auto c0 = c->CreateDaughter(2);
+    c0->CreateDaughter(3);
+    c->CreateDaughter(5)->CreateDaughter(4);
+
+    const auto sig_a = FlatTree<int>::FromTree(a).Signature(key);
+    REQUIRE(sig_a == FlatTree<int>::FromTree(b).Signature(key));
+    REQUIRE(sig_a != FlatTree<int>::FromTree(c).Signature(key));
+    REQUIRE(sig_a != FlatTree<int>::FromTree(a0).Signature(key));
+}
+
+TEST_CASE("FlatTree: ParticleTypeTree", "[base]") {
+    using flat_t = FlatTree<const ParticleTypeDatabase::Type*>;
+    auto to_ptr = [] (const ParticleTypeDatabase::Type& t) { return addressof(t); };
+    auto key = [] (const ParticleTypeDatabase::Type* t) { return std::hash<string>()(t->Name()); };
+
+    auto ptree = ParticleTypeTreeDatabase::Get(ParticleTypeTreeDatabase::Channel::TwoPi0_4g);
+    auto flat = flat_t::FromTree(ptree, to_ptr);
+    REQUIRE(flat.Size() == ptree->Size());
+    REQUIRE(*flat.Get(0) == ptree->Get());
+
+    for(auto ch : ParticleTypeTreeDatabase()) {
+        if(ch == ParticleTypeTreeDatabase::Channel::TwoPi0_4g)
+            continue;
+        auto other = flat_t::FromTree(ParticleTypeTreeDatabase::Get(ch), to_ptr);
+        CHECK(flat.Signature(key) != other.Signature(key));
+    }
+}
@@ -4,15 +4,18 @@
 #include "base/Interpolator.h"
 #include "base/std_ext/memory.h"
 
-#include "interp2d/interp2d.h" // for INDEX_2D
+#include "interp2d/interp2d.h"
 
 #include <iostream>
+#include <memory>
+#include <cmath>
 
 using namespace std;
 using namespace ant;
 
 void dotest_symmetric(Interpolator2D::Type type);
 void dotest_weird();
+void dotest_batch(Interpolator2D::Type type);
 
 TEST_CASE("Interpolator2D: Bicubic", "[base]") {
     dotest_symmetric(Interpolator2D::Type::Bicubic);
@@ -27,6 +30,14 @@ TEST_CASE("Interpolator2D: Weird stuff", "[base]") {
     dotest_weird();
 }
 
+TEST_CASE("Interpolator2D: Batch Bicubic", "[base]") {
+    dotest_batch(Interpolator2D::Type::Bicubic);
+}
+
+TEST_CASE("Interpolator2D: Batch Bilinear", "[base]") {
+    dotest_batch(Interpolator2D::Type::Bilinear);
+}
+
 void dotest_symmetric(Interpolator2D::Type type) {
     const vector<double> x{0.0, 1.0, 2.0, 3.0};
     const vector<double> y{0.0, 1.0, 2.0, 3.0};
@@ -60,7 +71,83 @@ void dotest_weird() {
     const vector<double> z{1,2,3};
 
     REQUIRE_THROWS_AS(std_ext::make_unique<Interpolator2D>(x,y,z), Interpolator2D::Exception);
+
+    // too few grid points
+    const vector<double> x_small{1,2,3};
+    const vector<double> z_small(x_small.size()*y.size(), 1.0);
+    REQUIRE_THROWS_AS(std_ext::make_unique<Interpolator2D>(x_small,y,z_small), Interpolator2D::Exception);
+    REQUIRE_NOTHROW(Interpolator2D(x_small,y,z_small,Interpolator2D::Type::Bilinear));
+
+    // not ascending
+    const vector<double> x_unordered{1,3,2,4};
+    const vector<double> z_square(x.size()*y.size(), 1.0);
+    REQUIRE_THROWS_AS(std_ext::make_unique<Interpolator2D>(x_unordered,y,z_square), Interpolator2D::Exception);
 }
 
+void dotest_batch(Interpolator2D::Type type) {
+    const vector<double> x{0.0, 1.0, 2.5, 3.0, 4.0};
+    const vector<double> y{-1.0, 0.0, 2.0, 3.0};
+    vector<double> z;
+    for(auto y_ : y)
+        for(auto x_ : x)
+            z.emplace_back(sin(x_)*cos(y_));
+    const Interpolator2D inter(x,y,z, type);
+
+    vector<double> xval;
+    vector<double> yval;
+    for(double x_=0.0;x_<=4.0;x_+=0.25) {
+        for(double y_=-1.0;y_<=3.0;y_+=0.5) {
+            xval.emplace_back(x_);
+            yval.emplace_back(y_);
+        }
+    }
+    // outside of the grid
+    xval.emplace_back(-0.5); yval.emplace_back(1.0);
+    xval.emplace_back(1.0);  yval.emplace_back(3.5);
+
+    vector<double> zval;
+    inter.GetPoints(xval, yval, zval);
+    REQUIRE(zval.size() == xval.size());
+
+    for(size_t i=0;i<xval.size()-2;i++)
+        CHECK(zval[i] == inter.GetPoint(xval[i], yval[i]));
+
+    // same as the interp2d library within rounding, mostly between the grid points
+    {
+        const auto ref_type = type == Interpolator2D::Type::Bicubic ? interp2d_bicubic : interp2d_bilinear;
+        unique_ptr<interp2d, void(*)(interp2d*)> ref(interp2d_alloc(ref_type, x.size(), y.size()), interp2d_free);
+        REQUIRE(interp2d_init(ref.get(), x.data(), y.data(), z.data(), x.size(), y.size()) == 0);
+
+        constexpr double tolerance = 1e-9;
+        auto check_reference = [&] (double x_, double y_, double z_) {
+            const auto z_ref = interp2d_eval(ref.get(), x.data(), y.data(), z.data(), x_, y_, nullptr, nullptr);
+            CHECK(z_ == Approx(z_ref).epsilon(tolerance));
+        };
+        for(size_t i=0;i<xval.size()-2;i++)
+            check_reference(xval[i], yval[i], zval[i]);
+        for(double x_=0.01;x_<4.0;x_+=0.37) {
+            for(double y_=-0.93;y_<3.0;y_+=0.29)
+                check_reference(x_, y_, inter.GetPoint(x_, y_));
+        }
+    }
+
+    // exact at the grid points
+    vector<double> xgrid;
+    vector<double> ygrid;
+    for(auto y_ : y) {
+        for(auto x_ : x) {
+            xgrid.emplace_back(x_);
+            ygrid.emplace_back(y_);
+        }
+    }
+    vector<double> zgrid;
+    inter.GetPoints(xgrid, ygrid, zgrid);
+    for(size_t i=0;i<z.size();i++)
+        CHECK(zgrid[i] == Approx(z[i]));
 
+    CHECK(std::isnan(zval[xval.size()-2]));
+    CHECK(std::isnan(zval[xval.size()-1]));
+    CHECK(std::isnan(inter.GetPoint(-0.5, 1.0)));
 
+    REQUIRE_THROWS_AS(inter.GetPoints(xval, {1.0}, zval), Interpolator2D::Exception);
+}
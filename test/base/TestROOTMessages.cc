@@ -0,0 +1,75 @@
+#include "catch.hpp"
+
+#include "base/Logger.h"
+
+#include "TError.h"
+
+#include <thread>
+
+using namespace std;
+using namespace ant;
+
+void dotest_collect();
+void dotest_threads();
+
+TEST_CASE("ROOTMessages: Collect", "[base]") {
+    dotest_collect();
+}
+
+TEST_CASE("ROOTMessages: Threads", "[base]") {
+    dotest_threads();
+}
+
+void dotest_collect() {
+    const auto handler = GetErrorHandler();
+    {
+        logger::ROOTMessages messages;
+        Warning("TestROOTMessages", "first");
+        {
+            logger::ROOTMessages inner;
+            Error("TestROOTMessages", "second");
+            REQUIRE(inner.Messages.size() == 1);
+            CHECK(inner.Messages.front().Level == kError);
+            CHECK(inner.Messages.front().Msg == "second");
+        }
+        Info("TestROOTMessages", "third");
+
+        REQUIRE(messages.Messages.size() == 2);
+        CHECK(messages.Messages[0].Level == kWarning);
+        CHECK(messages.Messages[0].Location == "TestROOTMessages");
+        CHECK(messages.Messages[0].Msg == "first");
+        CHECK(messages.Messages[1].Level == kInfo);
+        CHECK(messages.Messages[1].Msg == "third");
+    }
+    // the previous handler is in place again
+    REQUIRE(GetErrorHandler() == handler);
+}
+
+void dotest_threads() {
+    const auto handler = GetErrorHandler();
+    logger::ROOTMessages messages;
+
+    vector<logger::ROOTMessages::message_t> collected;
+    thread worker([&collected] () {
+        logger::ROOTMessages worker_messages;
+        Warning("TestROOTMessages", "worker");
+        collected = move(worker_messages.Messages);
+    });
+    worker.join();
+
+    // each thread only gets its own messages
+    REQUIRE(collected.size() == 1);
+    CHECK(collected.front().Msg == "worker");
+    REQUIRE(messages.Messages.empty());
+
+    // messages from threads without an instance go to the previous handler
+    thread other([] () {
+        Warning("TestROOTMessages", "other");
+    });
+    other.join();
+    REQUIRE(messages.Messages.empty());
+
+    Warning("TestROOTMessages", "main");
+    REQUIRE(messages.Messages.size() == 1);
+    REQUIRE(GetErrorHandler() != handler);
+}
@@ -0,0 +1,197 @@
+#include "catch.hpp"
+
+#include "detail/RunPlanner.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+using namespace ant::progs::run;
+
+void dotest_mapmerge();
+void dotest_retries();
+void dotest_mergeonly();
+void dotest_mergefailed();
+
+TEST_CASE("RunPlanner: Quote", "[base]") {
+    REQUIRE(quote("file.root") == "'file.root'");
+    REQUIRE(quote("my file.root") == "'my file.root'");
+    REQUIRE(quote("it's") == "'it'\\''s'");
+}
+
+TEST_CASE("RunPlanner: Map and merge", "[base]") {
+    dotest_mapmerge();
+}
+
+TEST_CASE("RunPlanner: Retry failed jobs", "[base]") {
+    dotest_retries();
+}
+
+TEST_CASE("RunPlanner: Merge only", "[base]") {
+    dotest_mergeonly();
+}
+
+TEST_CASE("RunPlanner: Failed merge", "[base]") {
+    dotest_mergefailed();
+}
+
+const string workdir = "/work dir";
+
+vector<string> make_inputs(unsigned n) {
+    vector<string> inputs;
+    for(unsigned i=0;i<n;i++)
+        inputs.emplace_back("/data/file_"+to_string(i)+".dat");
+    return inputs;
+}
+
+struct run_t {
+    map<string, unsigned> runs;    // how often a job was started
+    multiset<string> merged;       // inputs of all merge jobs
+    set<string> removed;           // intermediate files reported as removable
+    vector<job_t> merges;
+};
+
+// runs the planner with the given number of slots,
+// the oldest running job finishes first
+run_t run(Planner& planner, unsigned slots, function<bool(const job_t&)> succeeds) {
+    run_t r;
+    vector<job_t> running;
+    while(!planner.Done()) {
+        while(running.size() < slots && planner.HasNext()) {
+            running.emplace_back(planner.Next());
+            const auto& job = running.back();
+            r.runs[job.Name]++;
+            REQUIRE(planner.Created().count(job.Output) == 1);
+            REQUIRE(planner.Created().count(planner.LogFile(job)) == 1);
+        }
+        REQUIRE_FALSE(running.empty());
+
+        auto job = running.front();
+        running.erase(running.begin());
+        const auto success = succeeds(job);
+        if(success && job.Type == job_t::type_t::Merge) {
+            r.merges.emplace_back(job);
+            r.merged.insert(job.Inputs.begin(), job.Inputs.end());
+        }
+        for(const auto& file : planner.Finished(job, success)) {
+            REQUIRE(r.removed.insert(file).second);
+        }
+    }
+    return r;
+}
+
+void dotest_mapmerge() {
+    const auto inputs = make_inputs(25);
+    Planner planner(inputs, "Ant-plot -i {input} -o {output}", "Ant-hadd", workdir, 4, 2);
+    REQUIRE(planner.Maps() == inputs.size());
+
+    auto r = run(planner, 3, [] (const job_t&) { return true; });
+
+    REQUIRE_FALSE(planner.MergeFailed());
+    REQUIRE(planner.Failed().empty());
+
+    // every map job ran exactly once, with quoted arguments
+    unsigned nMaps = 0;
+    for(const auto& it : r.runs) {
+        REQUIRE(it.second == 1);
+        if(it.first.find("Map_") == 0)
+            nMaps++;
+    }
+    REQUIRE(nMaps == inputs.size());
+
+    // every intermediate output is merged exactly once, with at most 4 per merge job
+    for(const auto& job : r.merges) {
+        REQUIRE(job.Inputs.size() >= 2);
+        REQUIRE(job.Inputs.size() <= 4);
+        REQUIRE(job.Cmd.find("Ant-hadd '"+job.Output+"'") == 0);
+        for(const auto& input : job.Inputs) {
+            REQUIRE(r.merged.count(input) == 1);
+            REQUIRE(input.find(workdir+"/") == 0);
+        }
+    }
+    for(size_t i=0;i<inputs.size();i++)
+        REQUIRE(r.merged.count(workdir+"/Map_"+to_string(i)+".root") == 1);
+
+    // the result is the only output never merged, all others can be removed
+    const auto result = planner.Result();
+    REQUIRE(result == r.merges.back().Output);
+    REQUIRE(planner.IsIntermediate(result));
+    REQUIRE(r.merged.count(result) == 0);
+    REQUIRE(r.removed.size() == r.merged.size());
+    REQUIRE(r.removed.count(result) == 0);
+
+    // only files in the workdir are created
+    for(const auto& file : planner.Created())
+        REQUIRE(file.find(workdir+"/") == 0);
+}
+
+void dotest_retries() {
+    const auto inputs = make_inputs(7);
+    Planner planner(inputs, "cp {input} {output}", "Ant-hadd", workdir, 3, 2);
+
+    // the first input always fails, the second one only once
+    unsigned failures = 0;
+    auto r = run(planner, 2, [&inputs, &failures] (const job_t& job) {
+        if(job.Type == job_t::type_t::Merge)
+            return true;
+        if(job.Inputs.front() == inputs[0])
+            return false;
+        if(job.Inputs.front() == inputs[1] && failures++ == 0)
+            return false;
+        return true;
+    });
+
+    REQUIRE(r.runs.at("Map_0") == 3);
+    REQUIRE(r.runs.at("Map_1") == 2);
+    REQUIRE(planner.Failed() == vector<string>{inputs[0]});
+    REQUIRE_FALSE(planner.MergeFailed());
+
+    // the failed input is missing from the merged output
+    REQUIRE(r.merged.count(workdir+"/Map_0.root") == 0);
+    for(size_t i=1;i<inputs.size();i++)
+        REQUIRE(r.merged.count(workdir+"/Map_"+to_string(i)+".root") == 1);
+    REQUIRE_FALSE(planner.Result().empty());
+}
+
+void dotest_mergeonly() {
+    {
+        const auto inputs = make_inputs(5);
+        Planner planner(inputs, "", "Ant-hadd", workdir, 2, 0);
+        REQUIRE(planner.Maps() == 0);
+        auto r = run(planner, 4, [] (const job_t&) { return true; });
+
+        for(const auto& input : inputs)
+            REQUIRE(r.merged.count(input) == 1);
+        // inputs are never reported as removable
+        for(const auto& input : inputs)
+            REQUIRE(r.removed.count(input) == 0);
+        REQUIRE(planner.IsIntermediate(planner.Result()));
+    }
+    {
+        // a single input is the result itself
+        const auto inputs = make_inputs(1);
+        Planner planner(inputs, "", "Ant-hadd", workdir, 10, 0);
+        REQUIRE(planner.Done());
+        REQUIRE_FALSE(planner.HasNext());
+        REQUIRE(planner.Result() == inputs.front());
+        REQUIRE_FALSE(planner.IsIntermediate(planner.Result()));
+        REQUIRE(planner.Created().empty());
+    }
+}
+
+void dotest_mergefailed() {
+    const auto inputs = make_inputs(6);
+    Planner planner(inputs, "cp {input} {output}", "Ant-hadd", workdir, 2, 1);
+    auto r = run(planner, 1, [] (const job_t& job) {
+        return job.Type == job_t::type_t::Map;
+    });
+    REQUIRE(planner.MergeFailed());
+    REQUIRE(planner.Done());
+    REQUIRE(planner.Result().empty());
+    REQUIRE(r.runs.at("Merge_0") == 2);
+}
@@ -1,6 +1,9 @@
 #include "catch.hpp"
 
 #include "base/SavitzkyGolay.h"
+#include "base/std_ext/math.h"
+
+#include <cmath>
 
 using namespace std;
 using namespace ant;
@@ -16,3 +19,66 @@ TEST_CASE("SavitzkyGolay: Constant values", "[base/std_ext]") {
         REQUIRE(smoothed[i] == Approx(expected[i]));
     }
 }
+
+TEST_CASE("SavitzkyGolay: Polynomial values", "[base/std_ext]") {
+    // polynomials up to polynom order are reproduced away from the edges
+    SavitzkyGolay sg(7,2);
+    vector<double> input;
+    for(int i=0;i<20;i++)
+        input.push_back(1.0 + 0.5*i - 0.1*i*i);
+    auto smoothed = sg.Smooth(input);
+    REQUIRE(smoothed.size() == input.size());
+    for(auto i=3u;i<input.size()-3;i++) {
+        INFO(i);
+        CHECK(smoothed[i] == Approx(input[i]));
+    }
+}
+
+TEST_CASE("SavitzkyGolay: Batch smoothing", "[base/std_ext]") {
+    SavitzkyGolay sg(3,2,2);
+
+    const unsigned n_points = 15;
+    const unsigned n_channels = 4;
+    vector<vector<double>> channels(n_channels);
+    vector<double> block(n_points*n_channels);
+    for(auto ch=0u;ch<n_channels;ch++) {
+        for(auto i=0u;i<n_points;i++) {
+            const double v = std::sin(0.7*i + ch) + 0.1*ch*i;
+            channels[ch].push_back(v);
+            block[i*n_channels + ch] = v;
+        }
+    }
+
+    const auto smoothed_block = sg.SmoothChannels(block, n_channels);
+    REQUIRE(smoothed_block.size() == block.size());
+
+    for(auto ch=0u;ch<n_channels;ch++) {
+        const auto smoothed = sg.Smooth(channels[ch]);
+        const interval<int> range(0, n_points-1);
+        for(auto i=0u;i<n_points;i++) {
+            INFO(i);
+            INFO(ch);
+            CHECK(smoothed_block[i*n_channels + ch] == Approx(smoothed[i]));
+
+            // single point convolution, range relative to point i
+            double convoluted = std_ext::NaN;
+            sg.Convolute([&channels, ch, i] (int i_) { return channels[ch][i+i_]; },
+                         [&convoluted] (double v) { convoluted = v; },
+                         range - int(i));
+            CHECK(convoluted == Approx(smoothed[i]));
+        }
+    }
+
+    // rows of all channels at one point
+    vector<vector<double>> rows(n_points);
+    for(auto i=0u;i<n_points;i++)
+        rows[i].assign(block.begin()+i*n_channels, block.begin()+(i+1)*n_channels);
+    vector<double> result;
+    sg.ConvoluteRows([&rows] (int i_) -> const vector<double>& { return rows[i_]; },
+                     interval<int>(0, n_points-1), result);
+    REQUIRE(result.size() == n_channels);
+    for(auto ch=0u;ch<n_channels;ch++)
+        CHECK(result[ch] == Approx(smoothed_block[ch]));
+
+    REQUIRE_THROWS_AS(sg.SmoothChannels(block, 7), SavitzkyGolay::Exception);
+}
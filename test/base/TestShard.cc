@@ -0,0 +1,36 @@
+#include "catch.hpp"
+
+#include "base/Shard.h"
+
+using namespace std;
+using namespace ant;
+
+TEST_CASE("Shard: Parse", "[base]") {
+    const auto s = Shard::Parse("2/5");
+    REQUIRE(s.Index == 2);
+    REQUIRE(s.Count == 5);
+    REQUIRE_FALSE(s.IsTrivial());
+    REQUIRE(Shard::Parse("0/1").IsTrivial());
+
+    REQUIRE_THROWS_AS(Shard::Parse("5/5"), Shard::Exception);
+    REQUIRE_THROWS_AS(Shard::Parse("0/0"), Shard::Exception);
+    REQUIRE_THROWS_AS(Shard::Parse("1-2"), Shard::Exception);
+    REQUIRE_THROWS_AS(Shard::Parse("1/2x"), Shard::Exception);
+    REQUIRE_THROWS_AS(Shard::Parse(""), Shard::Exception);
+}
+
+TEST_CASE("Shard: GetRange covers input", "[base]") {
+    for(long long n : {0ll, 1ll, 7ll, 100ll, 1001ll}) {
+        for(unsigned count : {1u, 2u, 3u, 10u}) {
+            long long expected_start = 0;
+            for(unsigned i=0;i<count;i++) {
+                const auto range = Shard(i, count).GetRange(n);
+                REQUIRE(range.Start() == expected_start);
+                REQUIRE(range.Length() >= n/count);
+                REQUIRE(range.Length() <= n/count+1);
+                expected_start = range.Stop();
+            }
+            REQUIRE(expected_start == n);
+        }
+    }
+}
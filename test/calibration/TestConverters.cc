@@ -0,0 +1,67 @@
+#include "catch.hpp"
+
+#include "calibration/converters/MultiHit.h"
+#include "calibration/converters/CATCH_TDC.h"
+#include "calibration/converters/GeSiCa_SADC.h"
+
+#include <vector>
+#include <cstring>
+
+using namespace std;
+using namespace ant;
+using namespace ant::calibration;
+
+vector<uint8_t> make_rawdata(const vector<uint16_t>& words) {
+    vector<uint8_t> rawData(words.size()*sizeof(uint16_t));
+    std::memcpy(rawData.data(), words.data(), rawData.size());
+    return rawData;
+}
+
+// allows to set the reference hit directly
+struct CATCH_TDC_Tester : converter::CATCH_TDC {
+    using converter::CATCH_TDC::CATCH_TDC;
+    void SetReferenceHits(const vector<uint16_t>& refhits) { ReferenceHits = refhits; }
+};
+
+TEST_CASE("Converters: MultiHit", "[calibration]") {
+    converter::MultiHit<uint16_t> multihit;
+    const auto rawData = make_rawdata({1, 300, 65535});
+    REQUIRE(multihit.Convert(rawData) == vector<double>({1, 300, 65535}));
+
+    // appends to given values
+    vector<double> values{-1};
+    multihit.ConvertTo(rawData, values);
+    REQUIRE(values == vector<double>({-1, 1, 300, 65535}));
+
+    // incomplete words
+    REQUIRE(multihit.Convert({1, 2, 3}).empty());
+    REQUIRE(multihit.Convert({}).empty());
+}
+
+TEST_CASE("Converters: GeSiCa_SADC", "[calibration]") {
+    converter::GeSiCa_SADC sadc;
+    REQUIRE(sadc.Convert(make_rawdata({100, 150, 0})) == vector<double>({50}));
+    REQUIRE(sadc.Convert(make_rawdata({100, 150})).empty());
+}
+
+TEST_CASE("Converters: CATCH_TDC", "[calibration]") {
+    const LogicalChannel_t refChannel{Detector_t::Type_t::Trigger, Channel_t::Type_t::Timing, 1000};
+    CATCH_TDC_Tester tdc(refChannel);
+    const auto rawData = make_rawdata({1100, 65535, 900, 62000});
+
+    // no reference hit
+    REQUIRE(tdc.Convert(rawData).empty());
+
+    tdc.SetReferenceHits({1000});
+    const auto gain = converter::Gains::CATCH_TDC;
+    const auto values = tdc.Convert(rawData);
+    REQUIRE(values.size() == 3);
+    CHECK(values[0] == Approx(100*gain));
+    CHECK(values[1] == Approx(-100*gain));
+    // overflow corrected
+    CHECK(values[2] == Approx((62000-1000-62054)*gain));
+
+    // invalid reference hit
+    tdc.SetReferenceHits({65535});
+    REQUIRE(tdc.Convert(rawData).empty());
+}
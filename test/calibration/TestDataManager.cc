@@ -8,8 +8,12 @@
 #include "base/tmpfile_t.h"
 #include "base/interval.h"
 
+#include "TROOT.h"
+#include "RVersion.h"
+
 #include <list>
 #include <algorithm>
+#include <vector>
 
 
 using namespace std;
@@ -19,6 +23,7 @@ using namespace ant::calibration;
 unsigned dotest_store(const string& foldername);
 void dotest_load(const string& foldername, unsigned ndata);
 void dotest_changes(const string& foldername);
+void dotest_parameters(const string& foldername, bool prefetch);
 
 TEST_CASE("CalibrationDataManager: Save/Load","[calibration]")
 {
@@ -28,6 +33,17 @@ TEST_CASE("CalibrationDataManager: Save/Load","[calibration]")
     dotest_changes(tmp.foldername);
 }
 
+TEST_CASE("CalibrationDataManager: Shared parameters","[calibration]")
+{
+    tmpfolder_t tmp;
+    dotest_store(tmp.foldername);
+    dotest_parameters(tmp.foldername, false);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    ROOT::EnableThreadSafety();
+    dotest_parameters(tmp.foldername, true);
+#endif
+}
+
 unsigned dotest_store(const string& foldername)
 {
     DataManager calibman(foldername);
@@ -435,3 +451,60 @@ void dotest_changes(const string& foldername)
 
 
 }
+
+void dotest_parameters(const string& foldername, bool prefetch)
+{
+    DataManager::Prefetch = prefetch;
+    DataManager calibman(foldername);
+
+    // walk through the changepoints like the UpdateableManager does
+    TID currPoint(0,0u);
+    TID nextChangePoint;
+    vector<int64_t> timestamps;
+    DataManager::ParametersPtr first;
+    while(!currPoint.IsInvalid()) {
+        auto params = calibman.GetParameters("1", currPoint, nextChangePoint);
+        REQUIRE(params);
+        if(!first)
+            first = params;
+        timestamps.push_back(params->Data.TimeStamp);
+        REQUIRE(params->Values == vector<double>({1, 2}));
+
+        // must be the same as the copying interface
+        TCalibrationData cdata;
+        TID nextChangePoint_copy;
+        DataManager calibman_copy(foldername);
+        REQUIRE(calibman_copy.GetData("1", currPoint, cdata, nextChangePoint_copy));
+        REQUIRE(cdata.TimeStamp == params->Data.TimeStamp);
+        REQUIRE(nextChangePoint_copy == nextChangePoint);
+
+        // the default data is loaded only once
+        if(params->Data.TimeStamp == 0)
+            REQUIRE(params == first);
+
+        currPoint = nextChangePoint;
+    }
+    REQUIRE(timestamps == vector<int64_t>({0, 1, 4, 0, 5, 0, 6, 0}));
+
+    // not found at all
+    REQUIRE_FALSE(calibman.GetParameters("2", TID(0,0u), nextChangePoint));
+    REQUIRE(nextChangePoint == TID(0,1u));
+    REQUIRE(calibman.GetParameters("2", nextChangePoint, nextChangePoint));
+
+    // adding data must not return outdated data
+    TCalibrationData cdata("1", TID(0,0u), TID(0,2u));
+    cdata.TimeStamp = 10;
+    cdata.Data.emplace_back(3, 4);
+    calibman.Add(cdata, Calibration::AddMode_t::StrictRange);
+    auto params = calibman.GetParameters("1", TID(0,0u), nextChangePoint);
+    REQUIRE(params);
+    REQUIRE(params->Data.TimeStamp == 10);
+    REQUIRE(params->Values == vector<double>({0, 0, 0, 4}));
+    // keys not in the data keep their value
+    vector<double> values{9, 9, 9, 9, 9};
+    params->CopyValuesTo(values);
+    REQUIRE(values == vector<double>({9, 9, 9, 4, 9}));
+    REQUIRE(nextChangePoint == TID(0,3u));
+
+    DataManager::Prefetch = false;
+}
@@ -4,9 +4,14 @@
 
 #include "unpacker/Unpacker.h"
 #include "expconfig/ExpConfig.h"
+#include "expconfig/setups/SetupRegistry.h"
 
 #include "expconfig/detectors/CB.h"
 
+#include "tree/TID.h"
+#include "base/std_ext/time.h"
+#include "base/std_ext/container.h"
+
 #include <iostream>
 
 using namespace ant;
@@ -15,11 +20,16 @@ using namespace std;
 void getdetector();
 void getlastfound();
 void getall();
+void setbytid();
 
 TEST_CASE("ExpConfig Get (all)", "[expconfig]") {
     getall();
 }
 
+TEST_CASE("ExpConfig SetByTID", "[expconfig]") {
+    setbytid();
+}
+
 TEST_CASE("ExpConfig GetDetector", "[expconfig]") {
 
     getdetector();
@@ -32,6 +42,40 @@ void getall() {
     }
 }
 
+void setbytid() {
+    using expconfig::SetupRegistry;
+
+    unsigned nTimeRanges = 0;
+    for(auto setupname : ExpConfig::Setup::GetNames()) {
+        const auto timerange = SetupRegistry::GetTimeRange(setupname);
+        if(timerange.empty())
+            continue;
+        ++nTimeRanges;
+
+        // noon of the first day after start
+        const auto timestamp = std_ext::to_time_t(timerange.StartDate, true) + 12*3600;
+        const auto names = SetupRegistry::GetNamesByTimestamp(timestamp);
+        REQUIRE(std_ext::contains(names, setupname));
+
+        ExpConfig::Setup::Cleanup();
+        REQUIRE_NOTHROW(ExpConfig::Setup::SetByTID(TID(timestamp)));
+        auto& setup = ExpConfig::Setup::Get();
+        REQUIRE(setup.GetName() == setupname);
+        REQUIRE(setup.GetStartDate() == timerange.StartDate);
+        REQUIRE(setup.GetEndDate() == timerange.EndDate);
+        REQUIRE(setup.Matches(TID(timestamp)));
+    }
+    REQUIRE(nTimeRanges > 0);
+
+    // long before any beamtime, only setups without time range are left
+    for(auto setupname : SetupRegistry::GetNamesByTimestamp(0))
+        REQUIRE(SetupRegistry::GetTimeRange(setupname).empty());
+    ExpConfig::Setup::Cleanup();
+    REQUIRE_THROWS_AS(ExpConfig::Setup::SetByTID(TID(0)), ExpConfig::Exception);
+
+    ExpConfig::Setup::Cleanup();
+}
+
 void getdetector() {
     test::EnsureSetup();
     REQUIRE_NOTHROW(Unpacker::Get(string(TEST_BLOBS_DIRECTORY)+"/Acqu_oneevent-big.dat.xz"));
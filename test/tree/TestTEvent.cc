@@ -2,6 +2,7 @@
 
 #include "tree/TEvent.h"
 #include "tree/TEventData.h"
+#include "tree/TEventCodec.h"
 
 #include "base/tmpfile_t.h"
 #include "base/std_ext/memory.h"
@@ -17,11 +18,22 @@ using namespace std;
 using namespace ant;
 
 void dotest();
+void dotest_recycle();
 
 TEST_CASE("TEvent: Write/Read TTree", "[tree]") {
     dotest();
 }
 
+TEST_CASE("TEvent: Write/Read TTree with cereal", "[tree]") {
+    TEventCodec::WriteFormat = TEventCodec::Format_t::Cereal;
+    dotest();
+    TEventCodec::WriteFormat = TEventCodec::Format_t::Fast;
+}
+
+TEST_CASE("TEvent: Recycle TEventData", "[tree]") {
+    dotest_recycle();
+}
+
 void dotest() {
     tmpfile_t tmpfile;
 
@@ -166,7 +178,40 @@ void dotest() {
                     [] (const TCandidate& c) { return c.Detector & Detector_t::Type_t::TAPS; } );
         REQUIRE(taps_cands.size() == 1);
 
+        // second entry is read into the same, recycled instance
+        t.Tree->GetEntry(1);
+        REQUIRE(addressof(t.Event().Reconstructed()) == addressof(readback));
+        REQUIRE(readback.DetectorReadHits.empty());
+        REQUIRE(readback.Clusters.empty());
+        REQUIRE(readback.Candidates.empty());
+        REQUIRE(readback.ParticleTree == nullptr);
+        REQUIRE(t.Event().MCTrue().Candidates.empty());
+    }
+
+}
 
+void dotest_recycle() {
+    const TEventData* recycled = nullptr;
+    {
+        TEvent event(TID(10));
+        auto& eventdata = event.Reconstructed();
+        eventdata.DetectorReadHits.resize(10);
+        eventdata.Trigger.DAQEventID = 5;
+        eventdata.Trigger.DAQErrors.emplace_back(1, 2, 3);
+        recycled = addressof(eventdata);
     }
 
+    // the pool hands out the last returned instance first
+    TEvent event(TID(11));
+    const auto& eventdata = event.Reconstructed();
+    REQUIRE(addressof(eventdata) == recycled);
+    REQUIRE(eventdata.ID == TID(11));
+    REQUIRE(eventdata.DetectorReadHits.empty());
+    REQUIRE(eventdata.DetectorReadHits.capacity() >= 10);
+    REQUIRE(eventdata.Trigger.DAQEventID == 0);
+    REQUIRE(eventdata.Trigger.DAQErrors.empty());
+
+    // moving into an existing event recycles its data
+    event = TEvent(TID(12));
+    REQUIRE(event.Reconstructed().ID == TID(12));
 }
@@ -0,0 +1,163 @@
+#include "catch.hpp"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+#include "tree/TEventCodec.h"
+
+#include <vector>
+
+using namespace std;
+using namespace ant;
+
+void dotest_roundtrip();
+void dotest_fallback();
+
+TEST_CASE("TEventCodec: Roundtrip", "[tree]") {
+    dotest_roundtrip();
+}
+
+TEST_CASE("TEventCodec: Fallback and errors", "[tree]") {
+    dotest_fallback();
+}
+
+TEvent make_event() {
+    TEvent event(TID(10, 20, {TID::Flags_t::MC}), TID(11));
+    auto& eventdata = event.Reconstructed();
+
+    const LogicalChannel_t element{Detector_t::Type_t::CB, Channel_t::Type_t::Integral, 300};
+    eventdata.DetectorReadHits.emplace_back(element, vector<uint8_t>{1, 2, 3});
+    eventdata.DetectorReadHits.back().Values.emplace_back(4.5);
+    eventdata.DetectorReadHits.back().ValueBits = {true, false, true, true, false, false, true, false, true};
+
+    eventdata.SlowControls.emplace_back(TSlowControl::Type_t::AcquScaler, TSlowControl::Validity_t::Backward,
+                                        -5, "Scaler", "Description");
+    eventdata.SlowControls.back().Payload_Int.emplace_back(3, -1234567890123);
+    eventdata.SlowControls.back().Payload_Float.emplace_back(4, 2.5);
+    eventdata.SlowControls.back().Payload_String.emplace_back(5, "value");
+
+    eventdata.UnpackerMessages.emplace_back(TUnpackerMessage::Level_t::Warn, "Message {}");
+    eventdata.UnpackerMessages.back().Payload.push_back(42);
+
+    eventdata.TaggerHits.emplace_back(7, 1400.0, -3.0, 12.0);
+
+    eventdata.Trigger.CBEnergySum = 600;
+    eventdata.Trigger.DAQEventID = 0x1234;
+    eventdata.Trigger.DAQErrors.emplace_back(1, 2, -3, "ADC");
+    eventdata.Target.Vertex = vec3(0, 0, 1.5);
+
+    TClusterHit clusterhit(12, 50.0, 1.0);
+    clusterhit.Data.emplace_back(Channel_t::Type_t::Timing, TDetectorReadHit::Value_t(1.0));
+    eventdata.Clusters.emplace_back(vec3(1,2,3), 100, 0.5, Detector_t::Type_t::CB, 12,
+                                    vector<TClusterHit>{clusterhit});
+    eventdata.Clusters.emplace_back(vec3(4,5,6), 2, 0.7, Detector_t::Type_t::PID, 3);
+
+    eventdata.Candidates.emplace_back(Detector_t::Type_t::CB | Detector_t::Type_t::PID,
+                                      100, 0.5, 1.0, 0.5, 1, 2.0, 0.0,
+                                      TClusterList{next(eventdata.Clusters.begin(), 1),
+                                                   next(eventdata.Clusters.begin(), 0)});
+
+    eventdata.ParticleTree = Tree<TParticlePtr>::MakeNode(
+                                 make_shared<TParticle>(ParticleTypeDatabase::Pi0, LorentzVec({1,2,3},4)));
+    eventdata.ParticleTree->CreateDaughter(
+                make_shared<TParticle>(ParticleTypeDatabase::Photon, eventdata.Candidates.get_ptr_at(0)));
+    eventdata.ParticleTree->CreateDaughter(TParticlePtr());
+
+    event.MCTrue().DetectorReadHits.emplace_back(element, TDetectorReadHit::Value_t(1.0));
+    event.SavedForSlowControls = true;
+    return event;
+}
+
+void dotest_roundtrip() {
+    const auto event = make_event();
+
+    vector<char> buffer;
+    REQUIRE(TEventCodec::Encode(event, buffer));
+    REQUIRE(TEventCodec::IsEncoded(buffer.data(), buffer.data()+buffer.size()));
+
+    // decode into an event with leftovers, they must be gone
+    TEvent readback(TID(99));
+    readback.Reconstructed().TaggerHits.emplace_back(1, 1.0, 1.0);
+    REQUIRE(TEventCodec::Decode(buffer.data(), buffer.data()+buffer.size(), readback) == buffer.size());
+
+    REQUIRE(readback.SavedForSlowControls);
+    const auto& orig = event.Reconstructed();
+    const auto& d = readback.Reconstructed();
+    REQUIRE(d.ID == orig.ID);
+    REQUIRE(readback.MCTrue().ID == event.MCTrue().ID);
+    REQUIRE(readback.MCTrue().DetectorReadHits.size() == 1);
+
+    REQUIRE(d.DetectorReadHits.size() == 1);
+    const auto& hit = d.DetectorReadHits.front();
+    REQUIRE(hit.DetectorType == Detector_t::Type_t::CB);
+    REQUIRE(hit.ChannelType == Channel_t::Type_t::Integral);
+    REQUIRE(hit.Channel == 300);
+    REQUIRE(hit.RawData == orig.DetectorReadHits.front().RawData);
+    REQUIRE(hit.Values.size() == 1);
+    REQUIRE(hit.Values.front().Calibrated == 4.5);
+    REQUIRE(hit.ValueBits == orig.DetectorReadHits.front().ValueBits);
+
+    REQUIRE(d.SlowControls.size() == 1);
+    REQUIRE(d.SlowControls.front().Timestamp == -5);
+    REQUIRE(d.SlowControls.front().Name == "Scaler");
+    REQUIRE(d.SlowControls.front().Payload_Int.front().Value == -1234567890123);
+    REQUIRE(d.SlowControls.front().Payload_Float.front().Value == 2.5);
+    REQUIRE(d.SlowControls.front().Payload_String.front().Value == "value");
+
+    REQUIRE(d.UnpackerMessages.size() == 1);
+    REQUIRE(d.UnpackerMessages.front().Level == TUnpackerMessage::Level_t::Warn);
+    REQUIRE(d.UnpackerMessages.front().Message == "Message {}");
+    REQUIRE(d.UnpackerMessages.front().Payload == vector<double>{42});
+
+    REQUIRE(d.TaggerHits.size() == 1);
+    REQUIRE(d.TaggerHits.front().Channel == 7);
+    REQUIRE(d.TaggerHits.front().Electrons.size() == 1);
+    REQUIRE(d.TaggerHits.front().Electrons.front().QDCEnergy == 12.0);
+
+    REQUIRE(d.Trigger.CBEnergySum == 600);
+    REQUIRE(d.Trigger.DAQEventID == 0x1234);
+    REQUIRE(d.Trigger.DAQErrors.size() == 1);
+    REQUIRE(d.Trigger.DAQErrors.front().ErrorCode == -3);
+    REQUIRE(d.Trigger.DAQErrors.front().ModuleName == "ADC");
+    REQUIRE(d.Target.Vertex == vec3(0, 0, 1.5));
+
+    REQUIRE(d.Clusters.size() == 2);
+    REQUIRE(d.Clusters.at(0).Position == vec3(1,2,3));
+    REQUIRE(d.Clusters.at(0).Hits.size() == 1);
+    REQUIRE(d.Clusters.at(0).Hits.front().Data.size() == 1);
+    REQUIRE(d.Clusters.at(1).DetectorType == Detector_t::Type_t::PID);
+
+    REQUIRE(d.Candidates.size() == 1);
+    const auto& candidate = d.Candidates.front();
+    REQUIRE(candidate.Detector == (Detector_t::Type_t::CB | Detector_t::Type_t::PID));
+    REQUIRE(candidate.Clusters.size() == 2);
+    REQUIRE(candidate.Clusters.get_ptr_at(0) == d.Clusters.get_ptr_at(1));
+    REQUIRE(candidate.Clusters.get_ptr_at(1) == d.Clusters.get_ptr_at(0));
+
+    REQUIRE(d.ParticleTree != nullptr);
+    REQUIRE(d.ParticleTree->Get()->Type() == ParticleTypeDatabase::Pi0);
+    REQUIRE(d.ParticleTree->Get()->E == 4);
+    REQUIRE(d.ParticleTree->Daughters().size() == 2);
+    const auto& photon = d.ParticleTree->Daughters().front()->Get();
+    REQUIRE(photon->Type() == ParticleTypeDatabase::Photon);
+    REQUIRE(photon->Candidate == d.Candidates.get_ptr_at(0));
+    REQUIRE(d.ParticleTree->Daughters().back()->Get() == nullptr);
+}
+
+void dotest_fallback() {
+    auto event = make_event();
+
+    vector<char> buffer;
+    REQUIRE(TEventCodec::Encode(event, buffer));
+
+    // truncated data
+    TEvent readback;
+    REQUIRE_THROWS_AS(TEventCodec::Decode(buffer.data(), buffer.data()+buffer.size()/2, readback),
+                      TEventCodec::Exception);
+    REQUIRE_FALSE(TEventCodec::IsEncoded(buffer.data(), buffer.data()+2));
+
+    // links to candidates outside the event cannot be encoded
+    auto other = make_event();
+    event.Reconstructed().ParticleTree->CreateDaughter(
+                make_shared<TParticle>(ParticleTypeDatabase::Photon, other.Reconstructed().Candidates.get_ptr_at(0)));
+    REQUIRE_FALSE(TEventCodec::Encode(event, buffer));
+}
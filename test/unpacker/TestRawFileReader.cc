@@ -6,6 +6,7 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <iterator>
 
 
 
@@ -20,6 +21,7 @@ enum class eCompress { NoCompress, XZ, GZ };
 
 void dotest(eCompress, streamsize, streamsize, streamsize);
 void doendianness();
+void doseek(eCompress);
 
 
 TEST_CASE("Test RawFileReader: nocompress, one chunk", "[unpacker]") {
@@ -58,6 +60,18 @@ TEST_CASE("Test RawFileReader: uint32_t endianness","[unpacker]") {
   doendianness();
 }
 
+TEST_CASE("Test RawFileReader: seek, nocompress", "[unpacker]") {
+  doseek(eCompress::NoCompress);
+}
+
+TEST_CASE("Test RawFileReader: seek, compress xz", "[unpacker]") {
+  doseek(eCompress::XZ);
+}
+
+TEST_CASE("Test RawFileReader: seek, compress gz", "[unpacker]") {
+  doseek(eCompress::GZ);
+}
+
 void doendianness() {
   ant::tmpfile_t f;
 
@@ -161,5 +175,46 @@ void dotest(eCompress compress,
   REQUIRE(inputEqualsOutput);
 }
 
+void doseek(eCompress compress) {
+  ant::tmpfile_t f;
+  f.testdata.resize(totalSize);
+  generate(f.testdata.begin(), f.testdata.end(), rand);
+  f.write_testdata();
 
+  // create several small xz blocks, possibly spread over concatenated streams
+  if(compress == eCompress::XZ) {
+    const string& xz_cmd = string("xz --block-size=")+to_string(3*BUFSIZ)+" "+f.filename;
+    REQUIRE(system(xz_cmd.c_str()) == 0);
+    f.filename += ".xz";
+  } else if(compress == eCompress::GZ) {
+    const string& gz_cmd = string("gzip ")+f.filename;
+    REQUIRE(system(gz_cmd.c_str()) == 0);
+    f.filename += ".gz";
+  }
 
+  ant::RawFileReader reader;
+  REQUIRE_NOTHROW(reader.open(f.filename, inbufSize));
+  REQUIRE(reader.GetUncompressedSize() == totalSize);
+
+  const auto seekpoints = reader.GetSeekPoints();
+  if(compress == eCompress::XZ)
+    REQUIRE(seekpoints.size() == (totalSize + 3*BUFSIZ - 1)/(3*BUFSIZ));
+  else
+    REQUIRE(seekpoints.empty());
+
+  // seek back and forth, also across block boundaries
+  for(streamsize offset : {totalSize/2, streamsize(7), 3*streamsize(BUFSIZ)-5, totalSize-chunkSize}) {
+    REQUIRE_NOTHROW(reader.seek(offset, seekpoints));
+    REQUIRE(reader.tell() == offset);
+    vector<uint8_t> indata(chunkSize);
+    REQUIRE_NOTHROW(reader.read((char*)indata.data(), indata.size()));
+    REQUIRE(reader.gcount() == chunkSize);
+    const bool inputEqualsOutput = equal(indata.begin(), indata.end(), next(f.testdata.begin(), offset));
+    REQUIRE(inputEqualsOutput);
+  }
+
+  // reading after the last seek reaches the end of file
+  REQUIRE_NOTHROW(reader.read((char*)f.testdata.data(), 1));
+  REQUIRE(reader.gcount() == 0);
+  REQUIRE(reader.eof());
+}
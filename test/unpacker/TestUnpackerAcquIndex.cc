@@ -0,0 +1,87 @@
+#include "catch.hpp"
+#include "catch_config.h"
+#include "expconfig_helpers.h"
+
+#include "Unpacker.h"
+#include "detail/UnpackerAcqu_index.h"
+
+#include "tree/TEvent.h"
+#include "tree/TEventData.h"
+
+#include "base/Shard.h"
+#include "base/tmpfile_t.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ant;
+
+void dotest();
+
+TEST_CASE("Test UnpackerAcqu: Index", "[unpacker]") {
+    test::EnsureSetup();
+    dotest();
+}
+
+struct unpacked_t {
+    TID ID;
+    Shard::Overlap_t Overlap;
+};
+
+vector<unpacked_t> unpack(const string& filename, const Shard& shard = {}) {
+    auto unpacker = Unpacker::Get(filename);
+    if(!shard.IsTrivial())
+        REQUIRE(unpacker->SetShard(shard));
+
+    vector<unpacked_t> unpacked;
+    while(auto event = unpacker->NextEvent())
+        unpacked.push_back({event.Reconstructed().ID, event.ShardOverlap});
+    return unpacked;
+}
+
+void dotest() {
+    // the index is saved next to the raw file,
+    // so work on a copy with several small xz blocks
+    tmpfolder_t folder;
+    const string filename = folder.foldername+"/Acqu_twoscalerblocks.dat.xz";
+    const string xz_cmd = string("xz -d -c ")+TEST_BLOBS_DIRECTORY+"/Acqu_twoscalerblocks.dat.xz"
+                          +" | xz --block-size=100000 > "+filename;
+    REQUIRE(system(xz_cmd.c_str()) == 0);
+
+    // first pass creates the index
+    using unpacker::acqu::Index;
+    Index::CreateOnFirstPass = true;
+    const auto all = unpack(filename);
+    Index::CreateOnFirstPass = false;
+    REQUIRE(!all.empty());
+
+    Index index;
+    REQUIRE(index.Load(filename));
+    REQUIRE(index.Buffers.size() > 2);
+    REQUIRE(index.SeekPoints.size() > 1);
+
+    // buffers are consecutive and every event is found
+    for(size_t i=1;i<index.Buffers.size();i++) {
+        const auto& prev = index.Buffers[i-1];
+        REQUIRE(index.Buffers[i].FirstEvent == prev.FirstEvent + prev.nEvents);
+        REQUIRE(index.Buffers[i].Offset == prev.Offset + sizeof(uint32_t)*index.RecordLength);
+    }
+    for(const auto& u : all)
+        REQUIRE(index.FindBuffer(u.ID.Lower) >= 0);
+
+    // sharding seeks using the index, the events inside the shards
+    // are exactly the ones from unpacking everything
+    constexpr unsigned nShards = 3;
+    vector<unpacked_t> merged;
+    for(unsigned i=0;i<nShards;i++) {
+        for(const auto& u : unpack(filename, Shard(i, nShards))) {
+            if(u.Overlap == Shard::Overlap_t::None)
+                merged.push_back(u);
+        }
+    }
+    REQUIRE(merged.size() == all.size());
+    for(size_t i=0;i<all.size();i++)
+        REQUIRE(merged[i].ID == all[i].ID);
+}
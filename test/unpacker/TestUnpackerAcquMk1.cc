@@ -3,18 +3,25 @@
 #include "expconfig_helpers.h"
 
 #include "Unpacker.h"
+#include "UnpackerAcqu.h"
 
 #include "tree/TEvent.h"
 #include "tree/TEventData.h"
 
+#include "base/Shard.h"
+#include "base/std_ext/misc.h"
+
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace ant;
 
 void dotest_problematic();
 void dotest_another();
+void dotest_leadin();
 
 TEST_CASE("Test UnpackerAcqu: Mk1 with error scaler block", "[unpacker]") {
     dotest_problematic();
@@ -24,6 +31,10 @@ TEST_CASE("Test UnpackerAcqu: Mk1 with another scaler block", "[unpacker]") {
     dotest_another();
 }
 
+TEST_CASE("Test UnpackerAcqu: Mk1 lead-in without slowcontrol", "[unpacker]") {
+    dotest_leadin();
+}
+
 void dotest_problematic() {
     ant::test::EnsureSetup();
     auto unpacker = Unpacker::Get(string(TEST_BLOBS_DIRECTORY)+"/AcquMk1_problematic.dat.gz");
@@ -86,4 +97,53 @@ void dotest_another() {
     CHECK(nEvents == 37);
     CHECK(nHits == 1102);
     CHECK(nEmptyEvents == 0);
-}
\ No newline at end of file
+}
+
+void dotest_leadin() {
+    ant::test::EnsureSetup();
+    // the file has three data buffers without any slowcontrol,
+    // so the last shard's lead-in is only limited by MaxLeadIn
+    const string filename = string(TEST_BLOBS_DIRECTORY)+"/AcquMk1_problematic.dat.gz";
+
+    vector<TID> all;
+    {
+        auto unpacker = Unpacker::Get(filename);
+        while(auto event = unpacker->NextEvent())
+            all.push_back(event.Reconstructed().ID);
+    }
+    REQUIRE(all.size() == 85);
+
+    const auto maxLeadIn = UnpackerAcqu::MaxLeadIn;
+    UnpackerAcqu::MaxLeadIn = 10;
+    std_ext::execute_on_destroy reset([maxLeadIn] () {
+        UnpackerAcqu::MaxLeadIn = maxLeadIn;
+    });
+
+    auto unpacker = Unpacker::Get(filename);
+    REQUIRE(unpacker->SetShard(Shard(2, 3)));
+
+    vector<TID> leadin;
+    vector<TID> inside;
+    while(auto event = unpacker->NextEvent()) {
+        if(event.ShardOverlap == Shard::Overlap_t::LeadIn) {
+            // hits outside the shard are not decoded
+            REQUIRE(event.Reconstructed().DetectorReadHits.empty());
+            leadin.push_back(event.Reconstructed().ID);
+        }
+        else if(event.ShardOverlap == Shard::Overlap_t::None) {
+            inside.push_back(event.Reconstructed().ID);
+        }
+    }
+
+    // the lead-in stays within MaxLeadIn, although two data buffers were skipped
+    REQUIRE(!leadin.empty());
+    REQUIRE(leadin.size() <= UnpackerAcqu::MaxLeadIn);
+    REQUIRE(!inside.empty());
+    REQUIRE(leadin.back() < inside.front());
+    for(const TID& tid : leadin)
+        REQUIRE(find(all.begin(), all.end(), tid) != all.end());
+
+    // the last shard ends with the file
+    REQUIRE(inside.size() < all.size());
+    REQUIRE(equal(inside.begin(), inside.end(), all.end()-inside.size()));
+}
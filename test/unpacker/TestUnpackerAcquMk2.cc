@@ -3,22 +3,40 @@
 #include "expconfig_helpers.h"
 
 #include "Unpacker.h"
+#include "UnpackerAcqu.h"
 
 #include "tree/TEvent.h"
 #include "tree/TEventData.h"
 
+#include "reconstruct/Reconstruct.h"
+
+#include "base/std_ext/misc.h"
+
 #include <iostream>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace ant;
 
 void dotest();
+void dotest_scalersonly();
+void dotest_parallel(const string& filename);
 
 TEST_CASE("Test UnpackerAcqu: Scaler block", "[unpacker]") {
     dotest();
 }
 
+TEST_CASE("Test UnpackerAcqu: Scalers only", "[unpacker]") {
+    dotest_scalersonly();
+}
+
+TEST_CASE("Test UnpackerAcqu: Parallel", "[unpacker]") {
+    dotest_parallel(string(TEST_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz");
+    dotest_parallel(string(TEST_BLOBS_DIRECTORY)+"/Acqu_twoscalerblocks.dat.xz");
+    dotest_parallel(string(TEST_BLOBS_DIRECTORY)+"/AcquMk1_problematic.dat.gz");
+}
+
 void dotest() {
     ant::test::EnsureSetup();
     auto unpacker = Unpacker::Get(string(TEST_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz");
@@ -61,3 +79,101 @@ void dotest() {
     REQUIRE(nEmptyEvents == 0);
     REQUIRE(taggerScalerBlockFound);
 }
+
+// events and the tagger hits reconstructed from them
+vector<TEvent> unpack_reconstruct(const string& filename) {
+    auto unpacker = Unpacker::Get(filename);
+    Reconstruct reco;
+    vector<TEvent> events;
+    while(auto event = unpacker->NextEvent()) {
+        reco.DoReconstruct(event.Reconstructed());
+        events.emplace_back(move(event));
+    }
+    return events;
+}
+
+void dotest_scalersonly() {
+    ant::test::EnsureSetup();
+
+    const auto filename = string(TEST_BLOBS_DIRECTORY)+"/Acqu_scalerblock.dat.xz";
+    const auto normal = unpack_reconstruct(filename);
+
+    UnpackerAcqu::ScalersOnly::Enabled = true;
+    std_ext::execute_on_destroy reset([] () {
+        UnpackerAcqu::ScalersOnly::Enabled = false;
+    });
+    const auto scalersonly = unpack_reconstruct(filename);
+
+    // same events and scalers, but only the kept hits,
+    // which are enough to reconstruct the same tagger hits
+    REQUIRE(scalersonly.size() == normal.size());
+    unsigned nTaggerHits = 0;
+    unsigned nReadHits = 0;
+    for(size_t i=0;i<normal.size();i++) {
+        const auto& n = normal[i].Reconstructed();
+        const auto& s = scalersonly[i].Reconstructed();
+        REQUIRE(s.ID == n.ID);
+        REQUIRE(s.SlowControls.size() == n.SlowControls.size());
+
+        for(auto& readhit : s.DetectorReadHits)
+            REQUIRE(UnpackerAcqu::ScalersOnly::KeepHits.test(readhit.DetectorType));
+        nReadHits += s.DetectorReadHits.size();
+
+        REQUIRE(s.TaggerHits.size() == n.TaggerHits.size());
+        for(size_t j=0;j<n.TaggerHits.size();j++) {
+            CHECK(s.TaggerHits[j].Channel == n.TaggerHits[j].Channel);
+            CHECK(s.TaggerHits[j].Time == n.TaggerHits[j].Time);
+            CHECK(s.TaggerHits[j].PhotonEnergy == n.TaggerHits[j].PhotonEnergy);
+        }
+        nTaggerHits += n.TaggerHits.size();
+    }
+    REQUIRE(nTaggerHits > 0);
+    REQUIRE(nReadHits < 30563);
+}
+
+vector<TEvent> unpack(const string& filename) {
+    auto unpacker = Unpacker::Get(filename);
+    vector<TEvent> events;
+    while(auto event = unpacker->NextEvent())
+        events.emplace_back(move(event));
+    return events;
+}
+
+void dotest_parallel(const string& filename) {
+    ant::test::EnsureSetup();
+
+    const auto serial = unpack(filename);
+    REQUIRE(!serial.empty());
+
+    // several batches with one buffer per thread
+    UnpackerAcqu::Parallel::Threads = 3;
+    UnpackerAcqu::Parallel::BuffersPerThread = 1;
+    std_ext::execute_on_destroy reset([] () {
+        UnpackerAcqu::Parallel::Threads = 0;
+        UnpackerAcqu::Parallel::BuffersPerThread = 16;
+    });
+
+    const auto parallel = unpack(filename);
+
+    // same events in the same order, apart from the message about the threads
+    REQUIRE(parallel.size() == serial.size());
+    for(size_t i=0;i<serial.size();i++) {
+        const auto& s = serial[i].Reconstructed();
+        const auto& p = parallel[i].Reconstructed();
+        REQUIRE(p.ID == s.ID);
+        REQUIRE(p.Trigger.DAQEventID == s.Trigger.DAQEventID);
+        REQUIRE(p.DetectorReadHits.size() == s.DetectorReadHits.size());
+        for(size_t j=0;j<s.DetectorReadHits.size();j++)
+            REQUIRE(p.DetectorReadHits[j].RawData == s.DetectorReadHits[j].RawData);
+        REQUIRE(p.SlowControls.size() == s.SlowControls.size());
+
+        vector<string> p_messages;
+        for(const auto& m : p.UnpackerMessages) {
+            if(m.Message.find("threads") == string::npos)
+                p_messages.push_back(m.Message);
+        }
+        REQUIRE(p_messages.size() == s.UnpackerMessages.size());
+        for(size_t j=0;j<p_messages.size();j++)
+            REQUIRE(p_messages[j] == s.UnpackerMessages[j].Message);
+    }
+}